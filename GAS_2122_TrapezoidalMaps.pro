@@ -41,6 +41,7 @@ DISTFILES += \
 
 SOURCES +=  \
     algorithms/trapezoidalmapconstructionandquery.cpp \
+    data_structures/bounding_box_index.cpp \
     data_structures/directedacyclicgraph.cpp \
     data_structures/node.cpp \
     data_structures/segment_intersection_checker.cpp \
@@ -52,14 +53,17 @@ SOURCES +=  \
     main.cpp \
     managers/trapezoidalmap_manager.cpp \
     utils/fileutils.cpp \
-    utils/geometryutils.cpp
+    utils/geometryutils.cpp \
+    utils/viewportutils.cpp
 
 FORMS += \
     managers/trapezoidalmapmanager.ui
 
 HEADERS += \
     algorithms/trapezoidalmapconstructionandquery.h \
+    data_structures/bounding_box_index.h \
     data_structures/directedacyclicgraph.h \
+    data_structures/flat_hash_map.h \
     data_structures/node.h \
     data_structures/segment_intersection_checker.h \
     data_structures/trapezoid.h \
@@ -69,7 +73,8 @@ HEADERS += \
     drawables/drawable_trapezoidalmap_dataset.h \
     managers/trapezoidalmap_manager.h \
     utils/fileutils.h \
-    utils/geometryutils.h
+    utils/geometryutils.h \
+    utils/viewportutils.h
 
 
 
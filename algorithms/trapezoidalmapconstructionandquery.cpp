@@ -629,14 +629,29 @@ namespace TrapezoidalMapConstructionAndQuery
      * @param tm the trapezoidal map
      * @param dag the directed acyclic graph
      * @param segment the segment being added to the map
+     * @return a vector containing the indexes in the map of the trapezoids which have been modified
      */
-    void incrementalStep(TrapezoidalMap& tm, DirectedAcyclicGraph& dag, const cg3::Segment2d& segment)
+    const std::vector<size_t> incrementalStep(TrapezoidalMap& tm, DirectedAcyclicGraph& dag, const cg3::Segment2d& segment)
     {
         const cg3::Segment2d orderedSegment = GeometryUtils::getOrderedSegment(segment);
 
         std::vector<size_t> intersectedTrapezoidsIndexes = followSegment(tm, dag, orderedSegment);
 
+        /*
+         * the split can only write the intersected trapezoids, the merged trapezoid and the new ones at the back of the map
+         * the new merged trapezoid is always one of them
+         */
+        std::vector<size_t> modifiedTrapezoidsIndexes = intersectedTrapezoidsIndexes;
+        if (tm.getMergedTrapezoid() != std::numeric_limits<size_t>::max())
+            modifiedTrapezoidsIndexes.push_back(tm.getMergedTrapezoid());
+        size_t firstNewTrapezoidIndex = tm.numberOfTrapezoids();
+
         splitTrapezoids(tm, dag, intersectedTrapezoidsIndexes, orderedSegment);
+
+        for (size_t i = firstNewTrapezoidIndex; i < tm.numberOfTrapezoids(); i++)
+            modifiedTrapezoidsIndexes.push_back(i);
+
+        return modifiedTrapezoidsIndexes;
     }
 
     /**
@@ -15,7 +15,7 @@ namespace TrapezoidalMapConstructionAndQuery
     const std::vector<size_t> followSegment(const TrapezoidalMap& tm, const DirectedAcyclicGraph& dag, const cg3::Segment2d& segment);
     size_t merge(TrapezoidalMap& tm, const size_t leftTrapezoidIndex, const size_t rightTrapezoidIndex);
     void splitTrapezoids(TrapezoidalMap& tm, DirectedAcyclicGraph& dag, std::vector<size_t>& trapezoidIndexes, const cg3::Segment2d& segment);
-    void incrementalStep(TrapezoidalMap& tm, DirectedAcyclicGraph& dag, const cg3::Segment2d& segment);
+    const std::vector<size_t> incrementalStep(TrapezoidalMap& tm, DirectedAcyclicGraph& dag, const cg3::Segment2d& segment);
     void colorTrapezoids(DrawableTrapezoidalMap& tm);
     void clearStructures(TrapezoidalMap& tm, DirectedAcyclicGraph& dag);
 }
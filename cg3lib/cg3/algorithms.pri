@@ -30,7 +30,7 @@ SOURCES += \
     $$PWD/algorithms/convex_hull3.cpp \
     $$PWD/algorithms/global_optimal_rotation_matrix.cpp \
     $$PWD/algorithms/graph_algorithms.cpp \
-    $$PWD/algorithms/marching_cubes.cpp \
+    $$PWD/algorithms/marching_cubes_bool.cpp \
     $$PWD/algorithms/laplacian_smoothing.cpp \
     $$PWD/algorithms/sphere_coverage.cpp
 }
@@ -7,6 +7,14 @@
 #include "convex_hull2.h"
 
 #include <vector>
+#include <algorithm>
+#include <iterator>
+#include <limits>
+#include <functional>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
 
 #include "cg3/geometry/point2.h"
 #include "cg3/geometry/utils2.h"
@@ -20,6 +28,26 @@ namespace internal {
 template <class T = double, class InputIterator, class OutputIterator>
 inline void grahamScanOnContainer(const InputIterator first, const InputIterator end, OutputIterator& outIt);
 
+template <class T = double, class InputIterator, class OutputIterator>
+inline void convexHullOfSortedPoints(const InputIterator first, const InputIterator end, OutputIterator& outIt);
+
+template <class T = double>
+inline void aklToussaintFilter(std::vector<Point2<T>>& points);
+
+template <class T = double>
+inline void parallelSort(std::vector<Point2<T>>& points);
+
+template <class T = double>
+inline bool chanConvexHull(const std::vector<Point2<T>>& points, size_t m, std::vector<Point2<T>>& convexHull);
+
+template <class T = double>
+inline size_t chanTangent(const std::vector<Point2<T>>& hull, size_t split, const Point2<T>& p);
+
+template <class T = double>
+inline int orientation(const Point2<T>& p1, const Point2<T>& p2, const Point2<T>& p3);
+
+inline unsigned int convexHull2DThreads();
+
 } //namespace cg3::internal
 
 
@@ -37,7 +65,14 @@ void convexHull2D(const InputContainer& container, OutputContainer& convexHull)
 }
 
 /**
- * @brief Get the 2D convex hull using Graham scan algorithm on iterators of containers
+ * @brief Get the 2D convex hull using Graham scan algorithm on iterators of containers.
+ *
+ * The points that are strictly inside the polygon of the extreme points along
+ * eight directions are discarded before sorting (Akl-Toussaint heuristic), and
+ * the remaining points are sorted in parallel.
+ * The convex hull is given in counterclockwise order, starting from the
+ * lexicographically smallest point; collinear points are not included.
+ *
  * @param[in] first First iterator of the input container
  * @param[in] end End iterator of the input container
  * @param[out] outIt Output iterator for the container containing the convex hull
@@ -50,21 +85,132 @@ OutputIterator convexHull2D(InputIterator first, InputIterator end, OutputIterat
     if (first == end)
         return outIt;
 
-    //Sort the points
+    //Filter and sort the points
     std::vector<Point2<T>> sortedPoints(first, end);
-    std::sort(sortedPoints.begin(), sortedPoints.end());
+    internal::aklToussaintFilter<T>(sortedPoints);
+    internal::parallelSort<T>(sortedPoints);
 
-    //If the is composed by 1 points (or more than 1 of the same point)
-    if (*(sortedPoints.begin()) == *(sortedPoints.rbegin())) {
-        *outIt = *(sortedPoints.begin());
-        outIt++;
+    internal::convexHullOfSortedPoints<T>(sortedPoints.begin(), sortedPoints.end(), outIt);
+
+    return outIt;
+}
+
+
+/* ----- IMPLEMENTATION OF DIVIDE AND CONQUER ----- */
+
+/**
+ * @brief Get the 2D convex hull using the divide and conquer algorithm
+ * @param[in] container Container of the points of the shape
+ * @param[out] convexHull Output container for the convex hull
+ */
+template <class T, class InputContainer, class OutputContainer>
+void convexHull2DDivideAndConquer(const InputContainer& container, OutputContainer& convexHull)
+{
+    convexHull2DDivideAndConquer<T>(container.begin(), container.end(), std::back_inserter(convexHull));
+}
+
+/**
+ * @brief Get the 2D convex hull using the divide and conquer algorithm on
+ * iterators of containers.
+ *
+ * After the Akl-Toussaint filter, the points are split in one chunk per thread:
+ * the convex hulls of the chunks are computed in parallel with the Graham scan,
+ * then their vertices are merged with a last Graham scan.
+ * The output is the same of convexHull2D(), except for points that are
+ * collinear within the tolerance of cg3::isPointAtRight().
+ *
+ * @param[in] first First iterator of the input container
+ * @param[in] end End iterator of the input container
+ * @param[out] outIt Output iterator for the container containing the convex hull
+ * @return New output iterator
+ */
+template <class T, class InputIterator, class OutputIterator>
+OutputIterator convexHull2DDivideAndConquer(InputIterator first, InputIterator end, OutputIterator outIt)
+{
+    //If the container is empty
+    if (first == end)
+        return outIt;
+
+    std::vector<Point2<T>> points(first, end);
+    internal::aklToussaintFilter<T>(points);
 
+    const long long int nChunks = std::min<long long int>(internal::convexHull2DThreads(), points.size());
+    std::vector<std::vector<Point2<T>>> chunkHulls(nChunks);
+
+    #pragma omp parallel for
+    for (long long int c = 0; c < nChunks; c++) {
+        typename std::vector<Point2<T>>::iterator chunkBegin = points.begin() + points.size() * c / nChunks;
+        typename std::vector<Point2<T>>::iterator chunkEnd = points.begin() + points.size() * (c+1) / nChunks;
+        std::sort(chunkBegin, chunkEnd);
+
+        std::back_insert_iterator<std::vector<Point2<T>>> chunkIt = std::back_inserter(chunkHulls[c]);
+        internal::convexHullOfSortedPoints<T>(chunkBegin, chunkEnd, chunkIt);
+    }
+
+    //Merge of the hulls of the chunks
+    std::vector<Point2<T>> mergedPoints;
+    for (const std::vector<Point2<T>>& hull : chunkHulls)
+        mergedPoints.insert(mergedPoints.end(), hull.begin(), hull.end());
+    std::sort(mergedPoints.begin(), mergedPoints.end());
+
+    internal::convexHullOfSortedPoints<T>(mergedPoints.begin(), mergedPoints.end(), outIt);
+
+    return outIt;
+}
+
+
+/* ----- IMPLEMENTATION OF CHAN'S ALGORITHM ----- */
+
+/**
+ * @brief Get the 2D convex hull using Chan's algorithm
+ * @param[in] container Container of the points of the shape
+ * @param[out] convexHull Output container for the convex hull
+ */
+template <class T, class InputContainer, class OutputContainer>
+void convexHull2DChan(const InputContainer& container, OutputContainer& convexHull)
+{
+    convexHull2DChan<T>(container.begin(), container.end(), std::back_inserter(convexHull));
+}
+
+/**
+ * @brief Get the 2D convex hull using Chan's algorithm on iterators of containers.
+ *
+ * Output sensitive algorithm, to be preferred when the convex hull has few
+ * vertices: the points are split in groups of m points, whose convex hulls
+ * are computed in parallel; then the convex hull is wrapped (Jarvis march)
+ * finding the tangents of the groups with a binary search. If the convex hull
+ * has more than m vertices, m is squared and the process is repeated.
+ * The output is the same of convexHull2D(), except for points that are
+ * collinear within the tolerance of cg3::isPointAtRight().
+ *
+ * @param[in] first First iterator of the input container
+ * @param[in] end End iterator of the input container
+ * @param[out] outIt Output iterator for the container containing the convex hull
+ * @return New output iterator
+ *
+ * @par Complexity:
+ *      \e O(n log h), where h is the number of vertices of the convex hull
+ */
+template <class T, class InputIterator, class OutputIterator>
+OutputIterator convexHull2DChan(InputIterator first, InputIterator end, OutputIterator outIt)
+{
+    //If the container is empty
+    if (first == end)
         return outIt;
+
+    std::vector<Point2<T>> points(first, end);
+    internal::aklToussaintFilter<T>(points);
+
+    std::vector<Point2<T>> convexHull;
+    bool done = false;
+    for (size_t m = 4; !done; m = (m >= points.size() / m ? points.size() : m * m)) {
+        done = internal::chanConvexHull<T>(points, std::min(m, points.size()), convexHull);
     }
 
-    //Graham scan on upper and lower convex hull
-    internal::grahamScanOnContainer<T>(sortedPoints.begin(), sortedPoints.end(), outIt);
-    internal::grahamScanOnContainer<T>(sortedPoints.rbegin(), sortedPoints.rend(), outIt);
+    for (const Point2<T>& p : convexHull) {
+        *outIt = p;
+        ++outIt;
+    }
 
     return outIt;
 }
@@ -76,6 +222,7 @@ OutputIterator convexHull2D(InputIterator first, InputIterator end, OutputIterat
 
 namespace internal {
 
+
 /**
  * @brief Graham scan on a collection of points (upper or lower)
  * @param[in] first First iterator of the input container
@@ -164,5 +311,312 @@ void grahamScanOnContainer(const InputIterator first, const InputIterator end, O
     }
 }
 
+
+/**
+ * @brief Convex hull of a range of sorted points
+ * @param[in] first First iterator of the sorted points
+ * @param[in] end End iterator of the sorted points
+ * @param[out] outIt Output iterator for the container containing the convex hull
+ */
+template <class T, class InputIterator, class OutputIterator>
+void convexHullOfSortedPoints(const InputIterator first, const InputIterator end, OutputIterator& outIt)
+{
+    if (first == end)
+        return;
+
+    //If the is composed by 1 points (or more than 1 of the same point)
+    if (*first == *std::prev(end)) {
+        *outIt = *first;
+        outIt++;
+        return;
+    }
+
+    //Graham scan on upper and lower convex hull
+    grahamScanOnContainer<T>(first, end, outIt);
+    grahamScanOnContainer<T>(std::reverse_iterator<InputIterator>(end), std::reverse_iterator<InputIterator>(first), outIt);
+}
+
+/**
+ * @brief Removes the points that are strictly inside the polygon having as
+ * vertices the extreme points along the directions x, x+y, y, y-x, -x, -x-y,
+ * -y, x-y (Akl-Toussaint heuristic): they cannot be on the convex hull.
+ * The extreme points are found with a single parallel pass.
+ * @param[in/out] points
+ */
+template <class T>
+void aklToussaintFilter(std::vector<Point2<T>>& points)
+{
+    const long long int nPoints = (long long int)points.size();
+    if (nPoints < 8)
+        return;
+
+    long long int extremes[8];
+    double extremeValues[8];
+    for (unsigned int d = 0; d < 8; d++) {
+        extremes[d] = 0;
+        extremeValues[d] = std::numeric_limits<double>::lowest();
+    }
+
+    #pragma omp parallel
+    {
+        long long int localExtremes[8];
+        double localValues[8];
+        for (unsigned int d = 0; d < 8; d++) {
+            localExtremes[d] = 0;
+            localValues[d] = std::numeric_limits<double>::lowest();
+        }
+
+        #pragma omp for nowait
+        for (long long int i = 0; i < nPoints; i++) {
+            const double x = points[i].x();
+            const double y = points[i].y();
+            const double values[8] = {x, x+y, y, y-x, -x, -x-y, -y, x-y};
+            for (unsigned int d = 0; d < 8; d++) {
+                if (values[d] > localValues[d]) {
+                    localValues[d] = values[d];
+                    localExtremes[d] = i;
+                }
+            }
+        }
+
+        #pragma omp critical
+        {
+            for (unsigned int d = 0; d < 8; d++) {
+                if (localValues[d] > extremeValues[d] ||
+                        (localValues[d] == extremeValues[d] && localExtremes[d] < extremes[d])) {
+                    extremeValues[d] = localValues[d];
+                    extremes[d] = localExtremes[d];
+                }
+            }
+        }
+    }
+
+    //The extreme points are in counterclockwise order
+    std::vector<Point2<T>> polygon;
+    for (unsigned int d = 0; d < 8; d++) {
+        const Point2<T>& p = points[extremes[d]];
+        if (polygon.empty() || polygon.back() != p)
+            polygon.push_back(p);
+    }
+    while (polygon.size() > 1 && polygon.back() == polygon.front())
+        polygon.pop_back();
+    if (polygon.size() < 3)
+        return;
+
+    //Edges of the polygon: a point p is at their left if dx * (p.y - y) - dy * (p.x - x) > epsilon
+    const size_t nEdges = polygon.size();
+    std::vector<double> edges(4 * nEdges);
+    for (size_t j = 0; j < nEdges; j++) {
+        const Point2<T>& p1 = polygon[j];
+        const Point2<T>& p2 = polygon[(j+1) % nEdges];
+        edges[4*j] = p1.x();
+        edges[4*j+1] = p1.y();
+        edges[4*j+2] = p2.x() - p1.x();
+        edges[4*j+3] = p2.y() - p1.y();
+    }
+
+    std::vector<char> keep(nPoints);
+    #pragma omp parallel for
+    for (long long int i = 0; i < nPoints; i++) {
+        const double x = points[i].x();
+        const double y = points[i].y();
+        bool inside = true;
+        for (size_t j = 0; j < nEdges && inside; j++) {
+            const double* e = &edges[4*j];
+            if (e[2] * (y - e[1]) - e[3] * (x - e[0]) <= std::numeric_limits<double>::epsilon())
+                inside = false;
+        }
+        keep[i] = !inside;
+    }
+
+    size_t nKept = 0;
+    for (long long int i = 0; i < nPoints; i++) {
+        if (keep[i])
+            points[nKept++] = points[i];
+    }
+    points.resize(nKept);
+}
+
+/**
+ * @brief Sorts the points: chunks of points are sorted in parallel and then
+ * merged pairwise, in parallel
+ * @param[in/out] points
+ */
+template <class T>
+void parallelSort(std::vector<Point2<T>>& points)
+{
+    const long long int nChunks = convexHull2DThreads();
+    if (nChunks <= 1 || points.size() < 10000) {
+        std::sort(points.begin(), points.end());
+        return;
+    }
+
+    std::vector<size_t> bounds(nChunks + 1);
+    for (long long int c = 0; c <= nChunks; c++)
+        bounds[c] = points.size() * c / nChunks;
+
+    #pragma omp parallel for
+    for (long long int c = 0; c < nChunks; c++)
+        std::sort(points.begin() + bounds[c], points.begin() + bounds[c+1]);
+
+    for (long long int width = 1; width < nChunks; width *= 2) {
+        #pragma omp parallel for
+        for (long long int c = 0; c < nChunks; c += 2 * width) {
+            if (c + width < nChunks) {
+                std::inplace_merge(
+                            points.begin() + bounds[c],
+                            points.begin() + bounds[c + width],
+                            points.begin() + bounds[std::min(c + 2 * width, nChunks)]);
+            }
+        }
+    }
+}
+
+/**
+ * @brief One iteration of Chan's algorithm with groups of m points
+ * @param[in] points
+ * @param[in] m: size of the groups
+ * @param[out] convexHull
+ * @return false if the convex hull has more than m vertices
+ */
+template <class T>
+bool chanConvexHull(const std::vector<Point2<T>>& points, size_t m, std::vector<Point2<T>>& convexHull)
+{
+    const long long int nGroups = (long long int)((points.size() + m - 1) / m);
+    std::vector<std::vector<Point2<T>>> hulls(nGroups);
+    std::vector<size_t> splits(nGroups);
+
+    //Convex hull of the groups: counterclockwise, starting from the smallest point
+    #pragma omp parallel for
+    for (long long int g = 0; g < nGroups; g++) {
+        std::vector<Point2<T>> group(
+                    points.begin() + g * m,
+                    points.begin() + std::min<size_t>((g + 1) * m, points.size()));
+        std::sort(group.begin(), group.end());
+
+        std::back_insert_iterator<std::vector<Point2<T>>> hullIt = std::back_inserter(hulls[g]);
+        convexHullOfSortedPoints<T>(group.begin(), group.end(), hullIt);
+        splits[g] = std::max_element(hulls[g].begin(), hulls[g].end()) - hulls[g].begin();
+    }
+
+    const Point2<T>* start = &hulls[0][0];
+    for (long long int g = 1; g < nGroups; g++) {
+        if (hulls[g][0] < *start)
+            start = &hulls[g][0];
+    }
+
+    //Jarvis march on the hulls of the groups
+    convexHull.clear();
+    convexHull.push_back(*start);
+    Point2<T> p = *start;
+    for (size_t step = 0; step < m; step++) {
+        const Point2<T>* best = nullptr;
+        for (long long int g = 0; g < nGroups; g++) {
+            const Point2<T>& c = hulls[g][chanTangent<T>(hulls[g], splits[g], p)];
+            if (c == p)
+                continue;
+            if (best == nullptr) {
+                best = &c;
+            }
+            else {
+                int o = orientation(p, *best, c);
+                if (o < 0 || (o == 0 && p.dist(c) > p.dist(*best)))
+                    best = &c;
+            }
+        }
+        if (best == nullptr || *best == *start)
+            return true;
+        convexHull.push_back(*best);
+        p = *best;
+    }
+    return false;
+}
+
+/**
+ * @brief Finds the vertex q of a convex hull such that no vertex is at the
+ * right of the line p-q (the farthest one among the collinear ones).
+ *
+ * The convex hull must be in counterclockwise order, starting from its
+ * smallest point; split is the position of its greatest point.
+ * The point p must be outside the convex hull or one of its vertices.
+ *
+ * @par Complexity:
+ *      \e O(log n)
+ */
+template <class T>
+size_t chanTangent(const std::vector<Point2<T>>& hull, size_t split, const Point2<T>& p)
+{
+    const size_t n = hull.size();
+    if (n == 1)
+        return 0;
+
+    //p is a vertex of the hull: the lower chain is sorted, the upper chain is reverse sorted
+    typename std::vector<Point2<T>>::const_iterator it =
+            std::lower_bound(hull.begin(), hull.begin() + split + 1, p);
+    if (it != hull.begin() + split + 1 && *it == p)
+        return (it - hull.begin() + 1) % n;
+    it = std::lower_bound(hull.begin() + split, hull.end(), p, std::greater<Point2<T>>());
+    if (it != hull.end() && *it == p)
+        return (it - hull.begin() + 1) % n;
+
+    size_t q;
+    const int orientation0 = orientation(p, hull[0], hull[1]);
+    if (orientation0 >= 0 && orientation(p, hull[0], hull[n-1]) >= 0) {
+        q = 0;
+    }
+    else {
+        //Seen from p, the angle of the vertices is cyclically unimodal: binary
+        //search of the first vertex after the minimum, with respect to the vertex 0
+        size_t lo = 1, hi = n - 1;
+        while (lo < hi) {
+            size_t mid = (lo + hi) / 2;
+            bool increasing = orientation(p, hull[mid], hull[(mid + 1) % n]) > 0;
+            int side = orientation(p, hull[0], hull[mid]);
+            bool afterMinimum = orientation0 > 0 ?
+                        increasing && side < 0 :
+                        increasing || side > 0;
+            if (afterMinimum)
+                hi = mid;
+            else
+                lo = mid + 1;
+        }
+        q = lo;
+    }
+
+    size_t next = (q + 1) % n;
+    size_t prev = (q + n - 1) % n;
+    if (orientation(p, hull[q], hull[next]) == 0 && p.dist(hull[next]) > p.dist(hull[q]))
+        q = next;
+    else if (orientation(p, hull[q], hull[prev]) == 0 && p.dist(hull[prev]) > p.dist(hull[q]))
+        q = prev;
+    return q;
+}
+
+/**
+ * @brief Orientation of the point p3 with respect to the line p1-p2
+ * @return 1 if it is at the left, -1 if it is at the right, 0 otherwise
+ */
+template <class T>
+int orientation(const Point2<T>& p1, const Point2<T>& p2, const Point2<T>& p3)
+{
+    if (cg3::isPointAtLeft(p1, p2, p3))
+        return 1;
+    if (cg3::isPointAtRight(p1, p2, p3))
+        return -1;
+    return 0;
+}
+
+/**
+ * @brief Number of threads used by the parallel algorithms
+ */
+inline unsigned int convexHull2DThreads()
+{
+#ifdef _OPENMP
+    return omp_get_max_threads();
+#else
+    return 1;
+#endif
+}
+
 } //namespace cg3::internal;
 } //namespace cg3
@@ -17,6 +17,22 @@ void convexHull2D(const InputContainer& container, OutputContainer& convexHull);
 template <class T = double, class InputIterator, class OutputIterator>
 OutputIterator convexHull2D(const InputIterator first, const InputIterator end, OutputIterator outIt);
 
+/* Divide and conquer: the hulls of the chunks are computed in parallel and then merged */
+
+template <class T = double, class InputContainer, class OutputContainer>
+void convexHull2DDivideAndConquer(const InputContainer& container, OutputContainer& convexHull);
+
+template <class T = double, class InputIterator, class OutputIterator>
+OutputIterator convexHull2DDivideAndConquer(const InputIterator first, const InputIterator end, OutputIterator outIt);
+
+/* Chan's algorithm: output sensitive */
+
+template <class T = double, class InputContainer, class OutputContainer>
+void convexHull2DChan(const InputContainer& container, OutputContainer& convexHull);
+
+template <class T = double, class InputIterator, class OutputIterator>
+OutputIterator convexHull2DChan(const InputIterator first, const InputIterator end, OutputIterator outIt);
+
 } //namespace cg3
 
 #include "convex_hull2.cpp"
@@ -6,6 +6,10 @@
  */
 #include "convex_hull2_incremental.h"
 
+#include <algorithm>
+#include <functional>
+#include <iterator>
+
 namespace cg3 {
 
 
@@ -13,11 +17,23 @@ namespace cg3 {
 
 namespace internal {
 
-template <class T>
-void processConvexHull(
+template <class T, class Compare>
+void processConvexHullChain(
+        const Point2<T>& point,
+        std::vector<Point2<T>>& chain,
+        Compare comp);
+
+template <class T, class Compare>
+void mergeConvexHullChain(
+        const std::vector<Point2<T>>& points,
+        std::vector<Point2<T>>& chain,
+        Compare comp);
+
+template <class T, class Compare>
+bool canBeOnConvexHullChain(
         const Point2<T>& point,
-        std::set<Point2<T>>& upper,
-        std::set<Point2<T>>& lower);
+        const std::vector<Point2<T>>& chain,
+        Compare comp);
 
 }
 
@@ -64,22 +80,34 @@ IncrementalConvexHull<T>::IncrementalConvexHull(const InputContainer& container)
 
 
 /**
- * @brief Constructors to initialize the convex hull with given points
- * given the on iterators of containers
+ * @brief Add a batch of points to the convex hull, given the iterators
+ * of a container.
+ *
+ * The points of the batch that can be on the chains are sorted and merged
+ * with the current chains, which are then scanned once.
+ *
  * @param[in] first First iterator of the input container
  * @param[in] end End iterator of the input container
+ *
+ * @par Complexity:
+ *      \e O(h + k log k), where h is the size of the convex hull and k the
+ *      number of added points
  */
 template <class T> template <class InputIterator>
 void IncrementalConvexHull<T>::addPoints(const InputIterator first, const InputIterator end)
 {
-    for (InputIterator it = first; it != end; it++) {
-        this->addPoint(*it);
+    std::vector<Point2<T>> points(first, end);
+    if (points.size() == 1) {
+        this->addPoint(points[0]);
+        return;
     }
+
+    internal::mergeConvexHullChain<T>(points, this->upper, std::less<Point2<T>>());
+    internal::mergeConvexHullChain<T>(points, this->lower, std::greater<Point2<T>>());
 }
 
 /**
- * @brief Constructors to initialize the convex hull with given points
- * in a container
+ * @brief Add the points of a container to the convex hull
  * @param[in] points Container of the points of the shape
  */
 template <class T> template <class InputContainer>
@@ -94,11 +122,15 @@ void IncrementalConvexHull<T>::addPoints(const InputContainer& container)
 /**
  * @brief Add a new point to the convex hull
  * @param[in] point Input point
+ *
+ * @par Complexity:
+ *      \e O(log h) if the point is inside the convex hull, \e O(h) otherwise
  */
 template <class T>
 void IncrementalConvexHull<T>::addPoint(const Point2<T>& point)
 {
-    internal::processConvexHull<T>(point, this->upper, this->lower);
+    internal::processConvexHullChain<T>(point, this->upper, std::less<Point2<T>>());
+    internal::processConvexHullChain<T>(point, this->lower, std::greater<Point2<T>>());
 }
 
 /**
@@ -112,32 +144,15 @@ void IncrementalConvexHull<T>::convexHull(OutputIterator out)
     if (this->upper.size() > 1) {
 
         //Upper convex hull
-        auto firstUpper = this->upper.begin();
-        auto lastUpper = std::prev(this->upper.end());
-
-        typename std::set<Point2<T>>::iterator itUpper = firstUpper;
-
-        do {
-            *out = *itUpper;
+        for (size_t i = 0; i < this->upper.size() - 1; i++) {
+            *out = this->upper[i];
             out++;
-
-            itUpper++;
-        } while (itUpper != lastUpper);
-
+        }
 
         //Lower convex hull
-        if (!this->lower.empty()) {
-            auto firstLower = this->lower.rbegin();
-            auto lastLower = std::prev(this->lower.rend());
-
-            typename std::set<Point2<T>>::reverse_iterator itLower = firstLower;
-
-            do {
-                *out = *itLower;
-                out++;
-
-                itLower++;
-            } while (itLower != lastLower);
+        for (size_t i = 0; i + 1 < this->lower.size(); i++) {
+            *out = this->lower[i];
+            out++;
         }
 
     }
@@ -182,165 +197,122 @@ void addPointToConvexHull(
 namespace internal {
 
 /**
- * @brief Algorithm step for processing incremental convex hull
+ * @brief Algorithm step for processing incremental convex hull on one of
+ * its chains
  *
  * @param[in] point Added point
- * @param[out] upper Current upper convex hull
- * @param[out] lower Current upper convex hull
+ * @param[out] chain Current chain of the convex hull, sorted by comp
+ * @param[in] comp Comparator: std::less for the upper chain, std::greater
+ * for the lower chain
  */
-template <class T>
-void processConvexHull(
+template <class T, class Compare>
+void processConvexHullChain(
         const Point2<T>& point,
-        std::set<Point2<T>>& upper,
-        std::set<Point2<T>>& lower)
+        std::vector<Point2<T>>& chain,
+        Compare comp)
 {
-    typedef typename std::set<Point2<T>>::iterator SetIt;
+    typedef typename std::vector<Point2<T>>::iterator VecIt;
 
+    if (!canBeOnConvexHullChain(point, chain, comp))
+        return;
 
-    // Upper convex hull
-
-    if (upper.size() < 2) {
-        upper.insert(point);
-    }
-    else {
-        //Get first and last
-        SetIt firstUpper = upper.begin();
-        SetIt lastUpper = std::prev(upper.end());
+    VecIt it = std::lower_bound(chain.begin(), chain.end(), point, comp);
+    if (it != chain.end() && *it == point)
+        return;
 
+    const long long int pos = it - chain.begin();
+    const long long int size = (long long int) chain.size();
 
-        //If the point is an endpoints
-        //Or the it is at the left of the first-last segment
-        if (
-                point < *firstUpper ||
-                point > *lastUpper ||
-                cg3::isPointAtRight(*firstUpper, *lastUpper, point))
-        {
-            std::pair<SetIt, bool> pairUpperIt = upper.insert(point);
-            SetIt upperIt = pairUpperIt.first;
-
-            //Set endpoints if they exist
-
-            SetIt upperPrev = upper.end();
-            if (*upperIt != *firstUpper) {
-                upperPrev = upperIt;
-                upperPrev--;
-            }
-            SetIt upperNext = upper.end();
-            if (*upperIt != *lastUpper) {
-                upperNext = upperIt;
-                upperNext++;
-            }
-
-            //If the new iterator has prev and next
-            //Erase point if the point is at left of the neighbor segment
-            if (
-                    upperPrev != upper.end() &&
-                    upperNext != upper.end() &&
-                    !cg3::isPointAtRight(*upperPrev, *upperNext, *upperIt))
-            {
-                upper.erase(upperIt);
-            }
-            else {
-                //If the point has a prev
-                if (upperPrev != upper.end()) {
-                    SetIt upperPrevPrev = upperPrev;
-                    upperPrevPrev--;
-
-                    while (*upperPrev != *firstUpper &&
-                           !cg3::isPointAtRight(*upperPrevPrev, *upperIt, *upperPrev)) {
-                        upperPrevPrev--;
-                        upper.erase(upperPrev--);
-                    }
-                }
-
-                //If the point has a next
-                if (upperNext != upper.end()) {
-                    SetIt upperNextNext = upperNext;
-                    upperNextNext++;
-
-                    while (*upperNext != *lastUpper &&
-                           !cg3::isPointAtRight(*upperIt, *upperNextNext, *upperNext)) {
-                        upperNextNext++;
-                        upper.erase(upperNext++);
-                    }
-                }
-            }
-        }
+    //Points before the new one that are no more on the chain: (l, pos)
+    long long int l = pos - 1;
+    if (l >= 0) {
+        while (l > 0 && !cg3::isPointAtRight(chain[l-1], point, chain[l]))
+            l--;
     }
 
+    //Points after the new one that are no more on the chain: [pos, r)
+    long long int r = pos;
+    if (r < size) {
+        while (r < size - 1 && !cg3::isPointAtRight(point, chain[r+1], chain[r]))
+            r++;
+    }
 
-
-    // Lower convex hull
-
-
-    if (lower.size() < 2) {
-        lower.insert(point);
+    if (l + 1 < r) {
+        chain[l+1] = point;
+        chain.erase(chain.begin() + l + 2, chain.begin() + r);
     }
     else {
-        //Get first and last
-        SetIt firstLower = std::prev(lower.end());
-        SetIt lastLower = lower.begin();
-
-        //If the point is an endpoints
-        //Or the it is at the left of the first-last segment
-        if (
-                point > *firstLower ||
-                point < *lastLower ||
-                cg3::isPointAtRight(*firstLower, *lastLower, point))
+        chain.insert(chain.begin() + pos, point);
+    }
+}
+
+/**
+ * @brief Merges points with one of the chains of the convex hull: the points
+ * that can be on the chain are sorted and merged with it, then the chain is
+ * recomputed with a single scan
+ *
+ * @param[in] points Added points
+ * @param[out] chain Current chain of the convex hull, sorted by comp
+ * @param[in] comp Comparator: std::less for the upper chain, std::greater
+ * for the lower chain
+ */
+template <class T, class Compare>
+void mergeConvexHullChain(
+        const std::vector<Point2<T>>& points,
+        std::vector<Point2<T>>& chain,
+        Compare comp)
+{
+    std::vector<Point2<T>> sortedPoints;
+    for (const Point2<T>& point : points) {
+        if (canBeOnConvexHullChain(point, chain, comp))
+            sortedPoints.push_back(point);
+    }
+    if (sortedPoints.empty())
+        return;
+    std::sort(sortedPoints.begin(), sortedPoints.end(), comp);
+
+    std::vector<Point2<T>> merged(chain.size() + sortedPoints.size());
+    std::merge(chain.begin(), chain.end(), sortedPoints.begin(), sortedPoints.end(), merged.begin(), comp);
+    merged.erase(std::unique(merged.begin(), merged.end()), merged.end());
+
+    chain.clear();
+    for (const Point2<T>& point : merged) {
+        while (chain.size() >= 2 &&
+               !cg3::isPointAtRight(chain[chain.size()-2], point, chain.back()))
         {
-            std::pair<SetIt, bool> pairLowerIt = lower.insert(point);
-            SetIt lowerIt = pairLowerIt.first;
-
-            //Set endpoints if they exist
-
-            SetIt lowerPrev = lower.end();
-            if (*lowerIt != *firstLower) {
-                lowerPrev = lowerIt;
-                lowerPrev++;
-            }
-            SetIt lowerNext = lower.end();
-            if (*lowerIt != *lastLower) {
-                lowerNext = lowerIt;
-                lowerNext--;
-            }
-
-            //If the new iterator has prev and next
-            //Erase point if the point is at left of the neighbor segment
-            if (
-                    lowerPrev != lower.end() &&
-                    lowerNext != lower.end() &&
-                    !cg3::isPointAtRight(*lowerPrev, *lowerNext, *lowerIt))
-            {
-                lower.erase(lowerIt);
-            }
-            else {
-                //If the point has a prev
-                if (lowerPrev != lower.end()) {
-                    SetIt lowerPrevPrev = lowerPrev;
-                    lowerPrevPrev++;
-
-                    while (*lowerPrev != *firstLower &&
-                           !cg3::isPointAtRight(*lowerPrevPrev, *lowerIt, *lowerPrev)) {
-                        lowerPrevPrev++;
-                        lower.erase(lowerPrev++);
-                    }
-                }
-
-                //If the point has a next
-                if (lowerNext != lower.end()) {
-                    SetIt lowerNextNext = lowerNext;
-                    lowerNextNext--;
-
-                    while (*lowerNext != *lastLower &&
-                           !cg3::isPointAtRight(*lowerIt, *lowerNextNext, *lowerNext)) {
-                        lowerNextNext--;
-                        lower.erase(lowerNext--);
-                    }
-                }
-            }
+            chain.pop_back();
         }
+        chain.push_back(point);
     }
+}
 
+/**
+ * @brief Check if a point can be on a chain of the convex hull: it must be
+ * a new endpoint or at the right of the segment of the chain that has the
+ * same abscissa
+ *
+ * @param[in] point Input point
+ * @param[in] chain Current chain of the convex hull, sorted by comp
+ * @param[in] comp Comparator of the chain
+ */
+template <class T, class Compare>
+bool canBeOnConvexHullChain(
+        const Point2<T>& point,
+        const std::vector<Point2<T>>& chain,
+        Compare comp)
+{
+    if (chain.size() < 2 || comp(point, chain.front()) || comp(chain.back(), point))
+        return true;
+
+    if (!cg3::isPointAtRight(chain.front(), chain.back(), point))
+        return false;
+
+    //The point must be at the right of the segment of the chain below it
+    typename std::vector<Point2<T>>::const_iterator it =
+            std::lower_bound(chain.begin(), chain.end(), point, comp);
+    if (*it == point)
+        return false;
+    return cg3::isPointAtRight(*std::prev(it), *it, point);
 }
 
 } //namespace cg3::internal
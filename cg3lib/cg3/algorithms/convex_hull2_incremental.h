@@ -7,7 +7,7 @@
 #ifndef CG3_CONVEXHULL2D_INCREMENTAL_H
 #define CG3_CONVEXHULL2D_INCREMENTAL_H
 
-#include <set>
+#include <vector>
 
 #include "cg3/geometry/point2.h"
 #include "cg3/geometry/utils2.h"
@@ -16,6 +16,9 @@ namespace cg3 {
 
 /**
  * @brief Incremental convex hull data structure
+ *
+ * The two chains of the convex hull are stored in sorted vectors: the upper
+ * one in increasing order, the lower one in decreasing order.
  */
 template <class T>
 class IncrementalConvexHull {
@@ -54,8 +57,8 @@ private:
 
     /* Private fields */
 
-    std::set<Point2<T>> upper;
-    std::set<Point2<T>> lower;
+    std::vector<Point2<T>> upper;
+    std::vector<Point2<T>> lower;
 
 };
 
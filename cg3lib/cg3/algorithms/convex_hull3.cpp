@@ -7,7 +7,8 @@
  */
 
 #include "convex_hull3.h"
-#include <Eigen/Dense>
+#include <random>
+#include <algorithm>
 
 namespace cg3 {
 
@@ -16,20 +17,48 @@ namespace cg3 {
 
 namespace internal {
 
+/**
+ * @brief Conflict lists of the incremental convex hull.
+ *
+ * Every point that is not inserted yet is assigned to just one of the faces
+ * of the current hull that it sees (QuickHull-style outside sets): when that
+ * face is removed, the point is either inside the new hull or sees one of the
+ * new faces. Points are identified by their position in the insertion order,
+ * faces by their id in the Dcel.
+ * Visibility marks are stamped with the current epoch (one per inserted point),
+ * so they never need to be cleared.
+ */
+struct ConvexHullConflicts {
+    std::vector<std::vector<unsigned int>> facePoints;
+    std::vector<int> pointFace;
+
+    std::vector<unsigned int> faceVisited;
+    std::vector<unsigned int> faceVisible;
+    std::vector<unsigned int> vertexMark;
+    unsigned int epoch = 0;
+
+    void growFaces(unsigned int fid);
+    void growVertices(unsigned int vid);
+};
+
 inline double areCoplanar(const Point3d &p0, const Point3d &p1, const Point3d &p2, const Point3d &p3);
 
 inline bool isFaceVisible(const Dcel::Face* f, const Point3d &p);
 
+inline bool initialTetrahedron(const std::vector<Point3d>& points, std::vector<unsigned int>& ids);
+
+inline void convexHullPrefilter(const std::vector<Point3d>& points, std::vector<unsigned int>& ids);
+
 inline void insertTet(Dcel &dcel, const Point3d &p0, const Point3d &p1, const Point3d &p2, const Point3d &p3,
                       int flag0 = 0, int flag1 = 0, int flag2 = 0, int flag3 = 0);
 
-inline void horizonEdgeList(std::vector<Dcel::HalfEdge*> &horizon, const std::set<Dcel::Face*>& visibleFaces, std::set<Dcel::Vertex*>& horizonVertex, const Point3d &next_point);
+inline void visibleFaceList(std::vector<Dcel::Face*>& visibleFaces, Dcel::Face* seed, const Point3d& p, ConvexHullConflicts& cc);
 
-inline void calculateP(std::vector<std::set<Point3d> >& P, const BipartiteGraph<Point3d, unsigned int>& cg, std::vector<Dcel::HalfEdge*> &horizonEdges);
+inline void horizonEdgeList(std::vector<Dcel::HalfEdge*> &horizon, const std::vector<Dcel::Face*>& visibleFaces, ConvexHullConflicts& cc);
 
-inline void deleteVisibleFaces(Dcel & ch, std::set<Dcel::Vertex*>& horizonVertices, const std::set<Dcel::Face*>& visibleFaces, BipartiteGraph<Point3d, unsigned int>& cg);
+inline void deleteVisibleFaces(Dcel & ch, const std::vector<Dcel::Face*>& visibleFaces, ConvexHullConflicts& cc, std::vector<unsigned int>& orphanPoints);
 
-inline void insertNewFaces (Dcel & ch, std::vector<Dcel::HalfEdge*>& horizonEdges, const Point3d & p, BipartiteGraph<Point3d, unsigned int>& cg, std::vector<std::set<Point3d> > & P, int flagV = 0);
+inline void insertNewFaces (Dcel & ch, std::vector<Dcel::HalfEdge*>& horizonEdges, const Point3d & p, std::vector<Dcel::Face*>& newFaces, int flagV = 0);
 
 } //namespace cg3::internal
 
@@ -37,55 +66,73 @@ inline void insertNewFaces (Dcel & ch, std::vector<Dcel::HalfEdge*>& horizonEdge
 
 /* ----- IMPLEMENTATION OF CONVEX HULL 3D ----- */
 
-inline Dcel convexHull(const Dcel& inputDcel)
+/**
+ * @brief Computes the convex hull of the vertices of a Dcel.
+ * @see convexHull(InputIterator, InputIterator, bool, unsigned int)
+ */
+inline Dcel convexHull(const Dcel& inputDcel, bool prefilter, unsigned int seed)
 {
     std::vector<Point3d> points;
     points.reserve(inputDcel.numberVertices());
     for (const Dcel::Vertex* v : inputDcel.vertexIterator()){
         points.push_back(v->coordinate());
     }
-    return convexHull(points.begin(), points.end());
+    return convexHull(points.begin(), points.end(), prefilter, seed);
 }
 
+/**
+ * @brief Computes the convex hull of a container of Point3d.
+ * @see convexHull(InputIterator, InputIterator, bool, unsigned int)
+ */
 template <class InputContainer>
-Dcel convexHull(const InputContainer& container)
+Dcel convexHull(const InputContainer& container, bool prefilter, unsigned int seed)
 {
-    return convexHull(container.begin(), container.end());
+    return convexHull(container.begin(), container.end(), prefilter, seed);
 }
 
-
+/**
+ * @brief Computes the convex hull of the Point3d in the range [first, end),
+ * using the randomized incremental algorithm.
+ *
+ * The flag of every vertex of the output Dcel is the position in the range
+ * of the corresponding input point.
+ * If all the points are coplanar, an empty Dcel is returned.
+ *
+ * @param[in] first, end: range of Point3d
+ * @param[in] prefilter: if true, the points that are strictly inside the
+ * polytope spanned by the extreme points along 26 directions are discarded
+ * (in parallel) before starting the incremental construction. It pays off on
+ * large inputs having most of the points inside the hull.
+ * @param[in] seed: seed of the random insertion order
+ *
+ * @par Complexity:
+ *      \e O(n log n) expected
+ */
 template <class InputIterator>
-Dcel convexHull(InputIterator first, InputIterator end)
+Dcel convexHull(InputIterator first, InputIterator end, bool prefilter, unsigned int seed)
 {
     Dcel convexHull;
-    BipartiteGraph<Point3d, unsigned int> cg;
 
     std::vector<Point3d> points(first, end);
-    std::vector<uint> ids(points.size());
-    for (uint i = 0; i < points.size(); ++i)
-        ids[i] = i;
+    std::vector<unsigned int> ids;
 
     if (points.size() > 3) {
+        if (prefilter) {
+            internal::convexHullPrefilter(points, ids);
+        }
+        else {
+            ids.resize(points.size());
+            for (unsigned int i = 0; i < points.size(); ++i)
+                ids[i] = i;
+        }
 
-        //std::random_shuffle(points.begin(), points.end());
-        std::random_shuffle(ids.begin(), ids.end());
+        std::mt19937 generator(seed);
+        std::shuffle(ids.begin(), ids.end(), generator);
 
-        double determinant = 0;
-        unsigned int nPoints = (unsigned int)points.size();
-        uint a, b, c, d;
-        do {
-            a = rand()%nPoints;
-            b = rand()%nPoints;
-            c = rand()%nPoints;
-            d = rand()%nPoints;
-
-            determinant = internal::areCoplanar(points[ids[a]], points[ids[b]], points[ids[c]], points[ids[d]]);
-        } while (determinant == 0);
-        std::swap(ids[0], ids[a]);
-        std::swap(ids[1], ids[b]);
-        std::swap(ids[2], ids[c]);
-        std::swap(ids[3], ids[d]);
+        if (!internal::initialTetrahedron(points, ids))
+            return convexHull;
 
+        double determinant = internal::areCoplanar(points[ids[0]], points[ids[1]], points[ids[2]], points[ids[3]]);
         if (determinant > 0)
             internal::insertTet(convexHull, points[ids[0]], points[ids[1]], points[ids[2]], points[ids[3]],
                     ids[0], ids[1], ids[2], ids[3]);
@@ -93,78 +140,54 @@ Dcel convexHull(InputIterator first, InputIterator end)
             internal::insertTet(convexHull, points[ids[1]], points[ids[0]], points[ids[2]], points[ids[3]],
                     ids[1], ids[0], ids[2], ids[3]);
 
-        for (Dcel::Face* f : convexHull.faceIterator()){
-            cg.addRightNode(f->id());
-        }
-
+        internal::ConvexHullConflicts cc;
+        cc.pointFace.resize(ids.size(), -1);
+        for (Dcel::Face* f : convexHull.faceIterator())
+            cc.growFaces(f->id());
 
-        for (unsigned int i = 4; i < points.size(); i++){
-            cg.addLeftNode(points[ids[i]]);
+        for (unsigned int i = 4; i < ids.size(); i++){
             for (Dcel::Face* f : convexHull.faceIterator()){
-                if (internal::isFaceVisible(f, points[ids[i]]))
-                    cg.addArc(points[ids[i]], f->id());
+                if (internal::isFaceVisible(f, points[ids[i]])){
+                    cc.pointFace[i] = f->id();
+                    cc.facePoints[f->id()].push_back(i);
+                    break;
+                }
             }
         }
 
-        unsigned int iterations = 0;
-        for (const Point3d& p : cg.leftNodeIterator()){ //For every point that is not inserted in the convex hull yet
-            /**
-             * Se il punto è interno al convex hull, nel conflict graph il nodo associato al punto non
-             * ha archi uscenti: si ignora il punto.
-             */
-            if (cg.sizeAdjacencesLeftNode(p) > 0){
-
-                /**
-                 * Calcolo l'array (ordinato per face_id!) delle facce sul convex hull viste da next_point
-                 */
-                std::set<Dcel::Face*> visibleFaces;
-                for (const unsigned int& f : cg.adjacentLeftNodeIterator(p)){
-                    visibleFaces.insert(convexHull.face(f));
+        std::vector<Dcel::Face*> visibleFaces;
+        std::vector<Dcel::HalfEdge*> horizonEdges;
+        std::vector<Dcel::Face*> newFaces;
+        std::vector<unsigned int> orphanPoints;
+
+        for (unsigned int i = 4; i < ids.size(); i++){
+            //points without conflicts are inside the current hull
+            if (cc.pointFace[i] < 0)
+                continue;
+
+            const Point3d& p = points[ids[i]];
+            cc.epoch++;
+
+            internal::visibleFaceList(visibleFaces, convexHull.face(cc.pointFace[i]), p, cc);
+            internal::horizonEdgeList(horizonEdges, visibleFaces, cc);
+            internal::deleteVisibleFaces(convexHull, visibleFaces, cc, orphanPoints);
+            internal::insertNewFaces(convexHull, horizonEdges, p, newFaces, ids[i]);
+            for (Dcel::Face* f : newFaces)
+                cc.growFaces(f->id());
+
+            //the points that saw a removed face are assigned to a new face, if they see one
+            for (unsigned int q : orphanPoints){
+                if (q == i)
+                    continue;
+                cc.pointFace[q] = -1;
+                for (Dcel::Face* f : newFaces){
+                    if (internal::isFaceVisible(f, points[ids[q]])){
+                        cc.pointFace[q] = f->id();
+                        cc.facePoints[f->id()].push_back(q);
+                        break;
+                    }
                 }
-
-                std::set<Dcel::Vertex*> horizonVertex;
-                std::vector<Dcel::HalfEdge*> horizonEdges;
-
-                /**
-                 * Calcolo la lista ordinata degli edge che stanno sul boundary delle facce visibili (orizzonte)
-                 */
-                internal::horizonEdgeList(horizonEdges, visibleFaces, horizonVertex, p);
-
-                /**
-                 * Per ogni edge sull'orizzonte, calcolo i punti non ancora inseriti sul convex hull che vedono l'edge,
-                 * ossia l'unione tra gli insiemi di punti che vedono le due facce adiacenti sull'edge.
-                 * Sono tutti i possibili punti che potranno vedere la nuova faccia che verrà costruita unendo l'edge
-                 * sull'orizzonte con next_point.
-                 * P è quindi un array di array: ogni riga i corrisponde all'i-esimo elemento di horizon.
-                 */
-                std::vector< std::set<Point3d> > P;
-                internal::calculateP(P, cg, horizonEdges);
-
-                /**
-                 * Rimuovo next_point dal conflict graph. è fondamentale farlo subito dopo aver rimosso le facce dal
-                 * convex hull: vengono ricalcolati gli indici dei nodi esattamente come vengono ricalcolati quando
-                 * viene rimosso un elemento dalla DCEL.
-                 */
-                cg.deleteLeftNode(p);
-
-                /**
-                 * Elimino dal convex hull tutte le facce di visible_faces e tutti gli half edge ed i vece ad esse
-                 * incidenti, tranne i vertici che stanno sull'orizzonte.
-                 */
-                internal::deleteVisibleFaces(convexHull, horizonVertex, visibleFaces, cg);
-
-
-                /**
-                 * Inserisco le nuove facce nel convex hull, che andranno a collegare gli edge di horizon con
-                 * next_point. Sempre in questa funzione vengono anche calcolati e aggiunti i nuovi conflitti
-                 * tra le nuove facce e i punti presenti nel conflict graph.
-                 */
-                internal::insertNewFaces(convexHull, horizonEdges, p, cg, P, ids[iterations+4]);
             }
-            else
-                cg.deleteLeftNode(p);
-
-            iterations++;
         }
         convexHull.updateFaceNormals();
         convexHull.updateVertexNormals();
@@ -178,25 +201,42 @@ Dcel convexHull(InputIterator first, InputIterator end)
 
 namespace internal {
 
+inline void ConvexHullConflicts::growFaces(unsigned int fid)
+{
+    if (fid >= facePoints.size()){
+        facePoints.resize(fid+1);
+        faceVisited.resize(fid+1, 0);
+        faceVisible.resize(fid+1, 0);
+    }
+}
+
+inline void ConvexHullConflicts::growVertices(unsigned int vid)
+{
+    if (vid >= vertexMark.size())
+        vertexMark.resize(vid+1, 0);
+}
+
+/**
+ * @brief Returns the determinant of the 4x4 matrix having the homogeneous
+ * coordinates of the four points as rows: it is zero if the points are coplanar.
+ */
 inline double areCoplanar(const Point3d& p0, const Point3d& p1, const Point3d& p2, const Point3d& p3)
 {
-    Eigen::Matrix4d m;
-    m << p0.x(), p0.y(), p0.z(), 1,
-         p1.x(), p1.y(), p1.z(), 1,
-         p2.x(), p2.y(), p2.z(), 1,
-         p3.x(), p3.y(), p3.z(), 1;
+    const Point3d a = p1 - p0;
+    const Point3d b = p2 - p0;
+    const Point3d c = p3 - p0;
 
-    return m.determinant();
+    return - (a.x() * (b.y() * c.z() - b.z() * c.y()) -
+              a.y() * (b.x() * c.z() - b.z() * c.x()) +
+              a.z() * (b.x() * c.y() - b.y() * c.x()));
 }
 
 inline bool isFaceVisible(const Dcel::Face* f, const Point3d& p)
 {
-    Dcel::Face::ConstIncidentVertexIterator vit = f->incidentVertexBegin();
-    Point3d p1 = (*vit)->coordinate();
-    vit++;
-    Point3d p2 = (*vit)->coordinate();
-    vit++;
-    Point3d p3 = (*vit)->coordinate();
+    const Dcel::HalfEdge* he = f->outerHalfEdge();
+    const Point3d& p1 = he->fromVertex()->coordinate();
+    const Point3d& p2 = he->toVertex()->coordinate();
+    const Point3d& p3 = he->next()->toVertex()->coordinate();
     double determinant = areCoplanar(p1, p2, p3, p);
 
     if (determinant > std::numeric_limits<double>::epsilon()) return false;
@@ -204,6 +244,130 @@ inline bool isFaceVisible(const Dcel::Face* f, const Point3d& p)
 
 }
 
+/**
+ * @brief Moves to the first four positions of ids four points that are not
+ * coplanar: the first point, the farthest point from it, the farthest point
+ * from the line passing through them and the farthest point from their plane.
+ * @return false if all the points are coplanar
+ */
+inline bool initialTetrahedron(const std::vector<Point3d>& points, std::vector<unsigned int>& ids)
+{
+    if (ids.size() < 4)
+        return false;
+    const Point3d& p0 = points[ids[0]];
+
+    unsigned int best = 0;
+    double bestValue = 0;
+    for (unsigned int i = 1; i < ids.size(); i++){
+        double d = p0.dist(points[ids[i]]);
+        if (d > bestValue){
+            bestValue = d;
+            best = i;
+        }
+    }
+    if (best == 0)
+        return false;
+    std::swap(ids[1], ids[best]);
+    const Point3d dir = points[ids[1]] - p0;
+
+    best = 0;
+    bestValue = 0;
+    for (unsigned int i = 2; i < ids.size(); i++){
+        double d = dir.cross(points[ids[i]] - p0).length();
+        if (d > bestValue){
+            bestValue = d;
+            best = i;
+        }
+    }
+    if (best == 0)
+        return false;
+    std::swap(ids[2], ids[best]);
+
+    best = 0;
+    bestValue = 0;
+    for (unsigned int i = 3; i < ids.size(); i++){
+        double d = std::abs(areCoplanar(p0, points[ids[1]], points[ids[2]], points[ids[i]]));
+        if (d > bestValue){
+            bestValue = d;
+            best = i;
+        }
+    }
+    if (best == 0)
+        return false;
+    std::swap(ids[3], ids[best]);
+    return true;
+}
+
+/**
+ * @brief Fills ids with the indices of the points that are not strictly inside
+ * the convex hull of the extreme points along the 26 directions of the cube
+ * (Akl-Toussaint heuristic): the discarded points cannot be vertices of the
+ * convex hull.
+ */
+inline void convexHullPrefilter(const std::vector<Point3d>& points, std::vector<unsigned int>& ids)
+{
+    const long long int nPoints = (long long int)points.size();
+    std::vector<Point3d> directions;
+    for (int x = -1; x <= 1; x++)
+        for (int y = -1; y <= 1; y++)
+            for (int z = -1; z <= 1; z++)
+                if (x != 0 || y != 0 || z != 0)
+                    directions.push_back(Point3d(x, y, z));
+
+    std::vector<unsigned int> extremes(directions.size(), 0);
+    #pragma omp parallel for
+    for (long long int d = 0; d < (long long int)directions.size(); d++){
+        double bestValue = points[0].dot(directions[d]);
+        for (long long int i = 1; i < nPoints; i++){
+            double value = points[i].dot(directions[d]);
+            if (value > bestValue){
+                bestValue = value;
+                extremes[d] = (unsigned int)i;
+            }
+        }
+    }
+    std::sort(extremes.begin(), extremes.end());
+    extremes.erase(std::unique(extremes.begin(), extremes.end()), extremes.end());
+
+    std::vector<Point3d> extremePoints;
+    for (unsigned int e : extremes)
+        extremePoints.push_back(points[e]);
+    Dcel filter = convexHull(extremePoints.begin(), extremePoints.end());
+
+    ids.clear();
+    if (filter.numberFaces() == 0){
+        ids.resize(points.size());
+        for (unsigned int i = 0; i < points.size(); ++i)
+            ids[i] = i;
+        return;
+    }
+
+    std::vector<Point3d> planes;
+    planes.reserve(filter.numberFaces() * 3);
+    for (const Dcel::Face* f : filter.faceIterator()){
+        const Dcel::HalfEdge* he = f->outerHalfEdge();
+        planes.push_back(he->fromVertex()->coordinate());
+        planes.push_back(he->toVertex()->coordinate());
+        planes.push_back(he->next()->toVertex()->coordinate());
+    }
+
+    std::vector<char> keep(points.size());
+    #pragma omp parallel for
+    for (long long int i = 0; i < nPoints; i++){
+        bool inside = true;
+        for (unsigned int j = 0; j < planes.size() && inside; j += 3){
+            if (areCoplanar(planes[j], planes[j+1], planes[j+2], points[i]) <= std::numeric_limits<double>::epsilon())
+                inside = false;
+        }
+        keep[i] = !inside;
+    }
+
+    for (unsigned int i = 0; i < points.size(); ++i){
+        if (keep[i])
+            ids.push_back(i);
+    }
+}
+
 inline void insertTet(Dcel& dcel, const Point3d& p0, const Point3d& p1, const Point3d& p2, const Point3d& p3,
                       int flag0, int flag1, int flag2, int flag3)
 {
@@ -353,273 +517,186 @@ inline void insertTet(Dcel& dcel, const Point3d& p0, const Point3d& p1, const Po
     dcel.updateVertexNormals();
 }
 
-inline void horizonEdgeList(std::vector<Dcel::HalfEdge*>& horizon, const std::set<Dcel::Face*>& visibleFaces, std::set<Dcel::Vertex*>& horizonVertex, const Point3d& next_point)
+/**
+ * @brief Computes the faces of the hull that are visible from p, visiting the
+ * faces adjacent to the seed face (the visible region is connected).
+ * Visited and visible faces are marked with the current epoch.
+ */
+inline void visibleFaceList(std::vector<Dcel::Face*>& visibleFaces, Dcel::Face* seed, const Point3d& p, ConvexHullConflicts& cc)
 {
-    Dcel::HalfEdge* e0 = nullptr ,*e1;
-    Dcel::HalfEdge* first_boundary_edge;
-    Dcel::Face* adiacent_face;
-    bool finded = false, sees;
-    std::set<Dcel::Face*>::iterator fid = visibleFaces.begin();
-
-    /** Ciclo di ricerca della Faccia sul boundary*/
-    while (!finded){
-        Dcel::Face* f = *fid;
-
-        for (Dcel::Face::IncidentHalfEdgeIterator heit = f->incidentHalfEdgeBegin(); heit != f->incidentHalfEdgeEnd() && !finded; ++heit){
-            e0 = *heit;
-            e1 = e0->twin();
-            adiacent_face = e1->face();
-            sees=isFaceVisible(adiacent_face, next_point);
-            if (!sees)
-                finded = true;
-        }
-        ++fid;
-        assert (fid != visibleFaces.end() || finded);
+    visibleFaces.clear();
+    visibleFaces.push_back(seed);
+    cc.faceVisited[seed->id()] = cc.epoch;
+    cc.faceVisible[seed->id()] = cc.epoch;
+
+    for (unsigned int i = 0; i < visibleFaces.size(); i++){
+        Dcel::HalfEdge* first = visibleFaces[i]->outerHalfEdge();
+        Dcel::HalfEdge* he = first;
+        do {
+            Dcel::Face* adj = he->twin()->face();
+            if (cc.faceVisited[adj->id()] != cc.epoch){
+                cc.faceVisited[adj->id()] = cc.epoch;
+                if (isFaceVisible(adj, p)){
+                    cc.faceVisible[adj->id()] = cc.epoch;
+                    visibleFaces.push_back(adj);
+                }
+            }
+            he = he->next();
+        } while (he != first);
     }
-
-    // alla fine del ciclo:
-    // - e0: half edge interno alla faccia col bordo nell'orizzonte (incidente a faccia visibile)
-    // - e1: halfedge esterno alla faccia col bordo nell'orizzonte (incidente a faccia non visibile)
-
-    horizon.push_back(e1); // e1 è il primo edge sull'orizzonte
-    horizonVertex.insert(e0->fromVertex());// inserisco il from vertex di e0 in horizon_vertex
-
-    first_boundary_edge = e0;
-    e0 = e0->next(); // e0 al passo successivo: next di e0
-    do { // finchè non incontro nuovamente first_boundary_edge
-        e1 = e0->twin(); // e1: twin di e0
-        adiacent_face = e1->face(); // f: faccia incidente a e1
-        sees=isFaceVisible(adiacent_face, next_point);
-        if (!sees) { // se f è una faccia non visibile
-            // Allora e0/e1 sono sull'orizzonte!
-            horizon.push_back(e1);
-            //he = convex_hull.get_half_edge(e0);
-            horizonVertex.insert(e0->fromVertex());
-            e0 = e0->next(); // e0 al passo successivo: next di e0
-        }
-        else { // altrimenti sono sul triangolo adiacente che non sta sull'orizzonte
-            // devo continuare la ricerca stando sul from vertex di e0
-            e0 = e1->next(); // e0 al passo successivo: next di e1
-            // in questo caso, e1 è incidente ad una faccia visibile da next_point
-            // in questo modo, sto girando sul from vertex di e0
-        }
-    } while (e0 != first_boundary_edge);
-    // finché non ho ritrovaro il primo bordo
 }
 
-inline void calculateP(std::vector< std::set<Point3d> > &P, const BipartiteGraph<Point3d, unsigned int> &cg, std::vector<Dcel::HalfEdge*> &horizonEdges)
+/**
+ * @brief Computes the ordered list of the half edges on the horizon: every
+ * half edge is incident to a non visible face and its twin to a visible face.
+ * The vertices on the horizon are marked with the current epoch.
+ */
+inline void horizonEdgeList(std::vector<Dcel::HalfEdge*>& horizon, const std::vector<Dcel::Face*>& visibleFaces, ConvexHullConflicts& cc)
 {
-    Dcel::HalfEdge* he0, *he1;
-    Dcel::Face* f0, *f1;
-
-    P.clear();
-    P.resize(horizonEdges.size());
-    for (unsigned int i=0; i<horizonEdges.size(); i++){
-        he0 = horizonEdges[i];
-        he1 = he0->twin();
-        f0 = he0->face();
-        f1 = he1->face();
-        // viene inserito in P[i] l'array ordinato contente i punti visibili da f0 e f1
-        for (const Point3d& p : cg.adjacentRightNodeIterator(f0->id()))
-            P[i].insert(p);
-        for (const Point3d& p : cg.adjacentRightNodeIterator(f1->id()))
-            P[i].insert(p);
+    Dcel::HalfEdge* e0 = nullptr ,*e1 = nullptr;
+    bool found = false;
+
+    horizon.clear();
+    //search of a visible face on the boundary of the visible region
+    for (unsigned int i = 0; i < visibleFaces.size() && !found; i++){
+        Dcel::HalfEdge* first = visibleFaces[i]->outerHalfEdge();
+        e0 = first;
+        do {
+            e1 = e0->twin();
+            if (cc.faceVisible[e1->face()->id()] != cc.epoch)
+                found = true;
+            else
+                e0 = e0->next();
+        } while (!found && e0 != first);
     }
+    assert(found);
+
+    // e0: half edge of a visible face on the horizon
+    // e1: its twin, incident to a non visible face
+    Dcel::HalfEdge* firstBoundaryEdge = e0;
+    do {
+        e1 = e0->twin();
+        if (cc.faceVisible[e1->face()->id()] != cc.epoch) {
+            horizon.push_back(e1);
+            cc.growVertices(e0->fromVertex()->id());
+            cc.vertexMark[e0->fromVertex()->id()] = cc.epoch;
+            e0 = e0->next();
+        }
+        else {
+            //rotate around the from vertex of e0
+            e0 = e1->next();
+        }
+    } while (e0 != firstBoundaryEdge);
 }
 
-inline void deleteVisibleFaces(Dcel & ch, std::set<Dcel::Vertex*>& horizonVertices, const std::set<Dcel::Face*> &visibleFaces, BipartiteGraph<Point3d, unsigned int>& cg)
+/**
+ * @brief Deletes the visible faces with their half edges and all their vertices
+ * that are not on the horizon. The points in conflict with the deleted faces
+ * are moved in orphanPoints.
+ */
+inline void deleteVisibleFaces(Dcel & ch, const std::vector<Dcel::Face*>& visibleFaces, ConvexHullConflicts& cc, std::vector<unsigned int>& orphanPoints)
 {
-    std::set<Dcel::Vertex*> garbage_vertex;      // array di vertici da eliminare a fine computazione
-
-    /**
-     * Scorro le facce da eliminare, e elimino gli half edge ad esse incidenti e le facce.
-     * Non elimino subito i vertici in quanto potrebbero essere condivisi tra più facce,
-     * ed è fondamentale che ogni vertice venga eliminato una sola volta.
-     */
-
-    for (std::set<Dcel::Face*>::const_iterator it=visibleFaces.begin(); it!=visibleFaces.end(); ++it){
-        Dcel::Face* f = *it;
+    std::vector<Dcel::Vertex*> garbageVertices;
+    orphanPoints.clear();
 
+    for (Dcel::Face* f : visibleFaces){
         Dcel::HalfEdge* e1 = f->outerHalfEdge();
         Dcel::HalfEdge* e2 = e1->next();
         Dcel::HalfEdge* e3 = e2->next();
-        Dcel::Vertex* v1 = e1->fromVertex();
-        Dcel::Vertex* v2 = e1->toVertex();
-        Dcel::Vertex* v3 = e2->toVertex();
-
-        /**
-         * Ogni volta che viene eliminato un elemento dalla DCEL, a tutti gli elementi dello stesso
-         * tipo con indice maggiore dell'elemento eliminato, viene decrementato l'indice.
-         * è quindi necessario, ogni volta che si elimina un elemento, è necessario aggiornare tutti
-         * gli indici che fanno riferimento ad oggetti dello stesso tipo nella DCEL, decrementandoli
-         * se hanno indice maggiore dell'indice dell'elemento eliminato.
-         */
-
-        /** eliminazione degli half_edge */
-        ch.deleteHalfEdge(e1);
+        Dcel::Vertex* v[3] = {e1->fromVertex(), e1->toVertex(), e2->toVertex()};
 
+        ch.deleteHalfEdge(e1);
         ch.deleteHalfEdge(e2);
-
         ch.deleteHalfEdge(e3);
 
-        /** eliminazione della faccia f */
-        cg.deleteRightNode(f->id());
+        std::vector<unsigned int>& conflicts = cc.facePoints[f->id()];
+        orphanPoints.insert(orphanPoints.end(), conflicts.begin(), conflicts.end());
+        conflicts.clear();
         ch.deleteFace(f);
-        /** Salvo i vertici da eliminare nell'array garbage_vertex */
-
-        if (horizonVertices.find(v1) == horizonVertices.end())
-            garbage_vertex.insert(v1);
-        if (horizonVertices.find(v2) == horizonVertices.end())
-            garbage_vertex.insert(v2);
-        if (horizonVertices.find(v3) == horizonVertices.end())
-            garbage_vertex.insert(v3);
+
+        //every vertex must be deleted once: garbage vertices are marked as the horizon ones
+        for (unsigned int i = 0; i < 3; i++){
+            cc.growVertices(v[i]->id());
+            if (cc.vertexMark[v[i]->id()] != cc.epoch){
+                cc.vertexMark[v[i]->id()] = cc.epoch;
+                garbageVertices.push_back(v[i]);
+            }
+        }
     }
 
-    /** Elimino i vertici */
-    for (std::set<Dcel::Vertex*>::iterator it = garbage_vertex.begin(); it != garbage_vertex.end(); ++it){
-        ch.deleteVertex(*it);
+    for (Dcel::Vertex* v : garbageVertices){
+        ch.deleteVertex(v);
     }
 }
 
-inline void insertNewFaces (Dcel & ch, std::vector<Dcel::HalfEdge*> & horizonEdges, const Point3d & p, BipartiteGraph<Point3d, unsigned int>& cg, std::vector<std::set<Point3d> >& P, int flagV)
+/**
+ * @brief Inserts the faces connecting the horizon edges with the new point p.
+ * The new faces are returned in newFaces.
+ */
+inline void insertNewFaces (Dcel & ch, std::vector<Dcel::HalfEdge*> & horizonEdges, const Point3d & p, std::vector<Dcel::Face*>& newFaces, int flagV)
 {
-    Dcel::Vertex* v3, *v1, *v2;                   // id di vertici della faccia inserita: v3 è SEMPRE l'id del nuovo punto inserito nel ch.
-    Dcel::HalfEdge* e1, *e2, *e3;                     // id degli half edge della faccia inserita: e1 è il twin dell'edge sull'orizzonte
-                                            //                                           e2 è il next di e1
-                                            //                                           e3 è il prev di e1
-    Dcel::HalfEdge* old_e2, *old_e3;                 // old_e2: e2 al passo precedente; old_e3: e3 al primo passo.
-    Dcel::Face* f;                              // id della faccia inserita
-
-    /**
-     * Una volta costruiti gli half edge, devono essere aggiustate le relazioni di twin.
-     * L'inserimeno delle facce è fatta in senso orario, quindi ad ogni passo si può collegare
-     * il prev di e1 (e3) col next di e1 al passo precedente (old_e2).
-     * Fa eccezione la prima faccia in quanto non vi è una faccia al passo precedente.
-     * Si salva quindi il prev di e1 della prima faccia (old_e3) e lo si collega al next di e1
-     * dell'ultima faccia (e2).
-     */
-
-    /** Inserisco il nuovo punto (v3) */
-    v3 = ch.addVertex(p); // inserisco il nuovo punto
+    Dcel::Vertex* v3, *v1, *v2;     // vertices of the new face: v3 is always the new point
+    Dcel::HalfEdge* e1, *e2, *e3;   // e1: twin of the horizon edge, e2: next of e1, e3: prev of e1
+    Dcel::HalfEdge* old_e2 = nullptr, *first_e3 = nullptr;
+    Dcel::Face* f;
+
+    newFaces.clear();
+    v3 = ch.addVertex(p);
     v3->setFlag(flagV);
 
-    /** Costruisco il primo  triangolo: */
-    Dcel::HalfEdge* externHalfEdge = horizonEdges[0]; // edge sull'orizzonte
-    /** Half Edge */
-    // e1:
-    v2 = externHalfEdge->fromVertex(); // v2: from di extern_he (to di e1!)
-    v1 = externHalfEdge->toVertex(); // v1: to di extern_he (from di e1!)
-    e1 = ch.addHalfEdge(); // e1: id half_edge twin di extern_he
-    e1->setFromVertex(v1);
-    e1->setToVertex(v2);
-
-    // e2:
-    e2 = ch.addHalfEdge(); // e2: id half_edge next di e1
-    e2->setFromVertex(v2);
-    e2->setToVertex(v3);
-
-    // e3:
-    e3 = ch.addHalfEdge(); // e3: id half_edge prev di e1
-    e3->setFromVertex(v3);
-    e3->setToVertex(v1);
-
-    old_e3=e3; // e3 sarà il twin di e2 dell'ultima faccia
-
-    // relazioni half_edge:
-    e1->setNext(e2);
-    e2->setNext(e3);
-    e3->setNext(e1);
-    e2->setPrev(e1);
-    e3->setPrev(e2);
-    e1->setPrev(e3);
-    horizonEdges[0]->setTwin(e1);
-    e1->setTwin(horizonEdges[0]);
-
-    // faccia
-    f = ch.addFace(); // f: id faccia inserita
-    f->setOuterHalfEdge(e1);
-    f->setColor(Color(128,128,128));
-
-    // half edge incident face
-    e1->setFace(f);
-    e2->setFace(f);
-    e3->setFace(f);
-
-    // vertex incident edge
-    v1->setIncidentHalfEdge(e1);
-    v2->setIncidentHalfEdge(e2);
-    v3->setIncidentHalfEdge(e3);
-
-    cg.addRightNode(f->id()); // aggiungo f al conflict_graph
-
-    /** CHECK VISIBILITà f */
-    for (const Point3d& point: P[0]){
-        if (isFaceVisible(f, point)){
-            cg.addArc(point, f->id());
-        }
-    }
+    //at every step, the twin of e3 is the e2 of the previous step
+    for (unsigned int i=0; i<horizonEdges.size(); i++){
+        Dcel::HalfEdge* externHalfEdge = horizonEdges[i];
+        v2 = externHalfEdge->fromVertex();
+        v1 = externHalfEdge->toVertex();
 
-    //ad ogni ciclo, il twin del nuovo e3 è il vecchio e2.
-    for (unsigned int i=1; i<horizonEdges.size(); i++){ // per ogni edge  sull'orizzonte
-        old_e2 = e2; // salvo e2 del passo precedente
-        externHalfEdge = horizonEdges[i]; // edge sull'orizzonte
-        /** Half Edge */
-        // e1:
-        v2 = externHalfEdge->fromVertex(); // v2: from di extern_he (to di e1!)
-        v1 = externHalfEdge->toVertex(); // v1: to di extern_he (from di e1!)
-        e1 = ch.addHalfEdge(); // e1: id half_edge twin di extern_he
+        e1 = ch.addHalfEdge();
         e1->setFromVertex(v1);
         e1->setToVertex(v2);
 
-        // e2:
-        e2 = ch.addHalfEdge(); // e2: id half_edge next di e1
+        e2 = ch.addHalfEdge();
         e2->setFromVertex(v2);
         e2->setToVertex(v3);
 
-        // e3:
-        e3 = ch.addHalfEdge(); // e3: id half_edge prev di e1
+        e3 = ch.addHalfEdge();
         e3->setFromVertex(v3);
         e3->setToVertex(v1);
 
-        // relazioni half edge:
-        // relazioni half_edge:
         e1->setNext(e2);
         e2->setNext(e3);
         e3->setNext(e1);
         e2->setPrev(e1);
         e3->setPrev(e2);
         e1->setPrev(e3);
-        horizonEdges[i]->setTwin(e1);
-        e1->setTwin(horizonEdges[i]);
-        e3->setTwin(old_e2);
-        old_e2->setTwin(e3);
+        externHalfEdge->setTwin(e1);
+        e1->setTwin(externHalfEdge);
+        if (i == 0){
+            first_e3 = e3;
+        }
+        else {
+            e3->setTwin(old_e2);
+            old_e2->setTwin(e3);
+        }
 
-        //faccia
-        f = ch.addFace(); // f: id faccia inserita
-        f->setColor(Color(128,128,128));
+        f = ch.addFace();
         f->setOuterHalfEdge(e1);
+        f->setColor(Color(128,128,128));
+        newFaces.push_back(f);
 
-        //half edge incident face
         e1->setFace(f);
         e2->setFace(f);
         e3->setFace(f);
 
-        // vertex incident edge
         v1->setIncidentHalfEdge(e1);
         v2->setIncidentHalfEdge(e2);
+        if (i == 0)
+            v3->setIncidentHalfEdge(e3);
 
-        cg.addRightNode(f->id());
-
-        /** CHECK VISIBILITà f */
-        for (const Point3d& point: P[i]){
-            if (isFaceVisible(f, point))
-                cg.addArc(point, f->id()); // se point vede f, aggiungo il conflitto nel conflict graph
-        }
-
+        old_e2 = e2;
     }
 
-    e2->setTwin(old_e3);
-    old_e3->setTwin(e2);
+    old_e2->setTwin(first_e3);
+    first_e3->setTwin(old_e2);
 }
 
 } //namespace cg3::internal
@@ -9,11 +9,16 @@
 #include <queue>
 #include <utility>
 #include <unordered_map>
+#include <algorithm>
+#include <stdexcept>
+#include <cstdint>
 
 #include "assert.h"
 
 #include "graph_algorithms.h"
 
+#include <cg3/utilities/bits.h>
+
 namespace cg3 {
 
 
@@ -110,6 +115,14 @@ GraphPath<T> getShortestPath(
         const std::vector<double>& dist,
         const std::vector<long long int>& pred);
 
+template <class T>
+GraphPath<T> getShortestPath(
+        const CompressedGraph<T>& graph,
+        const size_t& sourceIndex,
+        const size_t& destinationIndex,
+        const std::vector<double>& dist,
+        const std::vector<long long int>& pred);
+
 } //namespace internal
 
 
@@ -169,13 +182,9 @@ DijkstraResult<T> dijkstra(
 /**
  * @brief Execute Dijkstra algorithm given a cg3 graph and the source. It
  * computes the shortest path between the source and all the nodes of the graph.
+ * The algorithm runs on the compressed snapshot of the graph (Graph::freeze()).
  * @param[in] graph Input cg3 graph.
  * @param[in] sourceIt Source node iterator
- * @param[in] nodes List of ids of the nodes of the graph
- * @param[in] nodeAdjacencies Indexed adjacencies of each graph node (referring to the
- * indices of the vector "nodes")
- * @param[in] idMap Map to get the index of a node (referring to the indices of the vector
- * "nodes") given the id on the input cg3 graph
  * @return A map that associates all the graph nodes to the shortest path from the source
  * to that node. It contains structs which contain the path (a list of nodes) and a double
  * value which represents the cost of the path. The map is implemented using the std::map,
@@ -186,15 +195,10 @@ DijkstraResult<T> dijkstra(
         const Graph<T>& graph,
         const typename Graph<T>::iterator& sourceIt)
 {
-    //Vector of nodes and adjacencies
-    std::vector<size_t> nodes;
-    std::vector<std::vector<size_t>> nodeAdjacencies;
-    std::unordered_map<size_t, size_t> idMap;
-
-    //Fill indexed data needed to execute general purpose Dijkstra algorithm
-    fillIndexedData(graph, nodes, nodeAdjacencies, idMap);
+    //Compressed snapshot of the graph
+    CompressedGraph<T> compressed = graph.freeze();
 
-    return dijkstra(graph, sourceIt, nodes, nodeAdjacencies, idMap);
+    return dijkstra(compressed, compressed.getIndex(graph.getId(sourceIt)));
 }
 
 /**
@@ -336,6 +340,7 @@ GraphPath<T> dijkstra(
 /**
  * @brief Execute Dijkstra algorithm to get the shortest path from the source
  * to the destination, given a cg3 graph.
+ * The algorithm runs on the compressed snapshot of the graph (Graph::freeze()).
  * @param[in] graph Input cg3 graph.
  * @param[in] sourceIt Source node iterator
  * @param[in] destinationIt Destination node iterator
@@ -349,16 +354,13 @@ GraphPath<T> dijkstra(
         const typename Graph<T>::iterator& sourceIt,
         const typename Graph<T>::iterator& destinationIt)
 {
-    //Vector of nodes and adjacencies
-    std::vector<size_t> nodes;
-    std::vector<std::vector<size_t>> nodeAdjacencies;
-    std::unordered_map<size_t, size_t> idMap;
-
-
-    //Fill indexed data needed by general purpose Dijkstra algorithm
-    fillIndexedData(graph, nodes, nodeAdjacencies, idMap);
+    //Compressed snapshot of the graph
+    CompressedGraph<T> compressed = graph.freeze();
 
-    return dijkstra(graph, sourceIt, destinationIt, nodes, nodeAdjacencies, idMap);
+    return dijkstra(
+                compressed,
+                compressed.getIndex(graph.getId(sourceIt)),
+                compressed.getIndex(graph.getId(destinationIt)));
 }
 
 /**
@@ -401,6 +403,1091 @@ GraphPath<T> dijkstra(
 
 
 
+/* ----- IMPLEMENTATION FOR cg3::CompressedGraph ----- */
+
+/**
+ * @brief Dijkstra algorithm on the compressed sparse row form of a graph.
+ * Adjacencies and weights are read from the contiguous arrays of the graph.
+ * The current implementation has time complexity O(|E| + |V| log |V|).
+ * @param[in] graph Input compressed graph
+ * @param[in] sourceIndex Index of the source in the compressed graph
+ * @param[out] dist Vector of shortest path costs from the source to each node
+ * @param[out] pred Vector for predecessors to compute the path
+ */
+template <class T>
+void dijkstra(
+        const CompressedGraph<T>& graph,
+        const size_t sourceIndex,
+        std::vector<double>& dist,
+        std::vector<long long int>& pred)
+{
+    typedef std::pair<double, size_t> QueueObject;
+
+    size_t numberOfNodes = graph.numNodes();
+
+    dist.assign(numberOfNodes, CompressedGraph<T>::MAX_WEIGHT);
+    pred.assign(numberOfNodes, -1);
+
+    dist[sourceIndex] = 0;
+    pred[sourceIndex] = (long long int) sourceIndex;
+
+    const std::vector<size_t>& offsets = graph.getOffsets();
+    const std::vector<size_t>& targets = graph.getTargets();
+    const std::vector<double>& weights = graph.getWeights();
+
+    //Priority queue
+    std::priority_queue<QueueObject, std::vector<QueueObject>, std::greater<QueueObject>> queue;
+
+    queue.push(std::make_pair(0, sourceIndex));
+
+    while (!queue.empty()) {
+        double uDist = queue.top().first;
+        size_t uId = queue.top().second;
+
+        queue.pop();
+
+        //Skip outdated entries of the queue
+        if (uDist > dist[uId])
+            continue;
+
+        //For each adjacent node
+        for (size_t i = offsets[uId]; i < offsets[uId+1]; i++) {
+            size_t vId = targets[i];
+
+            //If there is short path to v through u.
+            if (dist[vId] > uDist + weights[i]) {
+                //Update distance of v
+                dist[vId] = uDist + weights[i];
+
+                //Set predecessor
+                pred[vId] = (long long int) uId;
+
+                //Add to the queue
+                queue.push(std::make_pair(dist[vId], vId));
+            }
+        }
+    }
+}
+
+/**
+ * @brief Execute Dijkstra algorithm given a compressed graph and the source. It
+ * computes the shortest path between the source and all the nodes of the graph.
+ * @param[in] graph Input compressed graph
+ * @param[in] sourceIndex Index of the source in the compressed graph
+ * @return A map that associates all the graph nodes to the shortest path from the source
+ * to that node. It contains structs which contain the path (a list of nodes) and a double
+ * value which represents the cost of the path.
+ */
+template <class T>
+DijkstraResult<T> dijkstra(
+        const CompressedGraph<T>& graph,
+        const size_t sourceIndex)
+{
+    //Vector of distances and predecessor of the shortest path from the source
+    std::vector<double> dist;
+    std::vector<long long int> pred;
+
+    //Execute Dijkstra
+    dijkstra(graph, sourceIndex, dist, pred);
+
+    //Result to be returned
+    DijkstraResult<T> resultMap;
+
+    //Update result map for each destination
+    for (size_t destinationIndex = 0; destinationIndex < graph.numNodes(); destinationIndex++) {
+        //If there is a path
+        if (pred[destinationIndex] != -1) {
+            GraphPath<T> graphPath = internal::getShortestPath(graph, sourceIndex, destinationIndex, dist, pred);
+
+            resultMap.insert(std::make_pair(graph.getValue(destinationIndex), graphPath));
+        }
+    }
+
+    return resultMap;
+}
+
+/**
+ * @brief Execute Dijkstra algorithm to get the shortest path from the source
+ * to the destination, given a compressed graph. The search stops when the
+ * destination is reached, and it uses the workspace of the calling thread.
+ * @param[in] graph Input compressed graph
+ * @param[in] sourceIndex Index of the source in the compressed graph
+ * @param[in] destinationIndex Index of the destination in the compressed graph
+ * @return A struct which contains the shortest path and its cost.
+ * If no path exists, then an empty path of MAX_WEIGHT cost is returned.
+ */
+template <class T>
+GraphPath<T> dijkstra(
+        const CompressedGraph<T>& graph,
+        const size_t sourceIndex,
+        const size_t destinationIndex)
+{
+    return dijkstra(graph, sourceIndex, destinationIndex, internal::threadShortestPathWorkspace());
+}
+
+
+
+/* ----- SHORTEST PATH QUERIES ON cg3::CompressedGraph ----- */
+
+namespace internal {
+
+template <class T>
+GraphPath<T> getShortestPath(
+        const CompressedGraph<T>& graph,
+        const ShortestPathSearch& search,
+        const size_t sourceIndex,
+        const size_t destinationIndex);
+
+template <class T>
+GraphPath<T> getShortestPath(
+        const CompressedGraph<T>& graph,
+        const ShortestPathSearch& forwardSearch,
+        const ShortestPathSearch& backwardSearch,
+        const size_t sourceIndex,
+        const size_t destinationIndex,
+        const size_t meetingIndex,
+        const double cost);
+
+template <class H>
+void expandShortestPathSearch(
+        const std::vector<size_t>& offsets,
+        const std::vector<size_t>& targets,
+        const std::vector<double>& weights,
+        ShortestPathSearch& search,
+        const size_t uId,
+        H heuristic);
+
+/**
+ * @brief Null heuristic, which makes A* equivalent to Dijkstra
+ */
+struct NullHeuristic {
+    double operator()(const size_t) const { return 0; }
+};
+
+/**
+ * @brief Euclidean distance from the destination, used as A* heuristic
+ * on graphs whose nodes are points
+ */
+template <class T>
+struct EuclideanHeuristic {
+    const CompressedGraph<T>& graph;
+    const T& destination;
+
+    EuclideanHeuristic(const CompressedGraph<T>& graph, const size_t destinationIndex) :
+        graph(graph), destination(graph.getValue(destinationIndex)) {}
+
+    double operator()(const size_t id) const {
+        return graph.getValue(id).dist(destination);
+    }
+};
+
+} //namespace cg3::internal
+
+
+/**
+ * @brief Execute Dijkstra algorithm to get the shortest path from the source
+ * to the destination, given a compressed graph. The search stops when the
+ * destination is reached.
+ * @param[in] graph Input compressed graph
+ * @param[in] sourceIndex Index of the source in the compressed graph
+ * @param[in] destinationIndex Index of the destination in the compressed graph
+ * @param[in] workspace Buffers of the query, reused between calls
+ * @return A struct which contains the shortest path and its cost.
+ * If no path exists, then an empty path of MAX_WEIGHT cost is returned.
+ */
+template <class T>
+GraphPath<T> dijkstra(
+        const CompressedGraph<T>& graph,
+        const size_t sourceIndex,
+        const size_t destinationIndex,
+        ShortestPathWorkspace& workspace)
+{
+    return aStar(graph, sourceIndex, destinationIndex, internal::NullHeuristic(), workspace);
+}
+
+/**
+ * @brief Execute a bidirectional Dijkstra algorithm to get the shortest path
+ * from the source to the destination, given an undirected compressed graph.
+ * It uses the workspace of the calling thread.
+ * @param[in] graph Input compressed graph, it must be undirected
+ * @param[in] sourceIndex Index of the source in the compressed graph
+ * @param[in] destinationIndex Index of the destination in the compressed graph
+ * @return A struct which contains the shortest path and its cost.
+ * If no path exists, then an empty path of MAX_WEIGHT cost is returned.
+ */
+template <class T>
+GraphPath<T> bidirectionalDijkstra(
+        const CompressedGraph<T>& graph,
+        const size_t sourceIndex,
+        const size_t destinationIndex)
+{
+    return bidirectionalDijkstra(graph, sourceIndex, destinationIndex, internal::threadShortestPathWorkspace());
+}
+
+/**
+ * @brief Execute a bidirectional Dijkstra algorithm to get the shortest path
+ * from the source to the destination, given an undirected compressed graph.
+ * @param[in] graph Input compressed graph, it must be undirected
+ * @param[in] sourceIndex Index of the source in the compressed graph
+ * @param[in] destinationIndex Index of the destination in the compressed graph
+ * @param[in] workspace Buffers of the query, reused between calls
+ * @return A struct which contains the shortest path and its cost.
+ * If no path exists, then an empty path of MAX_WEIGHT cost is returned.
+ */
+template <class T>
+GraphPath<T> bidirectionalDijkstra(
+        const CompressedGraph<T>& graph,
+        const size_t sourceIndex,
+        const size_t destinationIndex,
+        ShortestPathWorkspace& workspace)
+{
+    if (graph.isDirected())
+        throw std::runtime_error("The graph is directed. Please give the transposed graph.");
+
+    return bidirectionalDijkstra(graph, graph, sourceIndex, destinationIndex, workspace);
+}
+
+/**
+ * @brief Execute a bidirectional Dijkstra algorithm to get the shortest path
+ * from the source to the destination, given a compressed graph and its
+ * transposed graph. It uses the workspace of the calling thread.
+ * @param[in] graph Input compressed graph
+ * @param[in] transposedGraph Transposed graph (CompressedGraph::transpose())
+ * @param[in] sourceIndex Index of the source in the compressed graph
+ * @param[in] destinationIndex Index of the destination in the compressed graph
+ * @return A struct which contains the shortest path and its cost.
+ * If no path exists, then an empty path of MAX_WEIGHT cost is returned.
+ */
+template <class T>
+GraphPath<T> bidirectionalDijkstra(
+        const CompressedGraph<T>& graph,
+        const CompressedGraph<T>& transposedGraph,
+        const size_t sourceIndex,
+        const size_t destinationIndex)
+{
+    return bidirectionalDijkstra(graph, transposedGraph, sourceIndex, destinationIndex, internal::threadShortestPathWorkspace());
+}
+
+/**
+ * @brief Execute a bidirectional Dijkstra algorithm to get the shortest path
+ * from the source to the destination, given a compressed graph and its
+ * transposed graph.
+ *
+ * A forward search from the source and a backward search from the destination
+ * are alternated, expanding the one with the smaller minimum key. The search
+ * stops when the sum of the minimum keys is not lower than the best path found.
+ *
+ * @param[in] graph Input compressed graph
+ * @param[in] transposedGraph Transposed graph (CompressedGraph::transpose())
+ * @param[in] sourceIndex Index of the source in the compressed graph
+ * @param[in] destinationIndex Index of the destination in the compressed graph
+ * @param[in] workspace Buffers of the query, reused between calls
+ * @return A struct which contains the shortest path and its cost.
+ * If no path exists, then an empty path of MAX_WEIGHT cost is returned.
+ */
+template <class T>
+GraphPath<T> bidirectionalDijkstra(
+        const CompressedGraph<T>& graph,
+        const CompressedGraph<T>& transposedGraph,
+        const size_t sourceIndex,
+        const size_t destinationIndex,
+        ShortestPathWorkspace& workspace)
+{
+    const double MAX_WEIGHT = CompressedGraph<T>::MAX_WEIGHT;
+
+    internal::ShortestPathSearch& forward = workspace.forward;
+    internal::ShortestPathSearch& backward = workspace.backward;
+
+    workspace.resize(graph.numNodes());
+    forward.reset();
+    backward.reset();
+
+    forward.relax(sourceIndex, 0, 0, sourceIndex);
+    backward.relax(destinationIndex, 0, 0, destinationIndex);
+
+    //Best path found
+    double bestCost = MAX_WEIGHT;
+    size_t meetingIndex = CompressedGraph<T>::NO_INDEX;
+    if (sourceIndex == destinationIndex) {
+        bestCost = 0;
+        meetingIndex = sourceIndex;
+    }
+
+    while (!forward.emptyQueue() && !backward.emptyQueue() &&
+           forward.minKey() + backward.minKey() < bestCost)
+    {
+        //Expand the search with the smaller minimum key
+        bool isForward = forward.minKey() <= backward.minKey();
+        internal::ShortestPathSearch& search = isForward ? forward : backward;
+        const internal::ShortestPathSearch& otherSearch = isForward ? backward : forward;
+        const CompressedGraph<T>& searchGraph = isForward ? graph : transposedGraph;
+
+        const std::vector<size_t>& offsets = searchGraph.getOffsets();
+        const std::vector<size_t>& targets = searchGraph.getTargets();
+
+        size_t uId = search.popMin();
+
+        internal::expandShortestPathSearch(
+                    offsets, targets, searchGraph.getWeights(),
+                    search, uId, internal::NullHeuristic());
+
+        //Check the paths through the adjacent nodes reached by the other search
+        for (size_t i = offsets[uId]; i < offsets[uId+1]; i++) {
+            size_t vId = targets[i];
+            double otherDist = otherSearch.distance(vId);
+
+            if (otherDist < MAX_WEIGHT && search.distance(vId) + otherDist < bestCost) {
+                bestCost = search.distance(vId) + otherDist;
+                meetingIndex = vId;
+            }
+        }
+    }
+
+    return internal::getShortestPath(graph, forward, backward, sourceIndex, destinationIndex, meetingIndex, bestCost);
+}
+
+/**
+ * @brief Execute A* algorithm to get the shortest path from the source
+ * to the destination, given a compressed graph and a heuristic.
+ * It uses the workspace of the calling thread.
+ * @param[in] graph Input compressed graph
+ * @param[in] sourceIndex Index of the source in the compressed graph
+ * @param[in] destinationIndex Index of the destination in the compressed graph
+ * @param[in] heuristic Function returning a lower bound of the cost from a node
+ * (given its index) to the destination. It must be consistent.
+ * @return A struct which contains the shortest path and its cost.
+ * If no path exists, then an empty path of MAX_WEIGHT cost is returned.
+ */
+template <class T, class H>
+GraphPath<T> aStar(
+        const CompressedGraph<T>& graph,
+        const size_t sourceIndex,
+        const size_t destinationIndex,
+        H heuristic)
+{
+    return aStar(graph, sourceIndex, destinationIndex, heuristic, internal::threadShortestPathWorkspace());
+}
+
+/**
+ * @brief Execute A* algorithm to get the shortest path from the source
+ * to the destination, given a compressed graph and a heuristic.
+ * @param[in] graph Input compressed graph
+ * @param[in] sourceIndex Index of the source in the compressed graph
+ * @param[in] destinationIndex Index of the destination in the compressed graph
+ * @param[in] heuristic Function returning a lower bound of the cost from a node
+ * (given its index) to the destination. It must be consistent.
+ * @param[in] workspace Buffers of the query, reused between calls
+ * @return A struct which contains the shortest path and its cost.
+ * If no path exists, then an empty path of MAX_WEIGHT cost is returned.
+ */
+template <class T, class H>
+GraphPath<T> aStar(
+        const CompressedGraph<T>& graph,
+        const size_t sourceIndex,
+        const size_t destinationIndex,
+        H heuristic,
+        ShortestPathWorkspace& workspace)
+{
+    internal::ShortestPathSearch& search = workspace.forward;
+
+    workspace.resize(graph.numNodes());
+    search.reset();
+
+    search.relax(sourceIndex, 0, heuristic(sourceIndex), sourceIndex);
+
+    while (!search.emptyQueue()) {
+        size_t uId = search.popMin();
+
+        //Early exit: the distance of the destination is final
+        if (uId == destinationIndex)
+            break;
+
+        internal::expandShortestPathSearch(
+                    graph.getOffsets(), graph.getTargets(), graph.getWeights(),
+                    search, uId, heuristic);
+    }
+
+    return internal::getShortestPath(graph, search, sourceIndex, destinationIndex);
+}
+
+/**
+ * @brief Execute A* algorithm to get the shortest path from the source
+ * to the destination, given a compressed graph whose nodes are points.
+ * The heuristic is the euclidean distance from the destination, hence the
+ * weight of each edge must not be less than the distance between its nodes.
+ * It uses the workspace of the calling thread.
+ * @param[in] graph Input compressed graph
+ * @param[in] sourceIndex Index of the source in the compressed graph
+ * @param[in] destinationIndex Index of the destination in the compressed graph
+ * @return A struct which contains the shortest path and its cost.
+ * If no path exists, then an empty path of MAX_WEIGHT cost is returned.
+ */
+template <class T>
+GraphPath<T> aStar(
+        const CompressedGraph<T>& graph,
+        const size_t sourceIndex,
+        const size_t destinationIndex)
+{
+    return aStar(graph, sourceIndex, destinationIndex, internal::threadShortestPathWorkspace());
+}
+
+/**
+ * @brief Execute A* algorithm to get the shortest path from the source
+ * to the destination, given a compressed graph whose nodes are points.
+ * The heuristic is the euclidean distance from the destination, hence the
+ * weight of each edge must not be less than the distance between its nodes.
+ * @param[in] graph Input compressed graph
+ * @param[in] sourceIndex Index of the source in the compressed graph
+ * @param[in] destinationIndex Index of the destination in the compressed graph
+ * @param[in] workspace Buffers of the query, reused between calls
+ * @return A struct which contains the shortest path and its cost.
+ * If no path exists, then an empty path of MAX_WEIGHT cost is returned.
+ */
+template <class T>
+GraphPath<T> aStar(
+        const CompressedGraph<T>& graph,
+        const size_t sourceIndex,
+        const size_t destinationIndex,
+        ShortestPathWorkspace& workspace)
+{
+    return aStar(
+                graph, sourceIndex, destinationIndex,
+                internal::EuclideanHeuristic<T>(graph, destinationIndex),
+                workspace);
+}
+
+/**
+ * @brief Resize the buffers of the workspace. Nothing is reallocated
+ * if the number of nodes does not change.
+ * @param[in] numberOfNodes Number of nodes of the graph
+ */
+inline void ShortestPathWorkspace::resize(const size_t numberOfNodes)
+{
+    forward.resize(numberOfNodes);
+    backward.resize(numberOfNodes);
+}
+
+
+namespace internal {
+
+/**
+ * @brief Default constructor
+ */
+inline ShortestPathSearch::ShortestPathSearch() :
+    currentStamp(0)
+{
+
+}
+
+/**
+ * @brief Resize the search data. Nothing is reallocated if the number
+ * of nodes does not change.
+ * @param[in] numberOfNodes Number of nodes of the graph
+ */
+inline void ShortestPathSearch::resize(const size_t numberOfNodes)
+{
+    if (stamp.size() != numberOfNodes) {
+        dist.assign(numberOfNodes, 0);
+        pred.assign(numberOfNodes, 0);
+        heapPosition.assign(numberOfNodes, 0);
+        stamp.assign(numberOfNodes, 0);
+        heap.clear();
+        currentStamp = 0;
+    }
+}
+
+/**
+ * @brief Start a new query, invalidating the data of the previous one
+ */
+inline void ShortestPathSearch::reset()
+{
+    heap.clear();
+    currentStamp++;
+
+    //The stamps are cleared only on overflow
+    if (currentStamp == 0) {
+        std::fill(stamp.begin(), stamp.end(), 0);
+        currentStamp = 1;
+    }
+}
+
+/**
+ * @brief Get the distance of a node from the source
+ * @param[in] id Index of the node
+ * @return Distance, MAX_WEIGHT if the node has not been reached
+ */
+inline double ShortestPathSearch::distance(const size_t id) const
+{
+    //MAX_WEIGHT does not depend on the type of the nodes
+    if (stamp[id] != currentStamp)
+        return CompressedGraph<double>::MAX_WEIGHT;
+    return dist[id];
+}
+
+/**
+ * @brief Get the predecessor of a node in the shortest path
+ * @param[in] id Index of the node, it must have been reached
+ * @return Predecessor of the node, the source is its own predecessor
+ */
+inline size_t ShortestPathSearch::predecessor(const size_t id) const
+{
+    assert(stamp[id] == currentStamp);
+    return pred[id];
+}
+
+/**
+ * @brief Check if a node has been extracted from the queue
+ * @param[in] id Index of the node
+ * @return True if the distance of the node is final
+ */
+inline bool ShortestPathSearch::isSettled(const size_t id) const
+{
+    return stamp[id] == currentStamp && heapPosition[id] == SETTLED;
+}
+
+/**
+ * @brief Update the distance of a node if it is lower than the current one,
+ * inserting the node in the queue or decreasing its key
+ * @param[in] id Index of the node
+ * @param[in] newDist New distance of the node
+ * @param[in] key Key of the node in the queue
+ * @param[in] newPred Predecessor of the node
+ * @return True if the distance has been updated
+ */
+inline bool ShortestPathSearch::relax(const size_t id, const double newDist, const double key, const size_t newPred)
+{
+    if (stamp[id] != currentStamp) {
+        stamp[id] = currentStamp;
+        dist[id] = newDist;
+        pred[id] = newPred;
+
+        heapPosition[id] = heap.size();
+        heap.push_back(std::make_pair(key, id));
+        siftUp(heap.size() - 1);
+
+        return true;
+    }
+
+    if (newDist < dist[id] && heapPosition[id] != SETTLED) {
+        dist[id] = newDist;
+        pred[id] = newPred;
+
+        heap[heapPosition[id]].first = key;
+        siftUp(heapPosition[id]);
+
+        return true;
+    }
+
+    return false;
+}
+
+/**
+ * @brief Check if the queue is empty
+ * @return True if there are no nodes to be extracted
+ */
+inline bool ShortestPathSearch::emptyQueue() const
+{
+    return heap.empty();
+}
+
+/**
+ * @brief Get the minimum key of the queue
+ * @return Minimum key, the queue must not be empty
+ */
+inline double ShortestPathSearch::minKey() const
+{
+    return heap.front().first;
+}
+
+/**
+ * @brief Extract the node with the minimum key from the queue,
+ * setting it as settled
+ * @return Index of the node
+ */
+inline size_t ShortestPathSearch::popMin()
+{
+    size_t id = heap.front().second;
+    heapPosition[id] = SETTLED;
+
+    if (heap.size() > 1) {
+        heap.front() = heap.back();
+        heapPosition[heap.front().second] = 0;
+        heap.pop_back();
+        siftDown(0);
+    }
+    else {
+        heap.pop_back();
+    }
+
+    return id;
+}
+
+/**
+ * @brief Move up an entry of the heap until its parent has a lower key
+ * @param[in] pos Position of the entry
+ */
+inline void ShortestPathSearch::siftUp(size_t pos)
+{
+    std::pair<double, size_t> entry = heap[pos];
+
+    while (pos > 0) {
+        size_t parent = (pos - 1) / HEAP_ARITY;
+        if (heap[parent].first <= entry.first)
+            break;
+
+        heap[pos] = heap[parent];
+        heapPosition[heap[pos].second] = pos;
+        pos = parent;
+    }
+
+    heap[pos] = entry;
+    heapPosition[entry.second] = pos;
+}
+
+/**
+ * @brief Move down an entry of the heap until its children have greater keys
+ * @param[in] pos Position of the entry
+ */
+inline void ShortestPathSearch::siftDown(size_t pos)
+{
+    std::pair<double, size_t> entry = heap[pos];
+    const size_t size = heap.size();
+
+    while (true) {
+        size_t firstChild = pos * HEAP_ARITY + 1;
+        if (firstChild >= size)
+            break;
+
+        //Child with the minimum key
+        size_t lastChild = std::min(firstChild + HEAP_ARITY, size);
+        size_t minChild = firstChild;
+        for (size_t c = firstChild + 1; c < lastChild; c++) {
+            if (heap[c].first < heap[minChild].first)
+                minChild = c;
+        }
+
+        if (entry.first <= heap[minChild].first)
+            break;
+
+        heap[pos] = heap[minChild];
+        heapPosition[heap[pos].second] = pos;
+        pos = minChild;
+    }
+
+    heap[pos] = entry;
+    heapPosition[entry.second] = pos;
+}
+
+/**
+ * @brief Get the workspace for shortest path queries owned by the calling thread
+ * @return Workspace of the thread
+ */
+inline ShortestPathWorkspace& threadShortestPathWorkspace()
+{
+    static thread_local ShortestPathWorkspace workspace;
+    return workspace;
+}
+
+/**
+ * @brief Relax the edges leaving a settled node
+ * @param[in] offsets Offsets of the compressed graph
+ * @param[in] targets Targets of the compressed graph
+ * @param[in] weights Weights of the compressed graph
+ * @param[out] search Search data
+ * @param[in] uId Index of the settled node
+ * @param[in] heuristic Heuristic added to the distances to get the keys
+ */
+template <class H>
+inline void expandShortestPathSearch(
+        const std::vector<size_t>& offsets,
+        const std::vector<size_t>& targets,
+        const std::vector<double>& weights,
+        ShortestPathSearch& search,
+        const size_t uId,
+        H heuristic)
+{
+    double uDist = search.distance(uId);
+
+    for (size_t i = offsets[uId]; i < offsets[uId+1]; i++) {
+        size_t vId = targets[i];
+
+        if (!search.isSettled(vId)) {
+            double vDist = uDist + weights[i];
+
+            if (vDist < search.distance(vId)) {
+                search.relax(vId, vDist, vDist + heuristic(vId), uId);
+            }
+        }
+    }
+}
+
+/**
+ * @brief Get the shortest path of a single direction search
+ * @param[in] graph Input compressed graph
+ * @param[in] search Search data
+ * @param[in] sourceIndex Index of the source
+ * @param[in] destinationIndex Index of the destination
+ * @return Shortest path between source and destination
+ */
+template <class T>
+inline GraphPath<T> getShortestPath(
+        const CompressedGraph<T>& graph,
+        const ShortestPathSearch& search,
+        const size_t sourceIndex,
+        const size_t destinationIndex)
+{
+    GraphPath<T> graphPath;
+
+    graphPath.cost = search.distance(destinationIndex);
+
+    if (graphPath.cost < CompressedGraph<T>::MAX_WEIGHT) {
+        size_t idPred = destinationIndex;
+        while (idPred != sourceIndex) {
+            graphPath.path.push_front(graph.getValue(idPred));
+            idPred = search.predecessor(idPred);
+        }
+
+        graphPath.path.push_front(graph.getValue(sourceIndex));
+    }
+
+    return graphPath;
+}
+
+/**
+ * @brief Get the shortest path of a bidirectional search
+ * @param[in] graph Input compressed graph
+ * @param[in] forwardSearch Data of the search from the source
+ * @param[in] backwardSearch Data of the search from the destination
+ * @param[in] sourceIndex Index of the source
+ * @param[in] destinationIndex Index of the destination
+ * @param[in] meetingIndex Node of the shortest path reached by both the searches,
+ * NO_INDEX if there is no path
+ * @param[in] cost Cost of the shortest path
+ * @return Shortest path between source and destination
+ */
+template <class T>
+inline GraphPath<T> getShortestPath(
+        const CompressedGraph<T>& graph,
+        const ShortestPathSearch& forwardSearch,
+        const ShortestPathSearch& backwardSearch,
+        const size_t sourceIndex,
+        const size_t destinationIndex,
+        const size_t meetingIndex,
+        const double cost)
+{
+    GraphPath<T> graphPath;
+
+    graphPath.cost = cost;
+
+    if (meetingIndex != CompressedGraph<T>::NO_INDEX) {
+        //From the meeting node to the source
+        size_t idPred = meetingIndex;
+        while (idPred != sourceIndex) {
+            graphPath.path.push_front(graph.getValue(idPred));
+            idPred = forwardSearch.predecessor(idPred);
+        }
+        graphPath.path.push_front(graph.getValue(sourceIndex));
+
+        //From the meeting node to the destination
+        size_t idSucc = meetingIndex;
+        while (idSucc != destinationIndex) {
+            idSucc = backwardSearch.predecessor(idSucc);
+            graphPath.path.push_back(graph.getValue(idSucc));
+        }
+    }
+
+    return graphPath;
+}
+
+} //namespace cg3::internal
+
+
+
+/* ----- PARALLEL ALGORITHMS ON cg3::CompressedGraph ----- */
+
+namespace internal {
+
+template <class T>
+size_t connectedComponentsPropagationStep(
+        const CompressedGraph<T>& graph,
+        const CompressedGraph<T>& transposedGraph,
+        const std::vector<size_t>& labels,
+        std::vector<size_t>& newLabels);
+
+} //namespace cg3::internal
+
+/**
+ * @brief Execute Dijkstra algorithm from several sources. The sources are
+ * distributed among the threads, each one using its own workspace.
+ * @param[in] graph Input compressed graph
+ * @param[in] sourceIndices Indices of the sources in the compressed graph
+ * @param[out] dist For each source, vector of shortest path costs from the
+ * source to each node (MAX_WEIGHT if the node cannot be reached)
+ */
+template <class T>
+void batchDijkstra(
+        const CompressedGraph<T>& graph,
+        const std::vector<size_t>& sourceIndices,
+        std::vector<std::vector<double>>& dist)
+{
+    const size_t numberOfNodes = graph.numNodes();
+    const long long int numberOfSources = (long long int) sourceIndices.size();
+
+    dist.resize(sourceIndices.size());
+
+    #pragma omp parallel for schedule(dynamic)
+    for (long long int i = 0; i < numberOfSources; i++) {
+        ShortestPathWorkspace& workspace = internal::threadShortestPathWorkspace();
+        internal::ShortestPathSearch& search = workspace.forward;
+
+        workspace.resize(numberOfNodes);
+        search.reset();
+
+        //Full expansion from the source
+        search.relax(sourceIndices[i], 0, 0, sourceIndices[i]);
+        while (!search.emptyQueue()) {
+            size_t uId = search.popMin();
+
+            internal::expandShortestPathSearch(
+                        graph.getOffsets(), graph.getTargets(), graph.getWeights(),
+                        search, uId, internal::NullHeuristic());
+        }
+
+        std::vector<double>& sourceDist = dist[i];
+        sourceDist.resize(numberOfNodes);
+        for (size_t vId = 0; vId < numberOfNodes; vId++) {
+            sourceDist[vId] = search.distance(vId);
+        }
+    }
+}
+
+/**
+ * @brief Parallel breadth-first search from a source.
+ *
+ * The search is level-synchronous: the frontier and the visited nodes
+ * are bitmaps. Each level is expanded top-down from the frontier words,
+ * in parallel; on undirected graphs, when the frontier is large, the level
+ * is expanded bottom-up, in which each unvisited node looks for a parent
+ * in the frontier.
+ *
+ * @param[in] graph Input compressed graph
+ * @param[in] sourceIndex Index of the source in the compressed graph
+ * @param[out] depth Number of edges of the shortest path from the source
+ * to each node, -1 if the node cannot be reached
+ */
+template <class T>
+void bfs(
+        const CompressedGraph<T>& graph,
+        const size_t sourceIndex,
+        std::vector<long long int>& depth)
+{
+    //Frontier size (with respect to the number of nodes) for bottom-up levels
+    static const size_t BOTTOM_UP_RATIO = 20;
+
+    const size_t numberOfNodes = graph.numNodes();
+    const long long int numberOfWords = (long long int) ((numberOfNodes + 63) / 64);
+
+    const std::vector<size_t>& offsets = graph.getOffsets();
+    const std::vector<size_t>& targets = graph.getTargets();
+
+    depth.assign(numberOfNodes, -1);
+
+    std::vector<uint64_t> visited(numberOfWords, 0);
+    std::vector<uint64_t> frontier(numberOfWords, 0);
+    std::vector<uint64_t> nextFrontier(numberOfWords, 0);
+
+    depth[sourceIndex] = 0;
+    visited[sourceIndex >> 6] |= (uint64_t) 1 << (sourceIndex & 63);
+    frontier[sourceIndex >> 6] |= (uint64_t) 1 << (sourceIndex & 63);
+
+    size_t frontierSize = 1;
+    long long int level = 0;
+
+    while (frontierSize > 0) {
+        size_t nextFrontierSize = 0;
+        std::fill(nextFrontier.begin(), nextFrontier.end(), 0);
+
+        if (!graph.isDirected() && frontierSize * BOTTOM_UP_RATIO > numberOfNodes) {
+            //Bottom-up: each unvisited node looks for an adjacent node in the frontier
+            #pragma omp parallel for schedule(dynamic, 16) reduction(+:nextFrontierSize)
+            for (long long int w = 0; w < numberOfWords; w++) {
+                uint64_t word = 0;
+                uint64_t unvisited = ~visited[w];
+                if (w == numberOfWords - 1 && (numberOfNodes & 63) != 0)
+                    unvisited &= lowBitsMask64(numberOfNodes & 63);
+
+                while (unvisited != 0) {
+                    unsigned int bit = countTrailingZeros64(unvisited);
+                    unvisited &= unvisited - 1;
+
+                    size_t uId = (size_t) w * 64 + bit;
+                    for (size_t i = offsets[uId]; i < offsets[uId+1]; i++) {
+                        size_t vId = targets[i];
+                        if (frontier[vId >> 6] & ((uint64_t) 1 << (vId & 63))) {
+                            depth[uId] = level + 1;
+                            word |= (uint64_t) 1 << bit;
+                            nextFrontierSize++;
+                            break;
+                        }
+                    }
+                }
+
+                nextFrontier[w] = word;
+                visited[w] |= word;
+            }
+        }
+        else {
+            //Top-down: the nodes of the frontier visit their adjacent nodes
+            #pragma omp parallel for schedule(dynamic, 16) reduction(+:nextFrontierSize)
+            for (long long int w = 0; w < numberOfWords; w++) {
+                uint64_t word = frontier[w];
+
+                while (word != 0) {
+                    size_t uId = (size_t) w * 64 + countTrailingZeros64(word);
+                    word &= word - 1;
+
+                    for (size_t i = offsets[uId]; i < offsets[uId+1]; i++) {
+                        size_t vId = targets[i];
+                        uint64_t mask = (uint64_t) 1 << (vId & 63);
+                        uint64_t oldWord;
+
+                        #pragma omp atomic capture
+                        { oldWord = visited[vId >> 6]; visited[vId >> 6] |= mask; }
+
+                        //The node is visited by the thread which set its bit
+                        if ((oldWord & mask) == 0) {
+                            depth[vId] = level + 1;
+
+                            #pragma omp atomic
+                            nextFrontier[vId >> 6] |= mask;
+
+                            nextFrontierSize++;
+                        }
+                    }
+                }
+            }
+        }
+
+        frontier.swap(nextFrontier);
+        frontierSize = nextFrontierSize;
+        level++;
+    }
+}
+
+/**
+ * @brief Parallel computation of the connected components of a graph
+ * (weakly connected components if the graph is directed).
+ *
+ * Each node starts with its own index as label; at each iteration every node
+ * takes in parallel the minimum label among its own and the ones of its adjacent
+ * nodes, followed by a pointer jumping step. Directed graphs are transposed to
+ * follow also the incoming edges.
+ *
+ * @param[in] graph Input compressed graph
+ * @param[out] componentLabels Label of the component of each node, from 0 to
+ * the number of components - 1, ordered by the minimum index of their nodes
+ * @return Number of connected components
+ */
+template <class T>
+size_t connectedComponents(
+        const CompressedGraph<T>& graph,
+        std::vector<size_t>& componentLabels)
+{
+    const size_t numberOfNodes = graph.numNodes();
+    const long long int n = (long long int) numberOfNodes;
+
+    CompressedGraph<T> transposedGraph;
+    if (graph.isDirected())
+        transposedGraph = graph.transpose();
+
+    std::vector<size_t> labels(numberOfNodes);
+    std::vector<size_t> newLabels(numberOfNodes);
+    for (size_t i = 0; i < numberOfNodes; i++)
+        labels[i] = i;
+
+    size_t changes;
+    do {
+        //Minimum label of the adjacent nodes
+        changes = internal::connectedComponentsPropagationStep(graph, transposedGraph, labels, newLabels);
+
+        //Pointer jumping: labels are indices of nodes in the same component
+        #pragma omp parallel for reduction(+:changes)
+        for (long long int i = 0; i < n; i++) {
+            labels[i] = newLabels[newLabels[i]];
+            if (labels[i] != newLabels[i])
+                changes++;
+        }
+    } while (changes > 0);
+
+    //Label each component with the number of components with a lower minimum node
+    std::vector<size_t> componentMap(numberOfNodes, 0);
+    size_t numberOfComponents = 0;
+    for (size_t i = 0; i < numberOfNodes; i++) {
+        if (labels[i] == i) {
+            componentMap[i] = numberOfComponents;
+            numberOfComponents++;
+        }
+    }
+
+    componentLabels.resize(numberOfNodes);
+
+    #pragma omp parallel for
+    for (long long int i = 0; i < n; i++) {
+        componentLabels[i] = componentMap[labels[i]];
+    }
+
+    return numberOfComponents;
+}
+
+
+namespace internal {
+
+/**
+ * @brief Propagation step of the connected components: every node takes the
+ * minimum label among its own and the ones of its adjacent nodes
+ * @param[in] graph Input compressed graph
+ * @param[in] transposedGraph Transposed graph, empty if the graph is undirected
+ * @param[in] labels Current labels
+ * @param[out] newLabels Labels after the propagation
+ * @return Number of labels which have been changed
+ */
+template <class T>
+inline size_t connectedComponentsPropagationStep(
+        const CompressedGraph<T>& graph,
+        const CompressedGraph<T>& transposedGraph,
+        const std::vector<size_t>& labels,
+        std::vector<size_t>& newLabels)
+{
+    const long long int n = (long long int) labels.size();
+    const bool useTransposed = transposedGraph.numNodes() > 0;
+
+    size_t changes = 0;
+
+    #pragma omp parallel for schedule(dynamic, 256) reduction(+:changes)
+    for (long long int i = 0; i < n; i++) {
+        size_t minLabel = labels[i];
+
+        for (const size_t* it = graph.adjacentBegin(i); it != graph.adjacentEnd(i); ++it) {
+            minLabel = std::min(minLabel, labels[*it]);
+        }
+        if (useTransposed) {
+            for (const size_t* it = transposedGraph.adjacentBegin(i); it != transposedGraph.adjacentEnd(i); ++it) {
+                minLabel = std::min(minLabel, labels[*it]);
+            }
+        }
+
+        newLabels[i] = minLabel;
+        if (minLabel != labels[i])
+            changes++;
+    }
+
+    return changes;
+}
+
+} //namespace cg3::internal
+
+
+
 /**
  * @brief Fill indexed data structure needed by the Dijkstra algorithm for a cg3 graph.
  * @param[in] graph Input cg3 graph
@@ -509,6 +1596,47 @@ inline GraphPath<T> getShortestPath(
     return graphPath;
 }
 
+/**
+ * @brief Get the resulting shortest path in the compressed graph, given the raw
+ * Dijkstra data, given a source and a destination
+ * @param[in] graph Input compressed graph
+ * @param[in] sourceIndex Index of the source in the compressed graph
+ * @param[in] destinationIndex Index of the destination in the compressed graph
+ * @param[in] dist Vector of shortest path costs from the source to each node
+ * @param[in] pred Vector for predecessors to compute the path
+ * @return Shortest path between source and destination
+ */
+template <class T>
+inline GraphPath<T> getShortestPath(
+        const CompressedGraph<T>& graph,
+        const size_t& sourceIndex,
+        const size_t& destinationIndex,
+        const std::vector<double>& dist,
+        const std::vector<long long int>& pred)
+{
+    //Result graph path
+    GraphPath<T> graphPath;
+
+    //Get the shortest path
+    if (pred[destinationIndex] != -1) {
+        //Create path
+        size_t idPred = destinationIndex;
+        while (idPred != sourceIndex) {
+            graphPath.path.push_front(graph.getValue(idPred));
+
+            assert(pred[idPred] >= 0);
+
+            idPred = (size_t) pred[idPred];
+        }
+
+        graphPath.path.push_front(graph.getValue(sourceIndex));
+    }
+
+    graphPath.cost = dist[destinationIndex];
+
+    return graphPath;
+}
+
 
 } //namespace internal
 
@@ -11,6 +11,8 @@
 
 #include <map>
 #include <list>
+#include <vector>
+#include <limits>
 
 #include <cg3/data_structures/graphs/graph.h>
 
@@ -106,6 +108,183 @@ GraphPath<T> dijkstra(
         const std::unordered_map<size_t, size_t>& idMap);
 
 
+/* Implementation for cg3::CompressedGraph */
+
+template <class T>
+void dijkstra(
+        const CompressedGraph<T>& graph,
+        const size_t sourceIndex,
+        std::vector<double>& dist,
+        std::vector<long long int>& pred);
+
+template <class T>
+DijkstraResult<T> dijkstra(
+        const CompressedGraph<T>& graph,
+        const size_t sourceIndex);
+
+template <class T>
+GraphPath<T> dijkstra(
+        const CompressedGraph<T>& graph,
+        const size_t sourceIndex,
+        const size_t destinationIndex);
+
+
+/* Shortest path queries on cg3::CompressedGraph */
+
+namespace internal {
+
+/**
+ * @brief Data of a single search direction of a shortest path query:
+ * distances, predecessors and an indexed 4-ary heap with decrease-key.
+ *
+ * The entries of a node are valid only if its stamp is equal to the
+ * current one, hence the data is reset in constant time between queries
+ * and it is never reallocated if the number of nodes does not change.
+ */
+class ShortestPathSearch
+{
+public:
+
+    ShortestPathSearch();
+
+    void resize(const size_t numberOfNodes);
+    void reset();
+
+    double distance(const size_t id) const;
+    size_t predecessor(const size_t id) const;
+    bool isSettled(const size_t id) const;
+
+    bool relax(const size_t id, const double dist, const double key, const size_t pred);
+
+    bool emptyQueue() const;
+    double minKey() const;
+    size_t popMin();
+
+private:
+
+    static const size_t HEAP_ARITY = 4;
+    static const size_t SETTLED = std::numeric_limits<size_t>::max();
+
+    void siftUp(size_t pos);
+    void siftDown(size_t pos);
+
+    std::vector<double> dist; //Distance of each node from the source
+    std::vector<size_t> pred; //Predecessor of each node
+    std::vector<size_t> heapPosition; //Position of each node in the heap, SETTLED if extracted
+    std::vector<unsigned int> stamp; //Query in which the node has been reached
+
+    std::vector<std::pair<double, size_t>> heap; //Keys and nodes
+
+    unsigned int currentStamp;
+};
+
+} //namespace cg3::internal
+
+/**
+ * @brief Reusable buffers for shortest path queries on a CompressedGraph.
+ *
+ * Keep a workspace for each thread executing queries: the functions that
+ * do not take a workspace use one owned by the calling thread.
+ */
+class ShortestPathWorkspace
+{
+public:
+    void resize(const size_t numberOfNodes);
+
+    internal::ShortestPathSearch forward;
+    internal::ShortestPathSearch backward;
+};
+
+namespace internal {
+
+inline ShortestPathWorkspace& threadShortestPathWorkspace();
+
+} //namespace cg3::internal
+
+template <class T>
+GraphPath<T> dijkstra(
+        const CompressedGraph<T>& graph,
+        const size_t sourceIndex,
+        const size_t destinationIndex,
+        ShortestPathWorkspace& workspace);
+
+template <class T>
+GraphPath<T> bidirectionalDijkstra(
+        const CompressedGraph<T>& graph,
+        const size_t sourceIndex,
+        const size_t destinationIndex);
+
+template <class T>
+GraphPath<T> bidirectionalDijkstra(
+        const CompressedGraph<T>& graph,
+        const size_t sourceIndex,
+        const size_t destinationIndex,
+        ShortestPathWorkspace& workspace);
+
+template <class T>
+GraphPath<T> bidirectionalDijkstra(
+        const CompressedGraph<T>& graph,
+        const CompressedGraph<T>& transposedGraph,
+        const size_t sourceIndex,
+        const size_t destinationIndex);
+
+template <class T>
+GraphPath<T> bidirectionalDijkstra(
+        const CompressedGraph<T>& graph,
+        const CompressedGraph<T>& transposedGraph,
+        const size_t sourceIndex,
+        const size_t destinationIndex,
+        ShortestPathWorkspace& workspace);
+
+template <class T, class H>
+GraphPath<T> aStar(
+        const CompressedGraph<T>& graph,
+        const size_t sourceIndex,
+        const size_t destinationIndex,
+        H heuristic);
+
+template <class T, class H>
+GraphPath<T> aStar(
+        const CompressedGraph<T>& graph,
+        const size_t sourceIndex,
+        const size_t destinationIndex,
+        H heuristic,
+        ShortestPathWorkspace& workspace);
+
+template <class T>
+GraphPath<T> aStar(
+        const CompressedGraph<T>& graph,
+        const size_t sourceIndex,
+        const size_t destinationIndex);
+
+template <class T>
+GraphPath<T> aStar(
+        const CompressedGraph<T>& graph,
+        const size_t sourceIndex,
+        const size_t destinationIndex,
+        ShortestPathWorkspace& workspace);
+
+
+/* Parallel algorithms on cg3::CompressedGraph */
+
+template <class T>
+void batchDijkstra(
+        const CompressedGraph<T>& graph,
+        const std::vector<size_t>& sourceIndices,
+        std::vector<std::vector<double>>& dist);
+
+template <class T>
+void bfs(
+        const CompressedGraph<T>& graph,
+        const size_t sourceIndex,
+        std::vector<long long int>& depth);
+
+template <class T>
+size_t connectedComponents(
+        const CompressedGraph<T>& graph,
+        std::vector<size_t>& componentLabels);
+
+
 template <class T>
 void fillIndexedData(
         const Graph<T>& graph,
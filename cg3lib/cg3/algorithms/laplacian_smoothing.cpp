@@ -7,34 +7,93 @@
 #include "laplacian_smoothing.h"
 #include <cg3/meshes/dcel/dcel.h>
 
+#include <vector>
+#include <algorithm>
+
 namespace cg3 {
 
 /**
  * @brief Computes nIt iterations of laplacian smoothing on the mesh
+ *
+ * The vertex adjacency is extracted once in compressed sparse row form, then
+ * the iterations (Jacobi style: every new position depends only on the positions
+ * of the previous iteration) are computed in parallel on flat arrays of
+ * coordinates, swapping two buffers at each iteration. The mesh is updated
+ * only at the end.
+ *
  * @param [in/out] mesh: mesh on which the smoothing will be applied
  * @param [in] nIt: number of iterations
  */
-void laplacianSmoothing(cg3::Dcel& mesh, unsigned int nIt)
+CG3_INLINE void laplacianSmoothing(cg3::Dcel& mesh, unsigned int nIt)
 {
-	std::map<uint, cg3::Point3d> mapCoords;
-
-	for (uint i = 0; i < nIt; ++i){
-		for (const cg3::Dcel::Vertex* v : mesh.vertexIterator()){
-			cg3::Point3d avg;
-			uint n = 0;
-			for (const cg3::Dcel::Vertex* adj : v->adjacentVertexIterator()){
-				avg += adj->coordinate();
-				n++;
-			}
-			if (n > 0){
-				avg /= n;
-				mapCoords[v->id()] = avg;
+	//compact index of every vertex
+	std::vector<cg3::Dcel::Vertex*> vertices;
+	vertices.reserve(mesh.numberVertices());
+	uint maxId = 0;
+	for (cg3::Dcel::Vertex* v : mesh.vertexIterator()){
+		vertices.push_back(v);
+		maxId = std::max(maxId, v->id());
+	}
+	const long long int nVertices = vertices.size();
+	std::vector<uint> index(nVertices > 0 ? maxId + 1 : 0);
+	for (long long int i = 0; i < nVertices; i++)
+		index[vertices[i]->id()] = i;
+
+	//adjacency in CSR form
+	std::vector<uint> offsets(nVertices + 1, 0);
+	std::vector<uint> adjacents;
+	adjacents.reserve(mesh.numberHalfEdges());
+	for (long long int i = 0; i < nVertices; i++){
+		for (const cg3::Dcel::Vertex* adj : vertices[i]->adjacentVertexIterator())
+			adjacents.push_back(index[adj->id()]);
+		offsets[i+1] = adjacents.size();
+	}
+
+	//coordinates as structure of arrays, double buffered
+	std::vector<double> x(nVertices), y(nVertices), z(nVertices);
+	for (long long int i = 0; i < nVertices; i++){
+		const cg3::Point3d& p = vertices[i]->coordinate();
+		x[i] = p.x();
+		y[i] = p.y();
+		z[i] = p.z();
+	}
+	std::vector<double> nx(x), ny(y), nz(z);
+
+	const uint* off = offsets.data();
+	const uint* adj = adjacents.data();
+	for (uint it = 0; it < nIt; ++it){
+		const double* cx = x.data();
+		const double* cy = y.data();
+		const double* cz = z.data();
+		double* ox = nx.data();
+		double* oy = ny.data();
+		double* oz = nz.data();
+
+		#pragma omp parallel for schedule(static)
+		for (long long int i = 0; i < nVertices; i++){
+			const uint begin = off[i], end = off[i+1];
+			if (begin == end)
+				continue;
+			double sx = 0, sy = 0, sz = 0;
+			for (uint k = begin; k < end; ++k){
+				const uint a = adj[k];
+				sx += cx[a];
+				sy += cy[a];
+				sz += cz[a];
 			}
+			const double inv = 1.0 / (end - begin);
+			ox[i] = sx * inv;
+			oy[i] = sy * inv;
+			oz[i] = sz * inv;
 		}
-		for (const std::pair<uint, cg3::Point3d>& p : mapCoords){
-			mesh.vertex(p.first)->setCoordinate(p.second);
-		}
+		x.swap(nx);
+		y.swap(ny);
+		z.swap(nz);
 	}
+
+	for (long long int i = 0; i < nVertices; i++)
+		vertices[i]->setCoordinate(cg3::Point3d(x[i], y[i], z[i]));
+
 	mesh.updateFaceNormals();
 	mesh.updateFaceAreas();
 	mesh.updateVertexNormals();
@@ -47,7 +106,7 @@ void laplacianSmoothing(cg3::Dcel& mesh, unsigned int nIt)
  * @param [in] nIt: number of iterations
  * @return a mesh with the smoothing applied
  */
-Dcel laplacianSmoothing(const Dcel& mesh, unsigned int nIt)
+CG3_INLINE Dcel laplacianSmoothing(const Dcel& mesh, unsigned int nIt)
 {
 	cg3::Dcel output = mesh;
 	laplacianSmoothing(output, nIt);
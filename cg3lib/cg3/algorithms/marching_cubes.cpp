@@ -9,6 +9,8 @@
 
 #include <cg3/data_structures/arrays/arrays.h>
 
+#include <algorithm>
+
 namespace cg3 {
 
 namespace internal {
@@ -272,62 +274,411 @@ static const Array2D<int> triTable = {
     {-1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1}    //255
 };
 
-cg3::Point3d edgeCoordinate(const cg3::RegularLattice3D<bool>& l, uint i, uint j, uint k, uint edge){
-	switch (edge) {
-	case 0:  return (l.vertex(i,  j,  k  ) + l.vertex(i+1,j,  k  )) * 0.5;
-	case 1:  return (l.vertex(i+1,j,  k  ) + l.vertex(i+1,j+1,k  )) * 0.5;
-	case 2:  return (l.vertex(i+1,j+1,k  ) + l.vertex(i,  j+1,k  )) * 0.5;
-	case 3:  return (l.vertex(i,  j+1,k  ) + l.vertex(i,  j,  k  )) * 0.5;
-
-	case 4:  return (l.vertex(i,  j,  k+1) + l.vertex(i+1,j,  k+1)) * 0.5;
-	case 5:  return (l.vertex(i+1,j,  k+1) + l.vertex(i+1,j+1,k+1)) * 0.5;
-	case 6:  return (l.vertex(i+1,j+1,k+1) + l.vertex(i,  j+1,k+1)) * 0.5;
-	case 7:  return (l.vertex(i,  j+1,k+1) + l.vertex(i,  j,  k+1)) * 0.5;
-
-	case 8:  return (l.vertex(i,  j,  k  ) + l.vertex(i,  j,  k+1)) * 0.5;
-	case 9:  return (l.vertex(i+1,j,  k  ) + l.vertex(i+1,j,  k+1)) * 0.5;
-	case 10: return (l.vertex(i+1,j+1,k  ) + l.vertex(i+1,j+1,k+1)) * 0.5;
-	case 11: return (l.vertex(i,  j+1,k  ) + l.vertex(i,  j+1,k+1)) * 0.5;
-
-	default:
-		assert(0);
-		return cg3::Point3d();
-	}
+/**
+ * @brief Position of the 12 edges of a cube with respect to its minimum corner (i,j,k):
+ * for every edge, the offsets (di, dj, dk) of the lattice vertex that owns it
+ * and its axis (0 = x, 1 = y, 2 = z).
+ */
+static const int cubeEdges[12][4] = {
+    {0, 0, 0, 0}, {1, 0, 0, 1}, {0, 1, 0, 0}, {0, 0, 0, 1},
+    {0, 0, 1, 0}, {1, 0, 1, 1}, {0, 1, 1, 0}, {0, 0, 1, 1},
+    {0, 0, 0, 2}, {1, 0, 0, 2}, {1, 1, 0, 2}, {0, 1, 0, 2}
+};
+
+/**
+ * @brief Scalar field of a boolean lattice (cg3::RegularLattice3D or
+ * cg3::SparseRegularLattice3D): a vertex is inside if its property is true,
+ * and the surface crosses the edges in their midpoints.
+ */
+template <class Lattice>
+class BoolLatticeField
+{
+public:
+    BoolLatticeField(const Lattice& l) : l(l) {}
+
+    bool inside(uint i, uint j, uint k) const
+    {
+        return l.vertexProperty(i, j, k);
+    }
+
+    cg3::Point3d edgePoint(uint i, uint j, uint k, uint i2, uint j2, uint k2) const
+    {
+        return (l.vertex(i, j, k) + l.vertex(i2, j2, k2)) * 0.5;
+    }
+
+private:
+    const Lattice& l;
+};
+
+/**
+ * @brief Scalar field of a numeric lattice: a vertex is inside if its value is less
+ * than the iso value, and the surface point on an edge is linearly interpolated.
+ */
+template <class Lattice>
+class ScalarLatticeField
+{
+public:
+    ScalarLatticeField(const Lattice& l, double isoValue) :
+        l(l),
+        isoValue(isoValue)
+    {
+    }
+
+    bool inside(uint i, uint j, uint k) const
+    {
+        return (double) l.vertexProperty(i, j, k) < isoValue;
+    }
+
+    cg3::Point3d edgePoint(uint i, uint j, uint k, uint i2, uint j2, uint k2) const
+    {
+        double v1 = l.vertexProperty(i, j, k);
+        double v2 = l.vertexProperty(i2, j2, k2);
+        double t = v1 == v2 ? 0.5 : (isoValue - v1) / (v2 - v1);
+        cg3::Point3d p1 = l.vertex(i, j, k);
+        return p1 + (l.vertex(i2, j2, k2) - p1) * t;
+    }
+
+private:
+    const Lattice& l;
+    double isoValue;
+};
+
+typedef std::vector<std::pair<uint, uint>> MarchingCubesRuns;
+
+/**
+ * @brief Ranges of a dense lattice that must be visited by marching cubes: all the rows,
+ * entirely.
+ */
+class DenseLatticeRuns
+{
+public:
+    DenseLatticeRuns(uint resZ) : resZ(resZ) {}
+
+    void rowRuns(uint, uint, MarchingCubesRuns& runs) const
+    {
+        runs.assign(1, std::make_pair(0u, resZ));
+    }
+
+private:
+    uint resZ;
+};
+
+/**
+ * @brief Ranges of a sparse lattice that must be visited by marching cubes.
+ *
+ * The surface may cross only cubes and edges having at least a vertex in an active
+ * block, since all the other vertices have the same (background) value. The sorted
+ * lists of the active blocks of every column of blocks along z are computed once.
+ */
+class SparseLatticeRuns
+{
+public:
+    template <class VT>
+    SparseLatticeRuns(const cg3::SparseRegularLattice3D<VT>& l) :
+        blockSize(cg3::SparseRegularLattice3D<VT>::BLOCK_SIZE),
+        bResX(l.blockResX()),
+        bResY(l.blockResY()),
+        resZ(l.resZ()),
+        columns(l.blockResX() * l.blockResY())
+    {
+        for (uint bi = 0; bi < bResX; ++bi)
+            for (uint bj = 0; bj < bResY; ++bj)
+                for (uint bk = 0; bk < l.blockResZ(); ++bk)
+                    if (l.isActiveBlock(bi, bj, bk))
+                        columns[bi * bResY + bj].push_back(bk);
+    }
+
+    /**
+     * @brief Ranges [k0, k1) of the row (i,j) such that the vertices from (i,j,k) to
+     * (i+1,j+1,k+1) may have values different from the background
+     */
+    void rowRuns(uint i, uint j, MarchingCubesRuns& runs) const
+    {
+        runs.clear();
+        const uint bis[2] = {i / blockSize, (i+1) / blockSize};
+        const uint bjs[2] = {j / blockSize, (j+1) / blockSize};
+        for (uint a = 0; a < 2; ++a){
+            if (bis[a] >= bResX || (a == 1 && bis[1] == bis[0]))
+                continue;
+            for (uint b = 0; b < 2; ++b){
+                if (bjs[b] >= bResY || (b == 1 && bjs[1] == bjs[0]))
+                    continue;
+                for (uint bk : columns[bis[a] * bResY + bjs[b]]){
+                    uint k0 = bk * blockSize;
+                    runs.push_back(std::make_pair(k0 > 0 ? k0 - 1 : 0, std::min(k0 + blockSize, resZ)));
+                }
+            }
+        }
+        if (runs.size() < 2)
+            return;
+        std::sort(runs.begin(), runs.end());
+        uint n = 0;
+        for (uint r = 1; r < runs.size(); ++r){
+            if (runs[r].first <= runs[n].second)
+                runs[n].second = std::max(runs[n].second, runs[r].second);
+            else
+                runs[++n] = runs[r];
+        }
+        runs.resize(n + 1);
+    }
+
+private:
+    uint blockSize;
+    uint bResX, bResY, resZ;
+    std::vector<std::vector<uint>> columns;
+};
+
+/**
+ * @brief Assigns consecutive ids, starting from base, to the crossed edges owned by
+ * the vertices of the slice i of the lattice (edges going in the positive x, y and z
+ * directions from the vertex), storing them in sliceIds[3*(j*resZ+k)+axis].
+ * Only the vertices in the runs given by r are visited.
+ * If vertices is not null, the surface points of these edges are also stored.
+ * @return the number of crossed edges of the slice
+ */
+template <class Field, class Runs>
+uint marchingCubesSliceVertices(
+        const Field& f,
+        const Runs& r,
+        uint resX, uint resY, uint resZ,
+        uint i,
+        uint base,
+        std::vector<uint>& sliceIds,
+        MarchingCubesRuns& runs,
+        cg3::Point3d* vertices)
+{
+    uint n = base;
+    for (uint j = 0; j < resY; ++j){
+        r.rowRuns(i, j, runs);
+        for (const std::pair<uint, uint>& run : runs){
+            for (uint k = run.first; k < run.second; ++k){
+                const bool in = f.inside(i, j, k);
+                uint* ids = &sliceIds[3 * (j * resZ + k)];
+                if (i+1 < resX && f.inside(i+1, j, k) != in){
+                    if (vertices) vertices[n] = f.edgePoint(i, j, k, i+1, j, k);
+                    ids[0] = n++;
+                }
+                if (j+1 < resY && f.inside(i, j+1, k) != in){
+                    if (vertices) vertices[n] = f.edgePoint(i, j, k, i, j+1, k);
+                    ids[1] = n++;
+                }
+                if (k+1 < resZ && f.inside(i, j, k+1) != in){
+                    if (vertices) vertices[n] = f.edgePoint(i, j, k, i, j, k+1);
+                    ids[2] = n++;
+                }
+            }
+        }
+    }
+    return n - base;
+}
+
+/**
+ * @brief Configuration of the cube (i,j,k): the bit c is set if the corner c is inside
+ */
+template <class Field>
+uint marchingCubesCubeIndex(const Field& f, uint i, uint j, uint k)
+{
+    uint cubeIndex = 0;
+    if (f.inside(i,   j,   k  )) cubeIndex |= 1;
+    if (f.inside(i+1, j,   k  )) cubeIndex |= 2;
+    if (f.inside(i+1, j+1, k  )) cubeIndex |= 4;
+    if (f.inside(i,   j+1, k  )) cubeIndex |= 8;
+    if (f.inside(i,   j,   k+1)) cubeIndex |= 16;
+    if (f.inside(i+1, j,   k+1)) cubeIndex |= 32;
+    if (f.inside(i+1, j+1, k+1)) cubeIndex |= 64;
+    if (f.inside(i,   j+1, k+1)) cubeIndex |= 128;
+    return cubeIndex;
+}
+
+/**
+ * @brief Marching cubes on a scalar field sampled on a resX*resY*resZ grid.
+ *
+ * The lattice is split in slices orthogonal to the x axis, processed in parallel.
+ * A first pass counts the surface vertices owned by every slice and the triangles
+ * generated by every slab of cubes; prefix sums of these counts give the position
+ * of the output of every slice. In the second pass every slab of cubes rebuilds the
+ * ids of the crossed edges of its two slices in two local caches, writes the vertices
+ * owned by its first slice and its triangles: shared vertices are welded by
+ * construction, without any global point lookup.
+ * In every row (i,j), only the ranges of k given by r are visited: the regions outside
+ * them must not be crossed by the surface.
+ */
+template <class Field, class Runs>
+void marchingCubes(
+        const Field& f,
+        const Runs& r,
+        uint resX, uint resY, uint resZ,
+        std::vector<cg3::Point3d>& vertices,
+        std::vector<uint>& triangles)
+{
+    vertices.clear();
+    triangles.clear();
+    if (resX < 2 || resY < 2 || resZ < 2)
+        return;
+
+    const long long int nSlices = resX;
+    std::vector<uint> vertexBase(nSlices + 1, 0);
+    std::vector<uint> triangleBase(nSlices + 1, 0);
+
+    #pragma omp parallel
+    {
+        std::vector<uint> sliceIds(3 * resY * resZ);
+        MarchingCubesRuns runs;
+
+        #pragma omp for schedule(dynamic)
+        for (long long int i = 0; i < nSlices; i++){
+            vertexBase[i+1] = marchingCubesSliceVertices(
+                        f, r, resX, resY, resZ, i, 0, sliceIds, runs, nullptr);
+            uint nTriangles = 0;
+            if (i+1 < nSlices){
+                for (uint j = 0; j < resY-1; ++j){
+                    r.rowRuns(i, j, runs);
+                    for (const std::pair<uint, uint>& run : runs){
+                        for (uint k = run.first; k < run.second && k < resZ-1; ++k){
+                            uint cubeIndex = marchingCubesCubeIndex(f, i, j, k);
+                            uint n = 0;
+                            while (n < 16 && triTable(cubeIndex, n) != -1)
+                                n += 3;
+                            nTriangles += n / 3;
+                        }
+                    }
+                }
+            }
+            triangleBase[i+1] = nTriangles;
+        }
+    }
+
+    for (long long int i = 0; i < nSlices; i++){
+        vertexBase[i+1] += vertexBase[i];
+        triangleBase[i+1] += triangleBase[i];
+    }
+    vertices.resize(vertexBase[nSlices]);
+    triangles.resize(3 * triangleBase[nSlices]);
+
+    #pragma omp parallel
+    {
+        std::vector<uint> currentIds(3 * resY * resZ);
+        std::vector<uint> nextIds(3 * resY * resZ);
+        const std::vector<uint>* sliceIds[2] = {&currentIds, &nextIds};
+        MarchingCubesRuns runs;
+
+        #pragma omp for schedule(dynamic)
+        for (long long int i = 0; i < nSlices; i++){
+            marchingCubesSliceVertices(
+                        f, r, resX, resY, resZ, i, vertexBase[i], currentIds, runs, vertices.data());
+            if (i+1 == nSlices)
+                continue;
+            marchingCubesSliceVertices(
+                        f, r, resX, resY, resZ, i+1, vertexBase[i+1], nextIds, runs, nullptr);
+
+            uint* tri = triangles.data() + 3 * triangleBase[i];
+            for (uint j = 0; j < resY-1; ++j){
+                r.rowRuns(i, j, runs);
+                for (const std::pair<uint, uint>& run : runs){
+                    for (uint k = run.first; k < run.second && k < resZ-1; ++k){
+                        uint cubeIndex = marchingCubesCubeIndex(f, i, j, k);
+                        for (uint n = 0; n < 16 && triTable(cubeIndex, n) != -1; n += 3){
+                            uint ids[3];
+                            for (uint m = 0; m < 3; ++m){
+                                const int* e = cubeEdges[triTable(cubeIndex, n+m)];
+                                ids[m] = (*sliceIds[e[0]])[3 * ((j + e[1]) * resZ + k + e[2]) + e[3]];
+                            }
+                            //same orientation of the triangles built by the Dcel version
+                            *(tri++) = ids[1];
+                            *(tri++) = ids[0];
+                            *(tri++) = ids[2];
+                        }
+                    }
+                }
+            }
+        }
+    }
+}
+
+} //namespace cg3::internal
+
+/**
+ * @brief Extracts the iso surface of a scalar field sampled on a lattice, using the
+ * marching cubes algorithm. The region with values less than the iso value is
+ * considered inside the surface.
+ * @param[in] l: the lattice
+ * @param[in] isoValue: the value of the surface
+ * @return the surface as a Dcel
+ */
+template <class T>
+Dcel marchingCubes(const cg3::RegularLattice3D<T>& l, double isoValue)
+{
+	std::vector<cg3::Point3d> vertices;
+	std::vector<uint> triangles;
+	marchingCubes(l, isoValue, vertices, triangles);
+
+	cg3::Dcel d;
+	d.buildFromIndexedMesh(vertices, triangles);
+	d.updateVertexNormals();
+	return d;
 }
 
+/**
+ * @brief Extracts the iso surface of a scalar field sampled on a lattice, using the
+ * marching cubes algorithm, as an indexed triangle mesh.
+ * The region with values less than the iso value is considered inside the surface.
+ * @param[in] l: the lattice
+ * @param[in] isoValue: the value of the surface
+ * @param[out] vertices: the vertices of the surface
+ * @param[out] triangles: three vertex indices for each triangle of the surface
+ */
+template <class T>
+void marchingCubes(
+        const cg3::RegularLattice3D<T>& l,
+        double isoValue,
+        std::vector<cg3::Point3d>& vertices,
+        std::vector<uint>& triangles)
+{
+	internal::ScalarLatticeField<cg3::RegularLattice3D<T>> f(l, isoValue);
+	internal::DenseLatticeRuns r(l.resZ());
+	internal::marchingCubes(f, r, l.resX(), l.resY(), l.resZ(), vertices, triangles);
+}
+
+/**
+ * @brief Extracts the iso surface of a scalar field sampled on a sparse lattice, using
+ * the marching cubes algorithm. The region with values less than the iso value is
+ * considered inside the surface.
+ * @param[in] l: the lattice
+ * @param[in] isoValue: the value of the surface
+ * @return the surface as a Dcel
+ */
+template <class T>
+Dcel marchingCubes(const cg3::SparseRegularLattice3D<T>& l, double isoValue)
+{
+	std::vector<cg3::Point3d> vertices;
+	std::vector<uint> triangles;
+	marchingCubes(l, isoValue, vertices, triangles);
+
+	cg3::Dcel d;
+	d.buildFromIndexedMesh(vertices, triangles);
+	d.updateVertexNormals();
+	return d;
 }
 
-CG3_INLINE Dcel marchingCubes(const cg3::RegularLattice3D<bool>& l)
+/**
+ * @brief Extracts the iso surface of a scalar field sampled on a sparse lattice, using
+ * the marching cubes algorithm, as an indexed triangle mesh.
+ * Only the cubes having at least a vertex in an active block of the lattice are visited.
+ * @param[in] l: the lattice
+ * @param[in] isoValue: the value of the surface
+ * @param[out] vertices: the vertices of the surface
+ * @param[out] triangles: three vertex indices for each triangle of the surface
+ */
+template <class T>
+void marchingCubes(
+        const cg3::SparseRegularLattice3D<T>& l,
+        double isoValue,
+        std::vector<cg3::Point3d>& vertices,
+        std::vector<uint>& triangles)
 {
-	cg3::DcelBuilder b;
-	for (uint i = 0; i < l.resX()-1; ++i){
-		for (uint j = 0; j < l.resY()-1; ++j){
-			for (uint k = 0; k < l.resZ()-1; ++k){
-
-				uint cubeIndex = 0;
-				if (l.vertexProperty(i,   j,   k  )) cubeIndex |= 1;
-				if (l.vertexProperty(i+1, j,   k  )) cubeIndex |= 2;
-				if (l.vertexProperty(i+1, j+1, k  )) cubeIndex |= 4;
-				if (l.vertexProperty(i,   j+1, k  )) cubeIndex |= 8;
-				if (l.vertexProperty(i,   j,   k+1)) cubeIndex |= 16;
-				if (l.vertexProperty(i+1, j,   k+1)) cubeIndex |= 32;
-				if (l.vertexProperty(i+1, j+1, k+1)) cubeIndex |= 64;
-				if (l.vertexProperty(i,   j+1, k+1)) cubeIndex |= 128;
-
-				for(uint n = 0; n < 16 && internal::triTable(cubeIndex,n) != -1; n+=3){
-					cg3::Point3d p1 = internal::edgeCoordinate(
-								l, i, j, k, internal::triTable(cubeIndex, n));
-					cg3::Point3d p2 = internal::edgeCoordinate(
-								l, i, j, k, internal::triTable(cubeIndex, n+1));
-					cg3::Point3d p3 = internal::edgeCoordinate(
-								l, i, j, k, internal::triTable(cubeIndex, n+2));
-					b.addFace(p2, p1, p3);
-				}
-			}
-		}
-	}
-	b.finalize();
-	return b.dcel();
+	internal::ScalarLatticeField<cg3::SparseRegularLattice3D<T>> f(l, isoValue);
+	internal::SparseLatticeRuns r(l);
+	internal::marchingCubes(f, r, l.resX(), l.resY(), l.resZ(), vertices, triangles);
 }
 
 } //namespace cg3
@@ -9,18 +9,55 @@
 #define CG3_MARCHING_CUBES_H
 
 #include <cg3/data_structures/lattices/regular_lattice.h>
-#include <cg3/meshes/dcel/dcel_builder.h>
+#include <cg3/data_structures/lattices/sparse_regular_lattice.h>
+#include <cg3/meshes/dcel/dcel.h>
+
+#include <vector>
 
 namespace cg3 {
 
 cg3::Dcel marchingCubes(const cg3::RegularLattice3D<bool>& l);
 
+void marchingCubes(
+        const cg3::RegularLattice3D<bool>& l,
+        std::vector<cg3::Point3d>& vertices,
+        std::vector<unsigned int>& triangles);
+
+template <class T>
+cg3::Dcel marchingCubes(const cg3::RegularLattice3D<T>& l, double isoValue);
+
+template <class T>
+void marchingCubes(
+        const cg3::RegularLattice3D<T>& l,
+        double isoValue,
+        std::vector<cg3::Point3d>& vertices,
+        std::vector<unsigned int>& triangles);
+
+cg3::Dcel marchingCubes(const cg3::SparseRegularLattice3D<bool>& l);
+
+void marchingCubes(
+        const cg3::SparseRegularLattice3D<bool>& l,
+        std::vector<cg3::Point3d>& vertices,
+        std::vector<unsigned int>& triangles);
+
+template <class T>
+cg3::Dcel marchingCubes(const cg3::SparseRegularLattice3D<T>& l, double isoValue);
+
+template <class T>
+void marchingCubes(
+        const cg3::SparseRegularLattice3D<T>& l,
+        double isoValue,
+        std::vector<cg3::Point3d>& vertices,
+        std::vector<unsigned int>& triangles);
+
 } //namespace cg3
 
+#include "marching_cubes.cpp"
+
 #ifndef CG3_STATIC
-#define CG3_MARCHING_CUBES_CPP "marching_cubes.cpp"
-#include CG3_MARCHING_CUBES_CPP
-#undef CG3_MARCHING_CUBES_CPP
+#define CG3_MARCHING_CUBES_BOOL_CPP "marching_cubes_bool.cpp"
+#include CG3_MARCHING_CUBES_BOOL_CPP
+#undef CG3_MARCHING_CUBES_BOOL_CPP
 #endif
 
 #endif // CG3_MARCHING_CUBES_H
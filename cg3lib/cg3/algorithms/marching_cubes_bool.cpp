@@ -0,0 +1,89 @@
+/*
+ * This file is part of cg3lib: https://github.com/cg3hci/cg3lib
+ * This Source Code Form is subject to the terms of the GNU GPL 3.0
+ *
+ * @author Alessandro Muntoni (muntoni.alessandro@gmail.com)
+ */
+#include "marching_cubes.h"
+
+namespace cg3 {
+
+/**
+ * @brief Extracts the surface of the region of the lattice whose vertices have property
+ * true, using the marching cubes algorithm.
+ * @param[in] l: the lattice
+ * @return the surface as a Dcel
+ */
+CG3_INLINE Dcel marchingCubes(const cg3::RegularLattice3D<bool>& l)
+{
+	std::vector<cg3::Point3d> vertices;
+	std::vector<uint> triangles;
+	marchingCubes(l, vertices, triangles);
+
+	cg3::Dcel d;
+	d.buildFromIndexedMesh(vertices, triangles);
+	d.updateVertexNormals();
+	return d;
+}
+
+/**
+ * @brief Extracts the surface of the region of the lattice whose vertices have property
+ * true, using the marching cubes algorithm, as an indexed triangle mesh.
+ *
+ * The lattice is processed in parallel, and vertices shared by adjacent cubes are
+ * emitted once.
+ *
+ * @param[in] l: the lattice
+ * @param[out] vertices: the vertices of the surface
+ * @param[out] triangles: three vertex indices for each triangle of the surface
+ */
+CG3_INLINE void marchingCubes(
+        const cg3::RegularLattice3D<bool>& l,
+        std::vector<cg3::Point3d>& vertices,
+        std::vector<uint>& triangles)
+{
+	internal::BoolLatticeField<cg3::RegularLattice3D<bool>> f(l);
+	internal::DenseLatticeRuns r(l.resZ());
+	internal::marchingCubes(f, r, l.resX(), l.resY(), l.resZ(), vertices, triangles);
+}
+
+/**
+ * @brief Extracts the surface of the region of the sparse lattice whose vertices have
+ * property true, using the marching cubes algorithm.
+ * @param[in] l: the lattice
+ * @return the surface as a Dcel
+ */
+CG3_INLINE Dcel marchingCubes(const cg3::SparseRegularLattice3D<bool>& l)
+{
+	std::vector<cg3::Point3d> vertices;
+	std::vector<uint> triangles;
+	marchingCubes(l, vertices, triangles);
+
+	cg3::Dcel d;
+	d.buildFromIndexedMesh(vertices, triangles);
+	d.updateVertexNormals();
+	return d;
+}
+
+/**
+ * @brief Extracts the surface of the region of the sparse lattice whose vertices have
+ * property true, using the marching cubes algorithm, as an indexed triangle mesh.
+ *
+ * Only the cubes having at least a vertex in an active block of the lattice are visited.
+ * The output is the same of the marching cubes on a dense lattice with the same values.
+ *
+ * @param[in] l: the lattice
+ * @param[out] vertices: the vertices of the surface
+ * @param[out] triangles: three vertex indices for each triangle of the surface
+ */
+CG3_INLINE void marchingCubes(
+        const cg3::SparseRegularLattice3D<bool>& l,
+        std::vector<cg3::Point3d>& vertices,
+        std::vector<uint>& triangles)
+{
+	internal::BoolLatticeField<cg3::SparseRegularLattice3D<bool>> f(l);
+	internal::SparseLatticeRuns r(l);
+	internal::marchingCubes(f, r, l.resX(), l.resY(), l.resZ(), vertices, triangles);
+}
+
+} //namespace cg3
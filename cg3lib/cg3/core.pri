@@ -68,7 +68,8 @@ HEADERS += \
     $$PWD/io/ply/ply_vertex.h \
     $$PWD/io/ply/ply_face.h \
     $$PWD/io/ply/ply_edge.h \
-    $$PWD/utilities/cg3_config_folder.h \ #utilities
+    $$PWD/utilities/bits.h \ #utilities
+    $$PWD/utilities/cg3_config_folder.h \
     $$PWD/utilities/color.h \
     $$PWD/utilities/command_line_argument_manager.h \
     $$PWD/utilities/comparators.h \
@@ -117,7 +118,8 @@ SOURCES += \
     $$PWD/io/ply/ply_face.cpp \
     $$PWD/io/ply/ply_header.cpp \
     $$PWD/io/ply/ply_vertex.cpp \
-    $$PWD/utilities/color.cpp \ #utilities
+    $$PWD/utilities/bits.cpp \ #utilities
+    $$PWD/utilities/color.cpp \
     $$PWD/utilities/command_line_argument_manager.cpp \
     $$PWD/utilities/eigen.cpp \
     $$PWD/utilities/hash.cpp \
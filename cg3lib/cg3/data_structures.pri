@@ -24,6 +24,7 @@ HEADERS += \
     $$PWD/data_structures/arrays/array4d.h \
     $$PWD/data_structures/arrays/array_bool.h \ #graphs
     $$PWD/data_structures/graphs/graph.h \
+    $$PWD/data_structures/graphs/compressed_graph.h \
     $$PWD/data_structures/graphs/includes/nodes/graph_node.h \
     $$PWD/data_structures/graphs/includes/iterators/graph_genericnodeiterator.h \
     $$PWD/data_structures/graphs/includes/iterators/graph_nodeiterator.h \
@@ -34,6 +35,8 @@ HEADERS += \
     $$PWD/data_structures/graphs/undirected_node.h \
     $$PWD/data_structures/lattices/regular_lattice.h \ #lattices
     $$PWD/data_structures/lattices/regular_lattice_iterators.h \
+    $$PWD/data_structures/lattices/sparse_regular_lattice.h \
+    $$PWD/data_structures/lattices/sparse_regular_lattice_iterators.h \
     $$PWD/data_structures/trees/includes/tree_common.h \ #tree common
     $$PWD/data_structures/trees/includes/iterators/tree_genericiterator.h \
     $$PWD/data_structures/trees/includes/iterators/tree_insertiterator.h \
@@ -47,13 +50,15 @@ HEADERS += \
     $$PWD/data_structures/trees/bst.h \
     $$PWD/data_structures/trees/bstinner.h \
     $$PWD/data_structures/trees/bstleaf.h \
+    $$PWD/data_structures/trees/static_bst.h \
     $$PWD/data_structures/trees/includes/nodes/bst_node.h \ # avl trees
     $$PWD/data_structures/trees/avlinner.h \
     $$PWD/data_structures/trees/avlleaf.h \
     $$PWD/data_structures/trees/includes/nodes/avl_node.h \ # range tree
     $$PWD/data_structures/trees/rangetree.h \
     $$PWD/data_structures/trees/includes/nodes/rangetree_node.h \
-    $$PWD/data_structures/trees/includes/rangetree_types.h \ #aabb tree
+    $$PWD/data_structures/trees/includes/rangetree_types.h \
+    $$PWD/data_structures/trees/static_rangetree.h \ #aabb tree
     $$PWD/data_structures/trees/aabbtree.h \
     $$PWD/data_structures/trees/includes/nodes/aabb_node.h
 
@@ -66,6 +71,7 @@ SOURCES += \
     $$PWD/data_structures/arrays/array_bool.cpp \
     $$PWD/data_structures/graphs/bipartite_graph.cpp \
     $$PWD/data_structures/graphs/bipartite_graph_iterators.cpp \
+    $$PWD/data_structures/graphs/compressed_graph.cpp \
     $$PWD/data_structures/graphs/graph.cpp \ #graphs
     $$PWD/data_structures/graphs/includes/iterators/graph_adjacentiterator.cpp \
     $$PWD/data_structures/graphs/includes/iterators/graph_edgeiterator.cpp \
@@ -74,6 +80,8 @@ SOURCES += \
     $$PWD/data_structures/graphs/includes/nodes/graph_node.cpp \
     $$PWD/data_structures/lattices/regular_lattice.cpp \ #lattices
     $$PWD/data_structures/lattices/regular_lattice_iterators.cpp \
+    $$PWD/data_structures/lattices/sparse_regular_lattice.cpp \
+    $$PWD/data_structures/lattices/sparse_regular_lattice_iterators.cpp \
     $$PWD/data_structures/trees/aabbtree.cpp \
     $$PWD/data_structures/trees/avlinner.cpp \
     $$PWD/data_structures/trees/avlleaf.cpp \
@@ -87,6 +95,8 @@ SOURCES += \
     $$PWD/data_structures/trees/includes/iterators/tree_iterator.cpp \
     $$PWD/data_structures/trees/includes/iterators/tree_rangebased_iterators.cpp \
     $$PWD/data_structures/trees/rangetree.cpp \
+    $$PWD/data_structures/trees/static_bst.cpp \
+    $$PWD/data_structures/trees/static_rangetree.cpp \
     $$PWD/data_structures/trees/includes/iterators/tree_reverseiterator.cpp \
     $$PWD/data_structures/trees/includes/nodes/aabb_node.cpp \
     $$PWD/data_structures/trees/includes/nodes/avl_node.cpp \
@@ -135,18 +135,7 @@ T* cg3::Array<T, N>::cArray(I... indices)
         return v.data();
     }
     unsigned long int args[] = { static_cast<unsigned long int>(indices)... };
-    unsigned long int ind = args[0];
-    assert(args[0] < sizes[0]);
-    unsigned int i;
-    for (i = 1; i < n; i++){
-        assert(args[i] < sizes[i]);
-        ind*=sizes[i];
-        ind+=args[i];
-    }
-    for (; i < N; i++){
-        ind*=sizes[i];
-    }
-    return &v[ind];
+    return &v[sliceOffset(args, n)];
 }
 
 /**
@@ -180,18 +169,7 @@ const T* cg3::Array<T, N>::cArray(I... indices) const
         return v.data();
     }
     unsigned long int args[] = { static_cast<unsigned long int>(indices)... };
-    unsigned long int ind = args[0];
-    assert(args[0] < sizes[0]);
-    unsigned int i;
-    for (i = 1; i < n; i++){
-        assert(args[i] < sizes[i]);
-        ind*=sizes[i];
-        ind+=args[i];
-    }
-    for (; i < N; i++){
-        ind*=sizes[i];
-    }
-    return &v[ind];
+    return &v[sliceOffset(args, n)];
 }
 
 /**
@@ -212,6 +190,113 @@ const std::vector<T>& cg3::Array<T, N>::stdVector() const
 	return v;
 }
 
+/**
+ * @brief Returns an iterator to the first element of the array. Elements are visited
+ * in row-major order.
+ */
+template<class T, size_t N>
+typename cg3::Array<T, N>::iterator cg3::Array<T, N>::begin()
+{
+    return v.begin();
+}
+
+/**
+ * @brief Returns an iterator to the end of the array.
+ */
+template<class T, size_t N>
+typename cg3::Array<T, N>::iterator cg3::Array<T, N>::end()
+{
+    return v.end();
+}
+
+/**
+ * @brief Returns a const iterator to the first element of the array. Elements are visited
+ * in row-major order.
+ */
+template<class T, size_t N>
+typename cg3::Array<T, N>::const_iterator cg3::Array<T, N>::begin() const
+{
+    return v.begin();
+}
+
+/**
+ * @brief Returns a const iterator to the end of the array.
+ */
+template<class T, size_t N>
+typename cg3::Array<T, N>::const_iterator cg3::Array<T, N>::end() const
+{
+    return v.end();
+}
+
+/**
+ * @brief Returns an iterator to the first element of the slice identified by the given
+ * indices. The elements of a slice are contiguous, hence [sliceBegin, sliceEnd) can be passed
+ * to any standard algorithm.
+ *
+ * Example:
+ * \code{.cpp}
+ * cg3::Array<double, 3> array(10, 13, 4);
+ * //...
+ * std::fill(array.sliceBegin(3), array.sliceEnd(3), 0); //sets to 0 all the 13*4 elements (3,j,k)
+ * double s = std::accumulate(array.sliceBegin(4, 2), array.sliceEnd(4, 2), 0.0); //sum of the elements (4,2,k)
+ * \endcode
+ *
+ * @param[in] indices: a number of indices that is less than the number of dimensions of the array.
+ */
+template<class T, size_t N>
+template<typename... I>
+typename cg3::Array<T, N>::iterator cg3::Array<T, N>::sliceBegin(I... indices)
+{
+    static_assert(sizeof...(indices) < N, "Wrong number of arguments for sliceBegin().");
+    const unsigned long int n = sizeof...(indices);
+    if (n == 0)
+        return v.begin();
+    unsigned long int args[] = { static_cast<unsigned long int>(indices)... };
+    return v.begin() + sliceOffset(args, n);
+}
+
+/**
+ * @brief Returns an iterator to the end of the slice identified by the given indices.
+ * @see sliceBegin
+ * @param[in] indices: a number of indices that is less than the number of dimensions of the array.
+ */
+template<class T, size_t N>
+template<typename... I>
+typename cg3::Array<T, N>::iterator cg3::Array<T, N>::sliceEnd(I... indices)
+{
+    return sliceBegin(indices...) + sliceSize(sizeof...(indices));
+}
+
+/**
+ * @brief Returns a const iterator to the first element of the slice identified by the given
+ * indices.
+ * @see sliceBegin
+ * @param[in] indices: a number of indices that is less than the number of dimensions of the array.
+ */
+template<class T, size_t N>
+template<typename... I>
+typename cg3::Array<T, N>::const_iterator cg3::Array<T, N>::sliceBegin(I... indices) const
+{
+    static_assert(sizeof...(indices) < N, "Wrong number of arguments for sliceBegin().");
+    const unsigned long int n = sizeof...(indices);
+    if (n == 0)
+        return v.begin();
+    unsigned long int args[] = { static_cast<unsigned long int>(indices)... };
+    return v.begin() + sliceOffset(args, n);
+}
+
+/**
+ * @brief Returns a const iterator to the end of the slice identified by the given indices.
+ * @see sliceBegin
+ * @param[in] indices: a number of indices that is less than the number of dimensions of the array.
+ */
+template<class T, size_t N>
+template<typename... I>
+typename cg3::Array<T, N>::const_iterator cg3::Array<T, N>::sliceEnd(I... indices) const
+{
+    return sliceBegin(indices...) + sliceSize(sizeof...(indices));
+}
+
 /**
  * @brief Fills the entire Array with the value t.
  * @param[in] t
@@ -289,6 +374,81 @@ const T& cg3::Array<T, N>::max() const
     return *(std::max_element(v.begin(), v.end()));
 }
 
+/**
+ * @brief Returns the sum of all the elements of the array (T() if the array is empty).
+ */
+template<class T, size_t N>
+T cg3::Array<T, N>::sum() const
+{
+    T s = T();
+    const T* p = v.data();
+    const long long int n = v.size();
+    for (long long int i = 0; i < n; i++)
+        s += p[i];
+    return s;
+}
+
+/**
+ * @brief Applies the function f to every element of the array, in row-major order.
+ *
+ * Example:
+ * \code{.cpp}
+ * array.apply([](double& d) { d = std::abs(d); });
+ * \endcode
+ *
+ * @param[in] f: a function or a lambda that takes a T&
+ */
+template<class T, size_t N>
+template<typename F>
+void cg3::Array<T, N>::apply(F f)
+{
+    T* p = v.data();
+    const long long int n = v.size();
+    for (long long int i = 0; i < n; i++)
+        f(p[i]);
+}
+
+/**
+ * @brief Applies the function f to every element of the array, splitting the elements among
+ * the available threads (if cg3lib has been compiled with OpenMP, otherwise it is equivalent
+ * to apply()).
+ *
+ * f is called concurrently on different elements, in no particular order: it must not modify
+ * shared state without synchronization.
+ *
+ * @param[in] f: a function or a lambda that takes a T&
+ */
+template<class T, size_t N>
+template<typename F>
+void cg3::Array<T, N>::parallelApply(F f)
+{
+    T* p = v.data();
+    const long long int n = v.size();
+    #pragma omp parallel for schedule(static)
+    for (long long int i = 0; i < n; i++)
+        f(p[i]);
+}
+
+/**
+ * @brief Returns true if the two arrays have the same sizes and the same elements.
+ * @param[in] other
+ */
+template<class T, size_t N>
+bool cg3::Array<T, N>::operator ==(const Array<T, N>& other) const
+{
+    return sizes == other.sizes && std::equal(v.begin(), v.end(), other.v.begin());
+}
+
+/**
+ * @brief Returns true if the two arrays have different sizes or different elements.
+ * @param[in] other
+ */
+template<class T, size_t N>
+bool cg3::Array<T, N>::operator !=(const Array<T, N>& other) const
+{
+    return !(*this == other);
+}
+
 /**
  * @brief Allows to resize the Array, not conserving the values of the previous array.
  * @param[in] s: #N elements representing the new sizes of the Array.
@@ -322,14 +482,29 @@ void cg3::Array<T, N>::conservativeResize(Sizes... s)
         newTotalSize*=newSizes[i];
     std::vector<T> newVector(newTotalSize);
 
-    for (unsigned long int i = 0; i < v.size(); i++){
-        std::array<unsigned long int, N> indices = reverseIndex(i);
-        bool outOfBound = false;
-        for (unsigned long int j = 0; j < N; j++)
-            if (indices[j] >= newSizes[j] || indices[j] >= sizes[j])
-                outOfBound = true;
-        if (!outOfBound){
-            newVector[getIndex(indices.data(), newSizes)] = v[i];
+    //the common part is copied one row (last dimension) at a time
+    unsigned long int common[N];
+    bool empty = false;
+    for (unsigned int i = 0; i < N; i++){
+        common[i] = std::min(sizes[i], newSizes[i]);
+        if (common[i] == 0)
+            empty = true;
+    }
+    if (!empty){
+        unsigned long int indices[N] = {};
+        bool end = false;
+        while (!end){
+            std::copy_n(
+                        v.begin() + getIndex(indices, sizes.data()), common[N-1],
+                        newVector.begin() + getIndex(indices, newSizes));
+            //next row of the common part
+            end = true;
+            for (long int i = (long int)N-2; i >= 0 && end; i--){
+                if (++indices[i] < common[i])
+                    end = false;
+                else
+                    indices[i] = 0;
+            }
         }
     }
 
@@ -436,6 +611,39 @@ unsigned long cg3::Array<T, N>::getIndex(const unsigned long indices[], const un
     return ind;
 }
 
+/**
+ * @brief Returns the position in v of the first element of the slice identified by the
+ * first n indices.
+ */
+template<class T, size_t N>
+unsigned long int cg3::Array<T, N>::sliceOffset(const unsigned long int indices[], unsigned long int n) const
+{
+    unsigned long int ind = indices[0];
+    assert(indices[0] < sizes[0]);
+    unsigned int i;
+    for (i = 1; i < n; i++){
+        assert(indices[i] < sizes[i]);
+        ind*=sizes[i];
+        ind+=indices[i];
+    }
+    for (; i < N; i++){
+        ind*=sizes[i];
+    }
+    return ind;
+}
+
+/**
+ * @brief Returns the number of elements of a slice identified by n indices.
+ */
+template<class T, size_t N>
+unsigned long int cg3::Array<T, N>::sliceSize(unsigned long int n) const
+{
+    unsigned long int size = 1;
+    for (unsigned long int i = n; i < N; i++)
+        size *= sizes[i];
+    return size;
+}
+
 template<typename T, size_t N>
 void cg3::Array<T, N>::initializeNestedLists(cg3::NestedInitializerLists<T, N> values)
 {
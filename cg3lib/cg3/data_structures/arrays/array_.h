@@ -9,6 +9,7 @@
 #define CG3_ARRAY_H
 
 #include <vector>
+#include <algorithm>
 #include <assert.h>
 #include <cg3/io/serialize.h>
 #include <cg3/utilities/nested_initializer_lists.h>
@@ -75,6 +76,9 @@ class Array : public SerializableObject {
     static_assert(N > 0, "Array dimension must be > 0.");
     friend class Array<T, N+1>;
 public:
+    typedef typename std::vector<T>::iterator iterator;
+    typedef typename std::vector<T>::const_iterator const_iterator;
+
     Array();
     template<typename... Sizes>
     Array(Sizes... sizes);
@@ -93,6 +97,19 @@ public:
 	std::vector<T> stdVector();
 	const std::vector<T>& stdVector() const;
 
+    iterator begin();
+    iterator end();
+    const_iterator begin() const;
+    const_iterator end() const;
+    template<typename... I>
+    iterator sliceBegin(I... indices);
+    template<typename... I>
+    iterator sliceEnd(I... indices);
+    template<typename... I>
+    const_iterator sliceBegin(I... indices) const;
+    template<typename... I>
+    const_iterator sliceEnd(I... indices) const;
+
     void fill (const T& t);
 	template <typename C>
 	void fillContainer (const C& container);
@@ -102,6 +119,15 @@ public:
     const T& min() const;
     T& max();
     const T& max() const;
+    T sum() const;
+
+    template <typename F>
+    void apply(F f);
+    template <typename F>
+    void parallelApply(F f);
+
+    bool operator == (const Array<T, N>& other) const;
+    bool operator != (const Array<T, N>& other) const;
 
     template<typename... Sizes>
     void resize (Sizes... s);
@@ -121,6 +147,8 @@ protected:
     unsigned long int getIndex(const unsigned long int indices[]) const;
     std::array<unsigned long int, N> reverseIndex(unsigned int index);
     static unsigned long int getIndex(const unsigned long int indices[], const unsigned long int sizes[]);
+    unsigned long int sliceOffset(const unsigned long int indices[], unsigned long int n) const;
+    unsigned long int sliceSize(unsigned long int n) const;
 
     void initializeNestedLists(cg3::NestedInitializerLists<T, N> values);
 
@@ -134,18 +134,7 @@ uint8_t* cg3::Array<bool, N>::cArray(I... indices)
         return v.data();
     }
     unsigned long int args[] = { static_cast<unsigned long int>(indices)... };
-    unsigned long int ind = args[0];
-    assert(args[0] < sizes[0]);
-    unsigned int i;
-    for (i = 1; i < n; i++){
-        assert(args[i] < sizes[i]);
-        ind*=sizes[i];
-        ind+=args[i];
-    }
-    for (; i < N; i++){
-        ind*=sizes[i];
-    }
-    return &v[ind];
+    return &v[sliceOffset(args, n)];
 }
 
 /**
@@ -179,18 +168,7 @@ const uint8_t* cg3::Array<bool, N>::cArray(I... indices) const
         return v.data();
     }
     unsigned long int args[] = { static_cast<unsigned long int>(indices)... };
-    unsigned long int ind = args[0];
-    assert(args[0] < sizes[0]);
-    unsigned int i;
-    for (i = 1; i < n; i++){
-        assert(args[i] < sizes[i]);
-        ind*=sizes[i];
-        ind+=args[i];
-    }
-    for (; i < N; i++){
-        ind*=sizes[i];
-    }
-    return &v[ind];
+    return &v[sliceOffset(args, n)];
 }
 
 /**
@@ -250,6 +228,194 @@ const uint8_t& cg3::Array<bool, N>::max() const
     return *(std::max_element(v.begin(), v.end()));
 }
 
+/**
+ * @brief Computes the logical and between this array and the other one, element by element.
+ *
+ * Elements are processed 8 at a time, as 64 bit words. Every element different from 0 is
+ * considered true, and the result contains only 0s and 1s.
+ *
+ * @param[in] other: an array having the same sizes of this array
+ */
+template<size_t N>
+cg3::Array<bool, N>& cg3::Array<bool, N>::operator &=(const Array<bool, N>& other)
+{
+    wordOperation(other, [](uint64_t a, uint64_t b) { return a & b; });
+    return *this;
+}
+
+/**
+ * @brief Computes the logical or between this array and the other one, element by element.
+ * @see operator &=
+ * @param[in] other: an array having the same sizes of this array
+ */
+template<size_t N>
+cg3::Array<bool, N>& cg3::Array<bool, N>::operator |=(const Array<bool, N>& other)
+{
+    wordOperation(other, [](uint64_t a, uint64_t b) { return a | b; });
+    return *this;
+}
+
+/**
+ * @brief Computes the logical xor between this array and the other one, element by element.
+ * @see operator &=
+ * @param[in] other: an array having the same sizes of this array
+ */
+template<size_t N>
+cg3::Array<bool, N>& cg3::Array<bool, N>::operator ^=(const Array<bool, N>& other)
+{
+    wordOperation(other, [](uint64_t a, uint64_t b) { return a ^ b; });
+    return *this;
+}
+
+/**
+ * @brief Negates all the elements of the array: elements equal to 0 are set to 1,
+ * all the others are set to 0.
+ */
+template<size_t N>
+void cg3::Array<bool, N>::flip()
+{
+    wordOperation(*this, [](uint64_t a, uint64_t) { return a ^ 0x0101010101010101ull; });
+}
+
+/**
+ * @brief Returns the number of true (non zero) elements of the slice identified by the
+ * given indices. If no indices are given, the elements of all the array are counted.
+ *
+ * Example:
+ * \code{.cpp}
+ * cg3::Array<bool, 3> grid(100, 100, 100);
+ * //...
+ * unsigned long int n = grid.count(); //true elements of the grid
+ * unsigned long int nx = grid.count(42); //true elements (42,j,k)
+ * unsigned long int nxy = grid.count(42, 7); //true elements (42,7,k)
+ * \endcode
+ *
+ * @param[in] indices: a number of indices that is less than the number of dimensions of the array.
+ */
+template<size_t N>
+template<typename... I>
+unsigned long int cg3::Array<bool, N>::count(I... indices) const
+{
+    static_assert(sizeof...(indices) < N, "Wrong number of arguments for count().");
+    const unsigned long int n = sizeof...(indices);
+    unsigned long int begin = 0;
+    if (n > 0){
+        unsigned long int args[] = { static_cast<unsigned long int>(indices)... };
+        begin = sliceOffset(args, n);
+    }
+    const unsigned long int end = begin + sliceSize(n);
+
+    const uint8_t* p = v.data();
+    unsigned long int c = 0;
+    unsigned long int i = begin;
+    for (; i + 8 <= end; i += 8)
+        c += popcount64(nonZeroBytes(loadWord(p + i)));
+    for (; i < end; i++)
+        c += p[i] != 0;
+    return c;
+}
+
+/**
+ * @brief Returns true if at least one element of the array is true (non zero).
+ */
+template<size_t N>
+bool cg3::Array<bool, N>::any() const
+{
+    return findFirst() < v.size();
+}
+
+/**
+ * @brief Returns the position, in row-major order, of the first true (non zero) element
+ * of the array. If all the elements are false, returns the total number of elements.
+ *
+ * All the true elements can be visited in this way:
+ * \code{.cpp}
+ * for (unsigned long int i = a.findFirst(); i < a.size(0)*a.size(1); i = a.findNext(i)){
+ *     unsigned long int r = i / a.size(1), c = i % a.size(1);
+ *     //...
+ * }
+ * \endcode
+ */
+template<size_t N>
+unsigned long int cg3::Array<bool, N>::findFirst() const
+{
+    const unsigned long int size = v.size();
+    const uint8_t* p = v.data();
+    unsigned long int i = 0;
+    for (; i + 8 <= size; i += 8){
+        if (loadWord(p + i) != 0){
+            while (p[i] == 0)
+                i++;
+            return i;
+        }
+    }
+    for (; i < size; i++)
+        if (p[i] != 0)
+            return i;
+    return size;
+}
+
+/**
+ * @brief Returns the position, in row-major order, of the first true (non zero) element
+ * that follows the position pos. If there are no true elements after pos, returns the
+ * total number of elements.
+ * @see findFirst
+ * @param[in] pos
+ */
+template<size_t N>
+unsigned long int cg3::Array<bool, N>::findNext(unsigned long int pos) const
+{
+    const unsigned long int size = v.size();
+    const uint8_t* p = v.data();
+    unsigned long int i = pos + 1;
+    //reaching the next word boundary
+    for (; i < size && (i % 8) != 0; i++)
+        if (p[i] != 0)
+            return i;
+    for (; i + 8 <= size; i += 8){
+        if (loadWord(p + i) != 0){
+            while (p[i] == 0)
+                i++;
+            return i;
+        }
+    }
+    for (; i < size; i++)
+        if (p[i] != 0)
+            return i;
+    return size;
+}
+
+/**
+ * @brief Morphological dilation of the array: an element becomes true if at least one element
+ * of its neighborhood is true. The neighborhood of an element is the hypercube of side
+ * 2*steps+1 centered on it (for a 3D array and steps = 1, the 26 adjacent elements).
+ *
+ * The dilation is computed as a sequence of one dimensional dilations, one for each
+ * dimension of the array. The result contains only 0s and 1s.
+ *
+ * @param[in] steps: radius of the neighborhood
+ */
+template<size_t N>
+void cg3::Array<bool, N>::dilate(unsigned int steps)
+{
+    morphology(steps, true);
+}
+
+/**
+ * @brief Morphological erosion of the array: an element remains true only if all the
+ * elements of its neighborhood are true. The neighborhood of an element is the hypercube
+ * of side 2*steps+1 centered on it, and the elements outside the array are considered
+ * false (the elements closer than steps to the boundary of the array become false).
+ *
+ * @see dilate
+ * @param[in] steps: radius of the neighborhood
+ */
+template<size_t N>
+void cg3::Array<bool, N>::erode(unsigned int steps)
+{
+    morphology(steps, false);
+}
+
 /**
  * @brief Allows to resize the Array, not conserving the values of the previous array.
  * @param[in] s: #N elements representing the new sizes of the Array.
@@ -397,6 +563,39 @@ unsigned long cg3::Array<bool, N>::getIndex(const unsigned long indices[], const
     return ind;
 }
 
+/**
+ * @brief Returns the position in v of the first element of the slice identified by the
+ * first n indices.
+ */
+template<size_t N>
+unsigned long int cg3::Array<bool, N>::sliceOffset(const unsigned long int indices[], unsigned long int n) const
+{
+    unsigned long int ind = indices[0];
+    assert(indices[0] < sizes[0]);
+    unsigned int i;
+    for (i = 1; i < n; i++){
+        assert(indices[i] < sizes[i]);
+        ind*=sizes[i];
+        ind+=indices[i];
+    }
+    for (; i < N; i++){
+        ind*=sizes[i];
+    }
+    return ind;
+}
+
+/**
+ * @brief Returns the number of elements of a slice identified by n indices.
+ */
+template<size_t N>
+unsigned long int cg3::Array<bool, N>::sliceSize(unsigned long int n) const
+{
+    unsigned long int size = 1;
+    for (unsigned long int i = n; i < N; i++)
+        size *= sizes[i];
+    return size;
+}
+
 template<size_t N>
 void cg3::Array<bool, N>::initializeNestedLists(cg3::NestedInitializerLists<uint8_t, N> values)
 {
@@ -412,3 +611,134 @@ void cg3::Array<bool, N>::initializeNestedLists(cg3::NestedInitializerLists<uint
     typename std::vector<uint8_t>::iterator iterator = v.begin();
     NestedInitializerListsProcessor<uint8_t, N>::processElements(values, [&iterator](uint8_t value) { *(iterator++) = value; }, szs);
 }
+
+template<size_t N>
+uint64_t cg3::Array<bool, N>::loadWord(const uint8_t* p)
+{
+    uint64_t w;
+    std::memcpy(&w, p, sizeof(uint64_t));
+    return w;
+}
+
+template<size_t N>
+void cg3::Array<bool, N>::storeWord(uint8_t* p, uint64_t w)
+{
+    std::memcpy(p, &w, sizeof(uint64_t));
+}
+
+/**
+ * @brief Returns a word having 1 in every byte that is not 0 in w, and 0 in the other bytes.
+ */
+template<size_t N>
+uint64_t cg3::Array<bool, N>::nonZeroBytes(uint64_t w)
+{
+    const uint64_t low7 = 0x7F7F7F7F7F7F7F7Full;
+    //the most significant bit of every byte is set if any of the other bits is set
+    return ((((w & low7) + low7) | w) >> 7) & 0x0101010101010101ull;
+}
+
+/**
+ * @brief Applies op to the normalized words of this and the other array,
+ * storing the result in this array.
+ */
+template<size_t N>
+template<typename Op>
+void cg3::Array<bool, N>::wordOperation(const Array<bool, N>& other, Op op)
+{
+    assert(sizes == other.sizes);
+    const unsigned long int size = v.size();
+    uint8_t* p = v.data();
+    const uint8_t* o = other.v.data();
+    unsigned long int i = 0;
+    for (; i + 8 <= size; i += 8)
+        storeWord(p + i, op(nonZeroBytes(loadWord(p + i)), nonZeroBytes(loadWord(o + i))) & 0x0101010101010101ull);
+    for (; i < size; i++)
+        p[i] = (uint8_t)(op(p[i] != 0, o[i] != 0) & 1);
+}
+
+/**
+ * @brief One dimensional dilation (or erosion) along one dimension of the array.
+ *
+ * The array is seen as outer blocks of extent rows, each one of inner contiguous elements:
+ * a row is combined with the previous and the next rows of the same block.
+ */
+template<size_t N>
+void cg3::Array<bool, N>::morphologyAxis(
+        const uint8_t* in,
+        uint8_t* out,
+        unsigned long int outer,
+        unsigned long int extent,
+        unsigned long int inner,
+        bool dilation)
+{
+    if (inner == 1){
+        //last dimension: the neighbors are contiguous elements of the same row
+        for (unsigned long int o = 0; o < outer; o++){
+            const uint8_t* c = in + o*extent;
+            uint8_t* d = out + o*extent;
+            if (extent == 1){
+                d[0] = dilation ? c[0] : 0;
+                continue;
+            }
+            if (dilation){
+                d[0] = c[0] | c[1];
+                for (unsigned long int k = 1; k + 1 < extent; k++)
+                    d[k] = c[k-1] | c[k] | c[k+1];
+                d[extent-1] = c[extent-2] | c[extent-1];
+            }
+            else {
+                d[0] = 0;
+                for (unsigned long int k = 1; k + 1 < extent; k++)
+                    d[k] = c[k-1] & c[k] & c[k+1];
+                d[extent-1] = 0;
+            }
+        }
+        return;
+    }
+    for (unsigned long int o = 0; o < outer; o++){
+        const uint8_t* b = in + o*extent*inner;
+        uint8_t* r = out + o*extent*inner;
+        for (unsigned long int e = 0; e < extent; e++){
+            const uint8_t* c = b + e*inner;
+            uint8_t* d = r + e*inner;
+            if (dilation){
+                std::memcpy(d, c, inner);
+                if (e > 0)
+                    for (unsigned long int k = 0; k < inner; k++)
+                        d[k] |= c[k - inner];
+                if (e + 1 < extent)
+                    for (unsigned long int k = 0; k < inner; k++)
+                        d[k] |= c[k + inner];
+            }
+            else {
+                if (e == 0 || e + 1 == extent){
+                    std::memset(d, 0, inner);
+                }
+                else {
+                    for (unsigned long int k = 0; k < inner; k++)
+                        d[k] = c[k - inner] & c[k] & c[k + inner];
+                }
+            }
+        }
+    }
+}
+
+template<size_t N>
+void cg3::Array<bool, N>::morphology(unsigned int steps, bool dilation)
+{
+    if (v.empty() || steps == 0)
+        return;
+    std::vector<uint8_t> tmp(v.size());
+    //values are normalized to 0 and 1
+    wordOperation(*this, [](uint64_t a, uint64_t) { return a; });
+    for (unsigned int s = 0; s < steps; s++){
+        unsigned long int outer = 1;
+        unsigned long int inner = v.size();
+        for (unsigned int d = 0; d < N; d++){
+            inner /= sizes[d];
+            morphologyAxis(v.data(), tmp.data(), outer, sizes[d], inner, dilation);
+            v.swap(tmp);
+            outer *= sizes[d];
+        }
+    }
+}
@@ -8,6 +8,8 @@
 #define CG3_ARRAY_BOOL_H
 
 #include "array_.h"
+#include <cstring>
+#include <cg3/utilities/bits.h>
 
 namespace cg3 {
 
@@ -90,6 +92,20 @@ public:
     uint8_t& max();
     const uint8_t& max() const;
 
+    Array<bool, N>& operator &= (const Array<bool, N>& other);
+    Array<bool, N>& operator |= (const Array<bool, N>& other);
+    Array<bool, N>& operator ^= (const Array<bool, N>& other);
+    void flip();
+
+    template<typename... I>
+    unsigned long int count(I... indices) const;
+    bool any() const;
+    unsigned long int findFirst() const;
+    unsigned long int findNext(unsigned long int pos) const;
+
+    void dilate(unsigned int steps = 1);
+    void erode(unsigned int steps = 1);
+
     template<typename... Sizes>
     void resize (Sizes... s);
 
@@ -108,9 +124,25 @@ protected:
     unsigned long int getIndex(const unsigned long int indices[]) const;
     std::array<unsigned long int, N> reverseIndex(unsigned int index);
     static unsigned long int getIndex(const unsigned long int indices[], const unsigned long int sizes[]);
+    unsigned long int sliceOffset(const unsigned long int indices[], unsigned long int n) const;
+    unsigned long int sliceSize(unsigned long int n) const;
 
     void initializeNestedLists(cg3::NestedInitializerLists<uint8_t, N> values);
 
+    static uint64_t loadWord(const uint8_t* p);
+    static void storeWord(uint8_t* p, uint64_t w);
+    static uint64_t nonZeroBytes(uint64_t w);
+    template <typename Op>
+    void wordOperation(const Array<bool, N>& other, Op op);
+    static void morphologyAxis(
+            const uint8_t* in,
+            uint8_t* out,
+            unsigned long int outer,
+            unsigned long int extent,
+            unsigned long int inner,
+            bool dilation);
+    void morphology(unsigned int steps, bool dilation);
+
     std::array<unsigned long int, N> sizes;
     std::vector<uint8_t> v;
 };
@@ -0,0 +1,230 @@
+/*
+ * This file is part of cg3lib: https://github.com/cg3hci/cg3lib
+ * This Source Code Form is subject to the terms of the GNU GPL 3.0
+ */
+#include "compressed_graph.h"
+
+namespace cg3 {
+
+/* ----- CONST ----- */
+
+template <class T>
+constexpr double CompressedGraph<T>::MAX_WEIGHT;
+
+template <class T>
+constexpr size_t CompressedGraph<T>::NO_INDEX;
+
+
+/* ----- CONSTRUCTORS ----- */
+
+/**
+ * @brief Default constructor, it creates an empty graph
+ */
+template <class T>
+CompressedGraph<T>::CompressedGraph() :
+    directed(true),
+    offsets(1, 0)
+{
+
+}
+
+
+/* ----- PUBLIC METHODS ----- */
+
+/**
+ * @brief Get the number of nodes of the graph
+ * @return Number of nodes
+ */
+template <class T>
+size_t CompressedGraph<T>::numNodes() const
+{
+    return values.size();
+}
+
+/**
+ * @brief Get the number of edges of the graph
+ * @return Number of edges
+ */
+template <class T>
+size_t CompressedGraph<T>::numEdges() const
+{
+    return targets.size();
+}
+
+/**
+ * @brief Check if the graph was directed. The adjacencies of an
+ * undirected graph are symmetric.
+ * @return True if the graph was directed
+ */
+template <class T>
+bool CompressedGraph<T>::isDirected() const
+{
+    return directed;
+}
+
+/**
+ * @brief Get the value of a node
+ * @param[in] index Index of the node
+ * @return Value of the node
+ */
+template <class T>
+const T& CompressedGraph<T>::getValue(const size_t index) const
+{
+    return values[index];
+}
+
+/**
+ * @brief Get the id of a node in the graph from which the snapshot has been created
+ * @param[in] index Index of the node
+ * @return Id of the node in the graph
+ */
+template <class T>
+size_t CompressedGraph<T>::getGraphId(const size_t index) const
+{
+    return graphIds[index];
+}
+
+/**
+ * @brief Get the index of a node given its id in the graph from which the
+ * snapshot has been created
+ * @param[in] graphId Id of the node in the graph
+ * @return Index of the node, NO_INDEX if the node was not in the graph
+ */
+template <class T>
+size_t CompressedGraph<T>::getIndex(const size_t graphId) const
+{
+    if (graphId >= indexMap.size())
+        return NO_INDEX;
+    return indexMap[graphId];
+}
+
+/**
+ * @brief Get the number of adjacent nodes of a node
+ * @param[in] index Index of the node
+ * @return Number of adjacent nodes
+ */
+template <class T>
+size_t CompressedGraph<T>::degree(const size_t index) const
+{
+    return offsets[index+1] - offsets[index];
+}
+
+/**
+ * @brief Pointer to the first adjacent node of a node
+ * @param[in] index Index of the node
+ * @return Pointer to the index of the first adjacent node
+ */
+template <class T>
+const size_t* CompressedGraph<T>::adjacentBegin(const size_t index) const
+{
+    return targets.data() + offsets[index];
+}
+
+/**
+ * @brief Pointer following the last adjacent node of a node
+ * @param[in] index Index of the node
+ * @return Pointer following the index of the last adjacent node
+ */
+template <class T>
+const size_t* CompressedGraph<T>::adjacentEnd(const size_t index) const
+{
+    return targets.data() + offsets[index+1];
+}
+
+/**
+ * @brief Pointer to the weight of the edge towards the first adjacent
+ * node of a node
+ * @param[in] index Index of the node
+ * @return Pointer to the weight of the first edge
+ */
+template <class T>
+const double* CompressedGraph<T>::weightBegin(const size_t index) const
+{
+    return weights.data() + offsets[index];
+}
+
+/**
+ * @brief Get the offsets array
+ * @return Offsets of the adjacencies of each node, numNodes()+1 entries
+ */
+template <class T>
+const std::vector<size_t>& CompressedGraph<T>::getOffsets() const
+{
+    return offsets;
+}
+
+/**
+ * @brief Get the targets array
+ * @return Index of the adjacent nodes
+ */
+template <class T>
+const std::vector<size_t>& CompressedGraph<T>::getTargets() const
+{
+    return targets;
+}
+
+/**
+ * @brief Get the weights array
+ * @return Weight of the edges
+ */
+template <class T>
+const std::vector<double>& CompressedGraph<T>::getWeights() const
+{
+    return weights;
+}
+
+/**
+ * @brief Get the transposed graph, which has the same nodes (with the
+ * same indices) and the reversed edges. Backward searches run on it.
+ * @return Transposed graph
+ */
+template <class T>
+CompressedGraph<T> CompressedGraph<T>::transpose() const
+{
+    CompressedGraph<T> transposed;
+
+    transposed.directed = directed;
+    transposed.values = values;
+    transposed.graphIds = graphIds;
+    transposed.indexMap = indexMap;
+
+    //Count the incoming edges of each node
+    transposed.offsets.assign(numNodes() + 1, 0);
+    for (const size_t& target : targets) {
+        transposed.offsets[target + 1]++;
+    }
+    for (size_t i = 0; i < numNodes(); i++) {
+        transposed.offsets[i + 1] += transposed.offsets[i];
+    }
+
+    //Scatter the edges: sources are visited in order, so the
+    //adjacencies of the transposed graph are sorted by index
+    transposed.targets.resize(targets.size());
+    transposed.weights.resize(weights.size());
+    std::vector<size_t> position(transposed.offsets.begin(), transposed.offsets.end() - 1);
+    for (size_t i = 0; i < numNodes(); i++) {
+        for (size_t j = offsets[i]; j < offsets[i + 1]; j++) {
+            size_t p = position[targets[j]]++;
+            transposed.targets[p] = i;
+            transposed.weights[p] = weights[j];
+        }
+    }
+
+    return transposed;
+}
+
+/**
+ * @brief Clear the graph
+ */
+template <class T>
+void CompressedGraph<T>::clear()
+{
+    values.clear();
+    graphIds.clear();
+    indexMap.clear();
+    offsets.assign(1, 0);
+    targets.clear();
+    weights.clear();
+}
+
+}
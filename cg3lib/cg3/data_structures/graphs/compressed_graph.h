@@ -0,0 +1,88 @@
+/*
+ * This file is part of cg3lib: https://github.com/cg3hci/cg3lib
+ * This Source Code Form is subject to the terms of the GNU GPL 3.0
+ */
+#ifndef CG3_COMPRESSED_GRAPH_H
+#define CG3_COMPRESSED_GRAPH_H
+
+#include <vector>
+#include <limits>
+#include <cstddef>
+
+namespace cg3 {
+
+template <class T>
+class Graph;
+
+/**
+ * @brief Read-only snapshot of a Graph in compressed sparse row (CSR) form
+ *
+ * It is obtained by Graph::freeze(). Nodes are indexed from 0 to numNodes()-1
+ * (deleted nodes of the graph are skipped); the adjacent nodes of the node i
+ * are the targets in the range [offsets[i], offsets[i+1]), sorted by index,
+ * and the corresponding weights are in the same range of the weights array.
+ *
+ * Traversals iterate contiguous memory instead of the hash maps of the graph.
+ * The snapshot is not updated when the graph changes.
+ */
+template <class T>
+class CompressedGraph
+{
+public:
+
+    friend class Graph<T>;
+
+    /* Public const */
+
+    static constexpr double MAX_WEIGHT = std::numeric_limits<double>::max()/2;
+    static constexpr size_t NO_INDEX = std::numeric_limits<size_t>::max();
+
+
+    /* Constructors */
+
+    CompressedGraph();
+
+
+    /* Public methods */
+
+    size_t numNodes() const;
+    size_t numEdges() const;
+    bool isDirected() const;
+
+    const T& getValue(const size_t index) const;
+    size_t getGraphId(const size_t index) const;
+    size_t getIndex(const size_t graphId) const;
+
+    size_t degree(const size_t index) const;
+    const size_t* adjacentBegin(const size_t index) const;
+    const size_t* adjacentEnd(const size_t index) const;
+    const double* weightBegin(const size_t index) const;
+
+    const std::vector<size_t>& getOffsets() const;
+    const std::vector<size_t>& getTargets() const;
+    const std::vector<double>& getWeights() const;
+
+    CompressedGraph<T> transpose() const;
+
+    void clear();
+
+protected:
+
+    /* Protected fields */
+
+    bool directed; //True if the graph was directed
+
+    std::vector<T> values; //Value of each node
+    std::vector<size_t> graphIds; //Id of each node in the graph
+    std::vector<size_t> indexMap; //Index of each graph id, NO_INDEX for deleted nodes
+
+    std::vector<size_t> offsets; //First adjacency of each node (numNodes()+1 entries)
+    std::vector<size_t> targets; //Index of the adjacent nodes
+    std::vector<double> weights; //Weight of the edges
+};
+
+}
+
+#include "compressed_graph.cpp"
+
+#endif // CG3_COMPRESSED_GRAPH_H
@@ -8,6 +8,8 @@
 
 #include "assert.h"
 
+#include <algorithm>
+
 namespace cg3 {
 
 /* ----- CONST ----- */
@@ -532,6 +534,67 @@ void Graph<T>::recompact()
     this->nDeletedNodes = 0;
 }
 
+/**
+ * @brief Create a compressed sparse row snapshot of the graph.
+ * Deleted nodes and their adjacencies are skipped; the remaining nodes
+ * are indexed in the order of the node iterators. Graph algorithms
+ * accepting a CompressedGraph iterate its contiguous arrays instead of
+ * the adjacency hash maps.
+ * @return Compressed snapshot of the graph
+ */
+template <class T>
+CompressedGraph<T> Graph<T>::freeze() const
+{
+    CompressedGraph<T> compressed;
+
+    compressed.directed = (type == GraphType::DIRECTED);
+    compressed.indexMap.resize(nodes.size(), CompressedGraph<T>::NO_INDEX);
+
+    //Index of each node which has not been deleted
+    size_t numberOfNodes = 0;
+    size_t numberOfEdges = 0;
+    for (size_t i = 0; i < nodes.size(); i++) {
+        if (!isDeleted[i]) {
+            compressed.indexMap[i] = numberOfNodes;
+            numberOfNodes++;
+            numberOfEdges += nodes[i].adjacentNodes.size();
+        }
+    }
+
+    compressed.values.reserve(numberOfNodes);
+    compressed.graphIds.reserve(numberOfNodes);
+    compressed.offsets.reserve(numberOfNodes + 1);
+    compressed.targets.reserve(numberOfEdges);
+    compressed.weights.reserve(numberOfEdges);
+
+    std::vector<std::pair<size_t, double>> adjacencies;
+    for (size_t i = 0; i < nodes.size(); i++) {
+        if (!isDeleted[i]) {
+            const Node& node = nodes[i];
+
+            compressed.values.push_back(node.value);
+            compressed.graphIds.push_back(i);
+
+            //Adjacencies sorted by index, skipping the deleted nodes
+            adjacencies.clear();
+            for (const std::pair<const size_t, double>& adj : node.adjacentNodes) {
+                if (!isDeleted[adj.first]) {
+                    adjacencies.push_back(std::make_pair(compressed.indexMap[adj.first], adj.second));
+                }
+            }
+            std::sort(adjacencies.begin(), adjacencies.end());
+
+            for (const std::pair<size_t, double>& adj : adjacencies) {
+                compressed.targets.push_back(adj.first);
+                compressed.weights.push_back(adj.second);
+            }
+            compressed.offsets.push_back(compressed.targets.size());
+        }
+    }
+
+    return compressed;
+}
+
 /* ----- SERIALIZATION ----- */
 
 /**
@@ -16,6 +16,8 @@
 
 #include <cg3/io/serialize.h>
 
+#include "compressed_graph.h"
+
 #define NUMBER_DELETE_FOR_RECOMPACT 10000
 
 namespace cg3 {
@@ -126,6 +128,8 @@ public:
     void clear();
     void recompact();
 
+    CompressedGraph<T> freeze() const;
+
     // SerializableObject interface
     void serialize(std::ofstream& binaryFile) const;
     void deserialize(std::ifstream& binaryFile);
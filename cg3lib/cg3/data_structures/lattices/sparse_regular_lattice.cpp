@@ -0,0 +1,508 @@
+/*
+ * This file is part of cg3lib: https://github.com/cg3hci/cg3lib
+ * This Source Code Form is subject to the terms of the GNU GPL 3.0
+ */
+
+#include "sparse_regular_lattice.h"
+
+namespace cg3 {
+
+template <class VT>
+const unsigned int SparseRegularLattice3D<VT>::BLOCK_SIZE;
+
+template <class VT>
+const unsigned int SparseRegularLattice3D<VT>::NO_BLOCK;
+
+template <class VT>
+const unsigned int SparseRegularLattice3D<VT>::BLOCK_VOLUME;
+
+template <class VT>
+SparseRegularLattice3D<VT>::SparseRegularLattice3D() :
+    _unit(0),
+    _background()
+{
+    res.fill(0);
+}
+
+/**
+ * @brief Creates a sparse lattice on the given bounding box, with vertices at distance
+ * unit. The resolution is computed as in cg3::RegularLattice3D. No block is allocated:
+ * all the vertices have the background property.
+ *
+ * @param[in] bb: bounding box of the lattice
+ * @param[in] unit: distance between two adjacent vertices
+ * @param[in] background: property of the vertices of the inactive blocks
+ * @param[in] outsideBB: if true, the lattice may exceed the bounding box in order to cover it
+ */
+template<class VT>
+SparseRegularLattice3D<VT>::SparseRegularLattice3D(
+        const cg3::BoundingBox3& bb,
+        double unit,
+        const VT& background,
+        bool outsideBB) :
+    bb(bb),
+    _unit(unit),
+    _background(background)
+{
+    res[0] = bb.lengthX() / unit;
+    if (outsideBB || std::fmod(bb.lengthX(), unit) == 0)
+        res[0]++;
+    res[1] = bb.lengthY() / unit;
+    if (outsideBB || std::fmod(bb.lengthY(), unit) == 0)
+        res[1]++;
+    res[2] = bb.lengthZ() / unit;
+    if (outsideBB || std::fmod(bb.lengthZ(), unit) == 0)
+        res[2]++;
+    this->bb.max() = Point3d(
+                bb.minX() + unit * (res[0]-1),
+                bb.minY() + unit * (res[1]-1),
+                bb.minZ() + unit * (res[2]-1));
+    blockIndices = cg3::Array3D<unsigned int>(
+                (res[0] + BLOCK_SIZE - 1) / BLOCK_SIZE,
+                (res[1] + BLOCK_SIZE - 1) / BLOCK_SIZE,
+                (res[2] + BLOCK_SIZE - 1) / BLOCK_SIZE,
+                NO_BLOCK);
+}
+
+template<class VT>
+unsigned int SparseRegularLattice3D<VT>::resX() const
+{
+    return res[0];
+}
+
+template<class VT>
+unsigned int SparseRegularLattice3D<VT>::resY() const
+{
+    return res[1];
+}
+
+template<class VT>
+unsigned int SparseRegularLattice3D<VT>::resZ() const
+{
+    return res[2];
+}
+
+template<class VT>
+const BoundingBox3& SparseRegularLattice3D<VT>::boundingBox() const
+{
+    return bb;
+}
+
+template<class VT>
+double SparseRegularLattice3D<VT>::unit() const
+{
+    return _unit;
+}
+
+/**
+ * @brief Returns the property of the vertices of the inactive blocks
+ */
+template<class VT>
+const VT& SparseRegularLattice3D<VT>::background() const
+{
+    return _background;
+}
+
+template<class VT>
+Point3d SparseRegularLattice3D<VT>::vertex(
+        unsigned int i,
+        unsigned int j,
+        unsigned int k) const
+{
+    return cg3::Point3d(bb.minX() + i*_unit,
+                        bb.minY() + j*_unit,
+                        bb.minZ() + k*_unit);
+}
+
+template<class VT>
+Point3d SparseRegularLattice3D<VT>::nearestVertex(const Point3d& p) const
+{
+    return cg3::Point3d(bb.minX() + indexOfCoordinateX(p.x())*_unit,
+                        bb.minY() + indexOfCoordinateY(p.y())*_unit,
+                        bb.minZ() + indexOfCoordinateZ(p.z())*_unit);
+}
+
+/**
+ * @brief Returns the property of the vertex (i,j,k), which is the background
+ * if its block is not active.
+ */
+template<class VT>
+VT SparseRegularLattice3D<VT>::vertexProperty(
+        unsigned int i,
+        unsigned int j,
+        unsigned int k) const
+{
+    assert(i < res[0]);
+    assert(j < res[1]);
+    assert(k < res[2]);
+    unsigned int b = blockIndices(i / BLOCK_SIZE, j / BLOCK_SIZE, k / BLOCK_SIZE);
+    if (b == NO_BLOCK)
+        return _background;
+    return properties[(unsigned long int)b * BLOCK_VOLUME + localIndex(i, j, k)];
+}
+
+/**
+ * @brief Returns a reference to the property of the vertex (i,j,k).
+ * The block of the vertex is activated if it was not active.
+ */
+template<class VT>
+VT& SparseRegularLattice3D<VT>::vertexProperty(
+        unsigned int i,
+        unsigned int j,
+        unsigned int k)
+{
+    assert(i < res[0]);
+    assert(j < res[1]);
+    assert(k < res[2]);
+    unsigned int b = activateBlock(i / BLOCK_SIZE, j / BLOCK_SIZE, k / BLOCK_SIZE);
+    return properties[(unsigned long int)b * BLOCK_VOLUME + localIndex(i, j, k)];
+}
+
+template<class VT>
+VT SparseRegularLattice3D<VT>::vertexProperty(const Point3d& p) const
+{
+    return vertexProperty(
+                indexOfCoordinateX(p.x()),
+                indexOfCoordinateY(p.y()),
+                indexOfCoordinateZ(p.z()));
+}
+
+template<class VT>
+VT& SparseRegularLattice3D<VT>::vertexProperty(const Point3d& p)
+{
+    return vertexProperty(
+                indexOfCoordinateX(p.x()),
+                indexOfCoordinateY(p.y()),
+                indexOfCoordinateZ(p.z()));
+}
+
+template<class VT>
+void SparseRegularLattice3D<VT>::setVertexProperty(const Point3d& p, const VT& property)
+{
+    setVertexProperty(
+                indexOfCoordinateX(p.x()),
+                indexOfCoordinateY(p.y()),
+                indexOfCoordinateZ(p.z()),
+                property);
+}
+
+/**
+ * @brief Sets the property of the vertex (i,j,k). The block of the vertex is activated
+ * if it was not active, unless the property is equal to the background.
+ */
+template<class VT>
+void SparseRegularLattice3D<VT>::setVertexProperty(
+        unsigned int i,
+        unsigned int j,
+        unsigned int k,
+        const VT& property)
+{
+    assert(i < res[0]);
+    assert(j < res[1]);
+    assert(k < res[2]);
+    unsigned int b = blockIndices(i / BLOCK_SIZE, j / BLOCK_SIZE, k / BLOCK_SIZE);
+    if (b == NO_BLOCK){
+        if (property == _background)
+            return;
+        b = activateBlock(i / BLOCK_SIZE, j / BLOCK_SIZE, k / BLOCK_SIZE);
+    }
+    properties[(unsigned long int)b * BLOCK_VOLUME + localIndex(i, j, k)] = property;
+}
+
+/**
+ * @brief Returns the number of blocks along the x axis
+ */
+template<class VT>
+unsigned int SparseRegularLattice3D<VT>::blockResX() const
+{
+    return blockIndices.sizeX();
+}
+
+/**
+ * @brief Returns the number of blocks along the y axis
+ */
+template<class VT>
+unsigned int SparseRegularLattice3D<VT>::blockResY() const
+{
+    return blockIndices.sizeY();
+}
+
+/**
+ * @brief Returns the number of blocks along the z axis
+ */
+template<class VT>
+unsigned int SparseRegularLattice3D<VT>::blockResZ() const
+{
+    return blockIndices.sizeZ();
+}
+
+/**
+ * @brief Returns true if the block (bi, bj, bk), containing the vertices from
+ * (bi, bj, bk)*BLOCK_SIZE to (bi+1, bj+1, bk+1)*BLOCK_SIZE (excluded), is allocated.
+ */
+template<class VT>
+bool SparseRegularLattice3D<VT>::isActiveBlock(unsigned int bi, unsigned int bj, unsigned int bk) const
+{
+    return blockIndices(bi, bj, bk) != NO_BLOCK;
+}
+
+template<class VT>
+unsigned int SparseRegularLattice3D<VT>::numberActiveBlocks() const
+{
+    return blockIds.size();
+}
+
+/**
+ * @brief Deactivates all the blocks whose vertices have all the background property,
+ * releasing their memory. The remaining blocks are compacted, keeping their order.
+ */
+template<class VT>
+void SparseRegularLattice3D<VT>::prune()
+{
+    unsigned int n = 0;
+    unsigned int* indices = blockIndices.cArray();
+    for (unsigned int b = 0; b < blockIds.size(); b++){
+        typename std::vector<VT>::iterator first = properties.begin() + (unsigned long int)b * BLOCK_VOLUME;
+        bool empty = true;
+        for (unsigned int i = 0; i < BLOCK_VOLUME && empty; i++)
+            if (!(first[i] == _background))
+                empty = false;
+        if (empty){
+            indices[blockIds[b]] = NO_BLOCK;
+        }
+        else {
+            if (n != b){
+                std::copy(first, first + BLOCK_VOLUME, properties.begin() + (unsigned long int)n * BLOCK_VOLUME);
+                blockIds[n] = blockIds[b];
+                indices[blockIds[n]] = n;
+            }
+            n++;
+        }
+    }
+    blockIds.resize(n);
+    properties.resize((unsigned long int)n * BLOCK_VOLUME);
+    blockIds.shrink_to_fit();
+    properties.shrink_to_fit();
+}
+
+/**
+ * @brief Serializes the lattice: only the active blocks are stored.
+ */
+template<class VT>
+void SparseRegularLattice3D<VT>::serialize(std::ofstream& binaryFile) const
+{
+    cg3::serializeObjectAttributes(
+                "cg3SparseRegularLattice3D",
+                binaryFile,
+                bb,
+                _unit,
+                _background,
+                res,
+                blockIds,
+                properties);
+}
+
+template<class VT>
+void SparseRegularLattice3D<VT>::deserialize(std::ifstream& binaryFile)
+{
+    cg3::deserializeObjectAttributes(
+                "cg3SparseRegularLattice3D",
+                binaryFile,
+                bb,
+                _unit,
+                _background,
+                res,
+                blockIds,
+                properties);
+    blockIndices = cg3::Array3D<unsigned int>(
+                (res[0] + BLOCK_SIZE - 1) / BLOCK_SIZE,
+                (res[1] + BLOCK_SIZE - 1) / BLOCK_SIZE,
+                (res[2] + BLOCK_SIZE - 1) / BLOCK_SIZE,
+                NO_BLOCK);
+    unsigned int* indices = blockIndices.cArray();
+    for (unsigned int b = 0; b < blockIds.size(); b++)
+        indices[blockIds[b]] = b;
+}
+
+template<class VT>
+typename SparseRegularLattice3D<VT>::VertexIterator SparseRegularLattice3D<VT>::vertexBegin() const
+{
+    return VertexIterator(nextPosition((unsigned long int)-1), *this);
+}
+
+template<class VT>
+typename SparseRegularLattice3D<VT>::VertexIterator SparseRegularLattice3D<VT>::vertexEnd() const
+{
+    return VertexIterator(endPosition(), *this);
+}
+
+template<class VT>
+typename SparseRegularLattice3D<VT>::PropertyIterator SparseRegularLattice3D<VT>::propertyBegin()
+{
+    return PropertyIterator(nextPosition((unsigned long int)-1), *this);
+}
+
+template<class VT>
+typename SparseRegularLattice3D<VT>::PropertyIterator SparseRegularLattice3D<VT>::propertyEnd()
+{
+    return PropertyIterator(endPosition(), *this);
+}
+
+template<class VT>
+typename SparseRegularLattice3D<VT>::ConstPropertyIterator SparseRegularLattice3D<VT>::propertyBegin() const
+{
+    return ConstPropertyIterator(nextPosition((unsigned long int)-1), *this);
+}
+
+template<class VT>
+typename SparseRegularLattice3D<VT>::ConstPropertyIterator SparseRegularLattice3D<VT>::propertyEnd() const
+{
+    return ConstPropertyIterator(endPosition(), *this);
+}
+
+template<class VT>
+typename SparseRegularLattice3D<VT>::Iterator SparseRegularLattice3D<VT>::begin()
+{
+    return Iterator(nextPosition((unsigned long int)-1), *this);
+}
+
+template<class VT>
+typename SparseRegularLattice3D<VT>::Iterator SparseRegularLattice3D<VT>::end()
+{
+    return Iterator(endPosition(), *this);
+}
+
+template<class VT>
+typename SparseRegularLattice3D<VT>::ConstIterator SparseRegularLattice3D<VT>::begin() const
+{
+    return ConstIterator(nextPosition((unsigned long int)-1), *this);
+}
+
+template<class VT>
+typename SparseRegularLattice3D<VT>::ConstIterator SparseRegularLattice3D<VT>::end() const
+{
+    return ConstIterator(endPosition(), *this);
+}
+
+template<class VT>
+Point3d SparseRegularLattice3D<VT>::vertex(unsigned long int pos) const
+{
+    Point3i ids = reverseIndex(pos);
+    return vertex(ids.x(), ids.y(), ids.z());
+}
+
+template<class VT>
+VT& SparseRegularLattice3D<VT>::property(unsigned long int pos)
+{
+    return properties[pos];
+}
+
+template<class VT>
+VT SparseRegularLattice3D<VT>::property(unsigned long int pos) const
+{
+    return properties[pos];
+}
+
+/**
+ * @brief Returns the indices (i,j,k) of the vertex stored at the position pos
+ * of the properties.
+ */
+template<class VT>
+Point3i SparseRegularLattice3D<VT>::reverseIndex(unsigned long int pos) const
+{
+    assert(pos < endPosition());
+    unsigned int block = blockIds[pos / BLOCK_VOLUME];
+    unsigned int local = pos % BLOCK_VOLUME;
+    Point3i ids;
+    ids.z() = (block % blockIndices.sizeZ()) * BLOCK_SIZE + local % BLOCK_SIZE;
+    block /= blockIndices.sizeZ();
+    local /= BLOCK_SIZE;
+    ids.y() = (block % blockIndices.sizeY()) * BLOCK_SIZE + local % BLOCK_SIZE;
+    block /= blockIndices.sizeY();
+    local /= BLOCK_SIZE;
+    ids.x() = block * BLOCK_SIZE + local;
+    return ids;
+}
+
+/**
+ * @brief Returns false if the position pos corresponds to a vertex that is outside the
+ * lattice (blocks on the boundary may exceed the resolution of the lattice).
+ */
+template<class VT>
+bool SparseRegularLattice3D<VT>::isValidPosition(unsigned long int pos) const
+{
+    Point3i ids = reverseIndex(pos);
+    return (unsigned int)ids.x() < res[0] && (unsigned int)ids.y() < res[1] && (unsigned int)ids.z() < res[2];
+}
+
+template<class VT>
+unsigned long int SparseRegularLattice3D<VT>::nextPosition(unsigned long int pos) const
+{
+    const unsigned long int end = endPosition();
+    do {
+        ++pos;
+    } while (pos < end && !isValidPosition(pos));
+    return pos;
+}
+
+template<class VT>
+unsigned long int SparseRegularLattice3D<VT>::previousPosition(unsigned long int pos) const
+{
+    do {
+        --pos;
+    } while (pos > 0 && !isValidPosition(pos));
+    return pos;
+}
+
+template<class VT>
+unsigned long int SparseRegularLattice3D<VT>::endPosition() const
+{
+    return (unsigned long int)blockIds.size() * BLOCK_VOLUME;
+}
+
+/**
+ * @brief Returns the index of the block (bi,bj,bk), allocating it if it is not active.
+ */
+template<class VT>
+unsigned int SparseRegularLattice3D<VT>::activateBlock(unsigned int bi, unsigned int bj, unsigned int bk)
+{
+    unsigned int& b = blockIndices(bi, bj, bk);
+    if (b == NO_BLOCK){
+        b = blockIds.size();
+        blockIds.push_back((bi * blockIndices.sizeY() + bj) * blockIndices.sizeZ() + bk);
+        properties.resize(properties.size() + BLOCK_VOLUME, _background);
+    }
+    return b;
+}
+
+/**
+ * @brief Position of the vertex (i,j,k) inside its block
+ */
+template<class VT>
+unsigned long int SparseRegularLattice3D<VT>::localIndex(unsigned int i, unsigned int j, unsigned int k) const
+{
+    return ((i % BLOCK_SIZE) * BLOCK_SIZE + (j % BLOCK_SIZE)) * BLOCK_SIZE + (k % BLOCK_SIZE);
+}
+
+template<class VT>
+uint SparseRegularLattice3D<VT>::indexOfCoordinateX(double x) const
+{
+    double deltax = x - bb.minX();
+    return (deltax * (res[0]-1)) / bb.lengthX();
+}
+
+template<class VT>
+uint SparseRegularLattice3D<VT>::indexOfCoordinateY(double y) const
+{
+    double deltay = y - bb.minY();
+    return (deltay * (res[1]-1)) / bb.lengthY();
+}
+
+template<class VT>
+uint SparseRegularLattice3D<VT>::indexOfCoordinateZ(double z) const
+{
+    double deltaz = z - bb.minZ();
+    return (deltaz * (res[2]-1)) / bb.lengthZ();
+}
+
+}
@@ -0,0 +1,120 @@
+/*
+ * This file is part of cg3lib: https://github.com/cg3hci/cg3lib
+ * This Source Code Form is subject to the terms of the GNU GPL 3.0
+ */
+
+#ifndef CG3_SPARSE_REGULAR_LATTICE_H
+#define CG3_SPARSE_REGULAR_LATTICE_H
+
+#include <cg3/geometry/bounding_box3.h>
+#include <cg3/data_structures/arrays/array3d.h>
+
+namespace cg3 {
+
+/**
+ * @brief Regular lattice with the same interface of cg3::RegularLattice3D, whose vertex
+ * properties are stored in blocks of BLOCK_SIZE^3 vertices allocated only where needed.
+ *
+ * All the vertices of a block that has not been allocated (inactive block) have the
+ * background property given on construction. A block is allocated (activated) when one of
+ * its properties is set or accessed by non-const reference, and its properties are
+ * initialized to the background. A dense array of block indices (one unsigned int
+ * every BLOCK_SIZE^3 vertices) allows to access every vertex in constant time.
+ *
+ * Iterators visit only the vertices of the active blocks, block by block in order of
+ * activation. References to properties are invalidated when a new block is activated.
+ */
+template <class VT>
+class SparseRegularLattice3D : public cg3::SerializableObject
+{
+public:
+
+    //iterators
+    class VertexIterator;
+    class PropertyIterator;
+    class ConstPropertyIterator;
+    class Iterator;
+    class ConstIterator;
+
+    static const unsigned int BLOCK_SIZE = 8;
+
+    SparseRegularLattice3D();
+    SparseRegularLattice3D(
+            const cg3::BoundingBox3& bb,
+            double unit,
+            const VT& background = VT(),
+            bool outsideBB = true);
+
+    unsigned int resX() const;
+    unsigned int resY() const;
+    unsigned int resZ() const;
+
+    const cg3::BoundingBox3& boundingBox() const;
+    double unit() const;
+    const VT& background() const;
+
+    cg3::Point3d vertex(unsigned int i, unsigned int j, unsigned int k) const;
+    cg3::Point3d nearestVertex(const cg3::Point3d& p) const;
+    VT vertexProperty(unsigned int i, unsigned int j, unsigned int k) const;
+    VT& vertexProperty(unsigned int i, unsigned int j, unsigned int k);
+    VT vertexProperty(const cg3::Point3d& p) const;
+    VT& vertexProperty(const cg3::Point3d& p);
+    void setVertexProperty(const cg3::Point3d& p, const VT& property);
+    void setVertexProperty(unsigned int i, unsigned int j, unsigned int k, const VT& property);
+
+    unsigned int blockResX() const;
+    unsigned int blockResY() const;
+    unsigned int blockResZ() const;
+    bool isActiveBlock(unsigned int bi, unsigned int bj, unsigned int bk) const;
+    unsigned int numberActiveBlocks() const;
+    void prune();
+
+    // SerializableObject interface
+    void serialize(std::ofstream& binaryFile) const;
+    void deserialize(std::ifstream& binaryFile);
+
+    VertexIterator vertexBegin() const;
+    VertexIterator vertexEnd() const;
+    PropertyIterator propertyBegin();
+    PropertyIterator propertyEnd();
+    ConstPropertyIterator propertyBegin() const;
+    ConstPropertyIterator propertyEnd() const;
+    Iterator begin();
+    Iterator end();
+    ConstIterator begin() const;
+    ConstIterator end() const;
+
+protected:
+    static const unsigned int NO_BLOCK = (unsigned int)-1;
+    static const unsigned int BLOCK_VOLUME = BLOCK_SIZE * BLOCK_SIZE * BLOCK_SIZE;
+
+    cg3::Point3d vertex(unsigned long int pos) const;
+    VT& property(unsigned long int pos);
+    VT property(unsigned long int pos) const;
+    cg3::Point3i reverseIndex(unsigned long int pos) const;
+    bool isValidPosition(unsigned long int pos) const;
+    unsigned long int nextPosition(unsigned long int pos) const;
+    unsigned long int previousPosition(unsigned long int pos) const;
+    unsigned long int endPosition() const;
+
+    unsigned int activateBlock(unsigned int bi, unsigned int bj, unsigned int bk);
+    unsigned long int localIndex(unsigned int i, unsigned int j, unsigned int k) const;
+    uint indexOfCoordinateX(double x) const;
+    uint indexOfCoordinateY(double y) const;
+    uint indexOfCoordinateZ(double z) const;
+
+    cg3::BoundingBox3 bb;
+    double _unit;
+    VT _background;
+    std::array<unsigned int, 3> res;
+    cg3::Array3D<unsigned int> blockIndices;
+    std::vector<unsigned int> blockIds; //linear index, in blockIndices, of every active block
+    std::vector<VT> properties;
+};
+
+} //namespace cg3
+
+#include "sparse_regular_lattice_iterators.h"
+#include "sparse_regular_lattice.cpp"
+
+#endif // CG3_SPARSE_REGULAR_LATTICE_H
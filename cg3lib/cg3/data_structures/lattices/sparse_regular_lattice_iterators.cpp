@@ -0,0 +1,338 @@
+/*
+ * This file is part of cg3lib: https://github.com/cg3hci/cg3lib
+ * This Source Code Form is subject to the terms of the GNU GPL 3.0
+ */
+#include "sparse_regular_lattice_iterators.h"
+
+namespace cg3 {
+
+template<class VT>
+cg3::SparseRegularLattice3D<VT>::VertexIterator::VertexIterator() : l(nullptr), pos(0)
+{
+}
+
+template<class VT>
+Point3d cg3::SparseRegularLattice3D<VT>::VertexIterator::operator *() const
+{
+    return l->vertex(pos);
+}
+
+template<class VT>
+const Point3d* cg3::SparseRegularLattice3D<VT>::VertexIterator::operator ->() const
+{
+    tmp = l->vertex(pos);
+    return &tmp;
+}
+
+template<class VT>
+bool cg3::SparseRegularLattice3D<VT>::VertexIterator::operator ==(const cg3::SparseRegularLattice3D<VT>::VertexIterator& otherIterator) const
+{
+    return l == otherIterator.l && pos == otherIterator.pos;
+}
+
+template<class VT>
+bool cg3::SparseRegularLattice3D<VT>::VertexIterator::operator !=(const cg3::SparseRegularLattice3D<VT>::VertexIterator& otherIterator) const
+{
+    return l != otherIterator.l || pos != otherIterator.pos;
+}
+
+template<class VT>
+typename cg3::SparseRegularLattice3D<VT>::VertexIterator cg3::SparseRegularLattice3D<VT>::VertexIterator::operator ++()
+{
+    pos = l->nextPosition(pos);
+    return *this;
+}
+
+template<class VT>
+typename cg3::SparseRegularLattice3D<VT>::VertexIterator cg3::SparseRegularLattice3D<VT>::VertexIterator::operator ++(int)
+{
+    VertexIterator old = *this;
+    pos = l->nextPosition(pos);
+    return old;
+}
+
+template<class VT>
+typename cg3::SparseRegularLattice3D<VT>::VertexIterator cg3::SparseRegularLattice3D<VT>::VertexIterator::operator --()
+{
+    pos = l->previousPosition(pos);
+    return *this;
+}
+
+template<class VT>
+typename cg3::SparseRegularLattice3D<VT>::VertexIterator cg3::SparseRegularLattice3D<VT>::VertexIterator::operator --(int)
+{
+    VertexIterator old = *this;
+    pos = l->previousPosition(pos);
+    return old;
+}
+
+template<class VT>
+cg3::SparseRegularLattice3D<VT>::VertexIterator::VertexIterator(unsigned long int pos, const SparseRegularLattice3D<VT>& g) :
+    l(&g), pos(pos)
+{
+}
+
+template<class VT>
+cg3::SparseRegularLattice3D<VT>::PropertyIterator::PropertyIterator() : l(nullptr), pos(0)
+{
+}
+
+template<class VT>
+VT& cg3::SparseRegularLattice3D<VT>::PropertyIterator::operator *() const
+{
+    return l->property(pos);
+}
+
+template<class VT>
+VT* cg3::SparseRegularLattice3D<VT>::PropertyIterator::operator ->() const
+{
+    return &(l->property(pos));
+}
+
+template<class VT>
+bool cg3::SparseRegularLattice3D<VT>::PropertyIterator::operator ==(const cg3::SparseRegularLattice3D<VT>::PropertyIterator& otherIterator) const
+{
+    return l == otherIterator.l && pos == otherIterator.pos;
+}
+
+template<class VT>
+bool cg3::SparseRegularLattice3D<VT>::PropertyIterator::operator !=(const cg3::SparseRegularLattice3D<VT>::PropertyIterator& otherIterator) const
+{
+    return l != otherIterator.l || pos != otherIterator.pos;
+}
+
+template<class VT>
+typename cg3::SparseRegularLattice3D<VT>::PropertyIterator cg3::SparseRegularLattice3D<VT>::PropertyIterator::operator ++()
+{
+    pos = l->nextPosition(pos);
+    return *this;
+}
+
+template<class VT>
+typename cg3::SparseRegularLattice3D<VT>::PropertyIterator cg3::SparseRegularLattice3D<VT>::PropertyIterator::operator ++(int)
+{
+    PropertyIterator old = *this;
+    pos = l->nextPosition(pos);
+    return old;
+}
+
+template<class VT>
+typename cg3::SparseRegularLattice3D<VT>::PropertyIterator cg3::SparseRegularLattice3D<VT>::PropertyIterator::operator --()
+{
+    pos = l->previousPosition(pos);
+    return *this;
+}
+
+template<class VT>
+typename cg3::SparseRegularLattice3D<VT>::PropertyIterator cg3::SparseRegularLattice3D<VT>::PropertyIterator::operator --(int)
+{
+    PropertyIterator old = *this;
+    pos = l->previousPosition(pos);
+    return old;
+}
+
+template<class VT>
+cg3::SparseRegularLattice3D<VT>::PropertyIterator::PropertyIterator(unsigned long int pos, SparseRegularLattice3D<VT>& g) :
+    l(&g), pos(pos)
+{
+}
+
+template<class VT>
+cg3::SparseRegularLattice3D<VT>::ConstPropertyIterator::ConstPropertyIterator() : l(nullptr), pos(0)
+{
+}
+
+template<class VT>
+VT cg3::SparseRegularLattice3D<VT>::ConstPropertyIterator::operator *() const
+{
+    return l->property(pos);
+}
+
+template<class VT>
+const VT* cg3::SparseRegularLattice3D<VT>::ConstPropertyIterator::operator ->() const
+{
+    tmp = l->property(pos);
+    return &tmp;
+}
+
+template<class VT>
+bool cg3::SparseRegularLattice3D<VT>::ConstPropertyIterator::operator ==(const cg3::SparseRegularLattice3D<VT>::ConstPropertyIterator& otherIterator) const
+{
+    return l == otherIterator.l && pos == otherIterator.pos;
+}
+
+template<class VT>
+bool cg3::SparseRegularLattice3D<VT>::ConstPropertyIterator::operator !=(const cg3::SparseRegularLattice3D<VT>::ConstPropertyIterator& otherIterator) const
+{
+    return l != otherIterator.l || pos != otherIterator.pos;
+}
+
+template<class VT>
+typename cg3::SparseRegularLattice3D<VT>::ConstPropertyIterator cg3::SparseRegularLattice3D<VT>::ConstPropertyIterator::operator ++()
+{
+    pos = l->nextPosition(pos);
+    return *this;
+}
+
+template<class VT>
+typename cg3::SparseRegularLattice3D<VT>::ConstPropertyIterator cg3::SparseRegularLattice3D<VT>::ConstPropertyIterator::operator ++(int)
+{
+    ConstPropertyIterator old = *this;
+    pos = l->nextPosition(pos);
+    return old;
+}
+
+template<class VT>
+typename cg3::SparseRegularLattice3D<VT>::ConstPropertyIterator cg3::SparseRegularLattice3D<VT>::ConstPropertyIterator::operator --()
+{
+    pos = l->previousPosition(pos);
+    return *this;
+}
+
+template<class VT>
+typename cg3::SparseRegularLattice3D<VT>::ConstPropertyIterator cg3::SparseRegularLattice3D<VT>::ConstPropertyIterator::operator --(int)
+{
+    ConstPropertyIterator old = *this;
+    pos = l->previousPosition(pos);
+    return old;
+}
+
+template<class VT>
+cg3::SparseRegularLattice3D<VT>::ConstPropertyIterator::ConstPropertyIterator(unsigned long int pos, const SparseRegularLattice3D<VT>& g) :
+    l(&g), pos(pos)
+{
+}
+
+template<class VT>
+cg3::SparseRegularLattice3D<VT>::Iterator::Iterator() : l(nullptr), pos(0)
+{
+}
+
+template<class VT>
+std::pair<Point3d, VT&> cg3::SparseRegularLattice3D<VT>::Iterator::operator *() const
+{
+    return std::pair<Point3d, VT&>(l->vertex(pos), l->property(pos));
+}
+
+template<class VT>
+std::pair<Point3d, VT&>* cg3::SparseRegularLattice3D<VT>::Iterator::operator ->() const
+{
+    tmpp = std::make_shared<std::pair<Point3d, VT&>>(l->vertex(pos), l->property(pos));
+    return tmpp.get();
+}
+
+template<class VT>
+bool cg3::SparseRegularLattice3D<VT>::Iterator::operator ==(const cg3::SparseRegularLattice3D<VT>::Iterator& otherIterator) const
+{
+    return l == otherIterator.l && pos == otherIterator.pos;
+}
+
+template<class VT>
+bool cg3::SparseRegularLattice3D<VT>::Iterator::operator !=(const cg3::SparseRegularLattice3D<VT>::Iterator& otherIterator) const
+{
+    return l != otherIterator.l || pos != otherIterator.pos;
+}
+
+template<class VT>
+typename cg3::SparseRegularLattice3D<VT>::Iterator cg3::SparseRegularLattice3D<VT>::Iterator::operator ++()
+{
+    pos = l->nextPosition(pos);
+    return *this;
+}
+
+template<class VT>
+typename cg3::SparseRegularLattice3D<VT>::Iterator cg3::SparseRegularLattice3D<VT>::Iterator::operator ++(int)
+{
+    Iterator old = *this;
+    pos = l->nextPosition(pos);
+    return old;
+}
+
+template<class VT>
+typename cg3::SparseRegularLattice3D<VT>::Iterator cg3::SparseRegularLattice3D<VT>::Iterator::operator --()
+{
+    pos = l->previousPosition(pos);
+    return *this;
+}
+
+template<class VT>
+typename cg3::SparseRegularLattice3D<VT>::Iterator cg3::SparseRegularLattice3D<VT>::Iterator::operator --(int)
+{
+    Iterator old = *this;
+    pos = l->previousPosition(pos);
+    return old;
+}
+
+template<class VT>
+cg3::SparseRegularLattice3D<VT>::Iterator::Iterator(unsigned long int pos, SparseRegularLattice3D<VT>& g) :
+    l(&g), pos(pos)
+{
+}
+
+template<class VT>
+cg3::SparseRegularLattice3D<VT>::ConstIterator::ConstIterator() : l(nullptr), pos(0)
+{
+}
+
+template<class VT>
+std::pair<Point3d, VT> cg3::SparseRegularLattice3D<VT>::ConstIterator::operator *() const
+{
+    return std::pair<Point3d, VT>(l->vertex(pos), l->property(pos));
+}
+
+template<class VT>
+const std::pair<Point3d, VT>* cg3::SparseRegularLattice3D<VT>::ConstIterator::operator ->() const
+{
+    tmpp = std::pair<Point3d, VT>(l->vertex(pos), l->property(pos));
+    return &tmpp;
+}
+
+template<class VT>
+bool cg3::SparseRegularLattice3D<VT>::ConstIterator::operator ==(const cg3::SparseRegularLattice3D<VT>::ConstIterator& otherIterator) const
+{
+    return l == otherIterator.l && pos == otherIterator.pos;
+}
+
+template<class VT>
+bool cg3::SparseRegularLattice3D<VT>::ConstIterator::operator !=(const cg3::SparseRegularLattice3D<VT>::ConstIterator& otherIterator) const
+{
+    return l != otherIterator.l || pos != otherIterator.pos;
+}
+
+template<class VT>
+typename cg3::SparseRegularLattice3D<VT>::ConstIterator cg3::SparseRegularLattice3D<VT>::ConstIterator::operator ++()
+{
+    pos = l->nextPosition(pos);
+    return *this;
+}
+
+template<class VT>
+typename cg3::SparseRegularLattice3D<VT>::ConstIterator cg3::SparseRegularLattice3D<VT>::ConstIterator::operator ++(int)
+{
+    ConstIterator old = *this;
+    pos = l->nextPosition(pos);
+    return old;
+}
+
+template<class VT>
+typename cg3::SparseRegularLattice3D<VT>::ConstIterator cg3::SparseRegularLattice3D<VT>::ConstIterator::operator --()
+{
+    pos = l->previousPosition(pos);
+    return *this;
+}
+
+template<class VT>
+typename cg3::SparseRegularLattice3D<VT>::ConstIterator cg3::SparseRegularLattice3D<VT>::ConstIterator::operator --(int)
+{
+    ConstIterator old = *this;
+    pos = l->previousPosition(pos);
+    return old;
+}
+
+template<class VT>
+cg3::SparseRegularLattice3D<VT>::ConstIterator::ConstIterator(unsigned long int pos, const SparseRegularLattice3D<VT>& g) :
+    l(&g), pos(pos)
+{
+}
+
+} //namespace cg3
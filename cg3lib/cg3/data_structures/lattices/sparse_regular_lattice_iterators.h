@@ -0,0 +1,139 @@
+/*
+ * This file is part of cg3lib: https://github.com/cg3hci/cg3lib
+ * This Source Code Form is subject to the terms of the GNU GPL 3.0
+ */
+
+#ifndef CG3_SPARSE_REGULAR_LATTICE_ITERATORS_H
+#define CG3_SPARSE_REGULAR_LATTICE_ITERATORS_H
+
+#include <memory>
+
+namespace cg3 {
+
+template <class VT>
+class SparseRegularLattice3D;
+
+template <class VT>
+class SparseRegularLattice3D<VT>::VertexIterator
+{
+    friend class SparseRegularLattice3D;
+public:
+    VertexIterator();
+
+    Point3d operator *() const;
+    const Point3d* operator ->() const;
+    bool operator == (const VertexIterator& otherIterator) const;
+    bool operator != (const VertexIterator& otherIterator) const;
+
+    VertexIterator operator ++ ();
+    VertexIterator operator ++ (int);
+    VertexIterator operator -- ();
+    VertexIterator operator -- (int);
+
+protected:
+    mutable Point3d tmp;
+    const SparseRegularLattice3D<VT>* l;
+    unsigned long int pos;
+    VertexIterator(unsigned long int pos, const SparseRegularLattice3D<VT>& g);
+};
+
+template <class VT>
+class SparseRegularLattice3D<VT>::PropertyIterator
+{
+    friend class SparseRegularLattice3D;
+public:
+    PropertyIterator();
+
+    VT& operator *() const;
+    VT* operator ->() const;
+    bool operator == (const PropertyIterator& otherIterator) const;
+    bool operator != (const PropertyIterator& otherIterator) const;
+
+    PropertyIterator operator ++ ();
+    PropertyIterator operator ++ (int);
+    PropertyIterator operator -- ();
+    PropertyIterator operator -- (int);
+
+protected:
+    SparseRegularLattice3D<VT>* l;
+    unsigned long int pos;
+    PropertyIterator(unsigned long int pos, SparseRegularLattice3D<VT>& g);
+};
+
+template <class VT>
+class SparseRegularLattice3D<VT>::ConstPropertyIterator
+{
+    friend class SparseRegularLattice3D;
+public:
+    ConstPropertyIterator();
+
+    VT operator *() const;
+    const VT* operator ->() const;
+    bool operator == (const ConstPropertyIterator& otherIterator) const;
+    bool operator != (const ConstPropertyIterator& otherIterator) const;
+
+    ConstPropertyIterator operator ++ ();
+    ConstPropertyIterator operator ++ (int);
+    ConstPropertyIterator operator -- ();
+    ConstPropertyIterator operator -- (int);
+
+protected:
+    mutable VT tmp;
+    const SparseRegularLattice3D<VT>* l;
+    unsigned long int pos;
+    ConstPropertyIterator(unsigned long int pos, const SparseRegularLattice3D<VT>& g);
+};
+
+template <class VT>
+class SparseRegularLattice3D<VT>::Iterator
+{
+    friend class SparseRegularLattice3D;
+public:
+    Iterator();
+
+    std::pair<Point3d, VT&> operator *() const;
+    std::pair<Point3d, VT&>* operator ->() const;
+    bool operator == (const Iterator& otherIterator) const;
+    bool operator != (const Iterator& otherIterator) const;
+
+    Iterator operator ++ ();
+    Iterator operator ++ (int);
+    Iterator operator -- ();
+    Iterator operator -- (int);
+
+protected:
+    mutable std::shared_ptr<std::pair<Point3d, VT&>> tmpp;
+    SparseRegularLattice3D<VT>* l;
+    unsigned long int pos;
+    Iterator(unsigned long int pos, SparseRegularLattice3D<VT>& g);
+};
+
+template <class VT>
+class SparseRegularLattice3D<VT>::ConstIterator
+{
+    friend class SparseRegularLattice3D;
+public:
+    ConstIterator();
+
+    std::pair<Point3d, VT> operator *() const;
+    const std::pair<Point3d, VT>* operator ->() const;
+    bool operator == (const ConstIterator& otherIterator) const;
+    bool operator != (const ConstIterator& otherIterator) const;
+
+    ConstIterator operator ++ ();
+    ConstIterator operator ++ (int);
+    ConstIterator operator -- ();
+    ConstIterator operator -- (int);
+
+protected:
+    mutable std::pair<Point3d, VT> tmpp;
+    const SparseRegularLattice3D<VT>* l;
+    unsigned long int pos;
+    ConstIterator(unsigned long int pos, const SparseRegularLattice3D<VT>& g);
+};
+
+} //namespace cg3
+
+#include "sparse_regular_lattice_iterators.cpp"
+
+#endif // CG3_SPARSE_REGULAR_LATTICE_ITERATORS_H
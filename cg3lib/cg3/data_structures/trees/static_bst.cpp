@@ -0,0 +1,493 @@
+/*
+ * This file is part of cg3lib: https://github.com/cg3hci/cg3lib
+ * This Source Code Form is subject to the terms of the GNU GPL 3.0
+ */
+#include "static_bst.h"
+
+#include <algorithm>
+
+#include "cg3/utilities/bits.h"
+
+namespace cg3 {
+
+
+/* --------- CONSTRUCTORS --------- */
+
+/**
+ * @brief Default constructor
+ *
+ * @param[in] customComparator Less comparator for keys
+ */
+template <class K, class T, class C>
+StaticBST<K,T,C>::StaticBST(const C& customComparator) :
+    comparator(customComparator)
+{
+
+}
+
+/**
+ * @brief Constructor with a vector of entries (key/value pairs) to be inserted
+ *
+ * @param[in] vec Vector of pairs of keys/values
+ * @param[in] customComparator Less comparator for keys
+ */
+template <class K, class T, class C>
+StaticBST<K,T,C>::StaticBST(
+        const std::vector<std::pair<K,T>>& vec,
+        const C& customComparator) :
+    comparator(customComparator)
+{
+    this->construction(vec);
+}
+
+/**
+ * @brief Constructor with a vector of values to be inserted
+ *
+ * @param[in] vec Vector of values
+ * @param[in] customComparator Less comparator for keys
+ */
+template <class K, class T, class C>
+StaticBST<K,T,C>::StaticBST(
+        const std::vector<K>& vec,
+        const C& customComparator) :
+    comparator(customComparator)
+{
+    this->construction(vec);
+}
+
+
+
+/* --------- PUBLIC METHODS --------- */
+
+/**
+ * @brief Construction of the BST given the values
+ *
+ * A clear operation is performed before the construction
+ *
+ * @param[in] vec Vector of values
+ */
+template <class K, class T, class C>
+void StaticBST<K,T,C>::construction(const std::vector<K>& vec)
+{
+    std::vector<std::pair<K,T>> pairVec;
+    pairVec.reserve(vec.size());
+
+    for (const K& entry : vec) {
+        pairVec.push_back(std::make_pair(entry, entry));
+    }
+
+    construction(pairVec);
+}
+
+/**
+ * @brief Construction of the BST given the values
+ * (pairs of keys/values)
+ *
+ * A clear operation is performed before the construction.
+ * The sort is skipped if the input vector is already sorted.
+ *
+ * @param[in] vec Vector of pairs of keys/values
+ */
+template <class K, class T, class C>
+void StaticBST<K,T,C>::construction(const std::vector<std::pair<K,T>>& vec)
+{
+    this->clear();
+
+    if (vec.size() == 0)
+        return;
+
+    C& comp = this->comparator;
+    auto pairComparator = [&comp](const std::pair<K,T>& p1, const std::pair<K,T>& p2) {
+        return internal::isLess(p1.first, p2.first, comp);
+    };
+
+    std::vector<K> sortedKeys;
+    sortedKeys.reserve(vec.size());
+    values.reserve(vec.size());
+
+    auto appendEntries = [&](const std::vector<std::pair<K,T>>& sortedVec) {
+        for (const std::pair<K,T>& pair : sortedVec) {
+            //Avoid duplicates
+            if (sortedKeys.empty() || !internal::isEqual(sortedKeys.back(), pair.first, comp)) {
+                sortedKeys.push_back(pair.first);
+                values.push_back(pair.second);
+            }
+        }
+    };
+
+    if (std::is_sorted(vec.begin(), vec.end(), pairComparator)) {
+        appendEntries(vec);
+    }
+    else {
+        std::vector<std::pair<K,T>> sortedVec(vec.begin(), vec.end());
+        std::stable_sort(sortedVec.begin(), sortedVec.end(), pairComparator);
+        appendEntries(sortedVec);
+    }
+
+    //Position 0 is not used: the root is in position 1
+    keys.resize(sortedKeys.size() + 1);
+    ranks.resize(sortedKeys.size() + 1);
+    ranks[0] = sortedKeys.size();
+
+    this->eytzingerConstructionHelper(sortedKeys, 0, 1);
+}
+
+/**
+ * @brief Find an entry in the BST
+ *
+ * @param[in] key Key of the entry to be found
+ * @return The iterator pointing to the entry if it has been found,
+ * end iterator otherwise
+ */
+template <class K, class T, class C>
+typename StaticBST<K,T,C>::iterator StaticBST<K,T,C>::find(const K& key) const
+{
+    size_t k = this->lowerBoundHelper(key);
+
+    if (k == 0 || internal::isLess(key, keys[k], comparator))
+        return this->end();
+
+    return values.begin() + ranks[k];
+}
+
+/**
+ * @brief Find the entry in the BST which is right lower than (or equal to)
+ * a given key
+ *
+ * @param[in] key Input key
+ * @return The iterator pointing to the entry if the element (lower/equal)
+ * exists in the BST, end iterator otherwise
+ */
+template <class K, class T, class C>
+typename StaticBST<K,T,C>::iterator StaticBST<K,T,C>::findLower(const K& key) const
+{
+    size_t rank = ranks.empty() ? 0 : ranks[this->upperBoundHelper(key)];
+
+    if (rank == 0)
+        return this->end();
+
+    return values.begin() + (rank - 1);
+}
+
+/**
+ * @brief Find the entry in the BST which is right upper than a given key
+ *
+ * @param[in] key Input key
+ * @return The iterator pointing to the entry if the element (upper)
+ * exists in the BST, end iterator otherwise
+ */
+template <class K, class T, class C>
+typename StaticBST<K,T,C>::iterator StaticBST<K,T,C>::findUpper(const K& key) const
+{
+    if (ranks.empty())
+        return this->end();
+
+    return values.begin() + ranks[this->upperBoundHelper(key)];
+}
+
+/**
+ * @brief Get the number of entries in the BST
+ *
+ * @return Number of entries in the BST
+ */
+template <class K, class T, class C>
+TreeSize StaticBST<K,T,C>::size() const
+{
+    return values.size();
+}
+
+/**
+ * @brief Check if the BST is empty
+ *
+ * @return True if the BST is empty
+ */
+template <class K, class T, class C>
+bool StaticBST<K,T,C>::empty() const
+{
+    return values.empty();
+}
+
+/**
+ * @brief Clear the BST, deleting all its entries
+ */
+template <class K, class T, class C>
+void StaticBST<K,T,C>::clear()
+{
+    keys.clear();
+    ranks.clear();
+    values.clear();
+}
+
+/**
+ * @brief Range query
+ *
+ * @param[in] start Starting key
+ * @param[in] end End key
+ * @param[out] out Output iterators (of the BST)
+ * pointing to the entries which have keys enclosed in the input range
+ */
+template <class K, class T, class C> template <class OutputIterator>
+void StaticBST<K,T,C>::rangeQuery(
+        const K& start, const K& end,
+        OutputIterator out) const
+{
+    if (ranks.empty())
+        return;
+
+    size_t a = ranks[this->lowerBoundHelper(start)];
+    size_t b = ranks[this->upperBoundHelper(end)];
+
+    for (size_t i = a; i < b; i++) {
+        *out = values.begin() + i;
+        out++;
+    }
+}
+
+
+
+/* ----- ITERATOR MIN/MAX ----- */
+
+/**
+ * @brief Get minimum key entry in the BST
+ *
+ * @return The iterator pointing to the minimum entry
+ */
+template <class K, class T, class C>
+typename StaticBST<K,T,C>::iterator StaticBST<K,T,C>::getMin() const
+{
+    return values.begin();
+}
+
+/**
+ * @brief Get maximum key entry in the BST
+ *
+ * @return The iterator pointing to the maximum entry
+ */
+template <class K, class T, class C>
+typename StaticBST<K,T,C>::iterator StaticBST<K,T,C>::getMax() const
+{
+    return values.empty() ? values.end() : values.end() - 1;
+}
+
+
+
+/* ----- ITERATORS ----- */
+
+/**
+ * @brief Begin iterator
+ *
+ * @return Iterator pointing to the minimum entry
+ */
+template <class K, class T, class C>
+typename StaticBST<K,T,C>::iterator StaticBST<K,T,C>::begin() const
+{
+    return values.begin();
+}
+
+/**
+ * @brief End iterator
+ *
+ * @return Iterator following the maximum entry
+ */
+template <class K, class T, class C>
+typename StaticBST<K,T,C>::iterator StaticBST<K,T,C>::end() const
+{
+    return values.end();
+}
+
+/**
+ * @brief Begin const iterator
+ *
+ * @return Const iterator pointing to the minimum entry
+ */
+template <class K, class T, class C>
+typename StaticBST<K,T,C>::const_iterator StaticBST<K,T,C>::cbegin() const
+{
+    return values.cbegin();
+}
+
+/**
+ * @brief End const iterator
+ *
+ * @return Const iterator following the maximum entry
+ */
+template <class K, class T, class C>
+typename StaticBST<K,T,C>::const_iterator StaticBST<K,T,C>::cend() const
+{
+    return values.cend();
+}
+
+/**
+ * @brief Begin reverse iterator
+ *
+ * @return Reverse iterator pointing to the maximum entry
+ */
+template <class K, class T, class C>
+typename StaticBST<K,T,C>::reverse_iterator StaticBST<K,T,C>::rbegin() const
+{
+    return values.rbegin();
+}
+
+/**
+ * @brief End reverse iterator
+ *
+ * @return Reverse iterator preceding the minimum entry
+ */
+template <class K, class T, class C>
+typename StaticBST<K,T,C>::reverse_iterator StaticBST<K,T,C>::rend() const
+{
+    return values.rend();
+}
+
+/**
+ * @brief Begin const reverse iterator
+ *
+ * @return Const reverse iterator pointing to the maximum entry
+ */
+template <class K, class T, class C>
+typename StaticBST<K,T,C>::const_reverse_iterator StaticBST<K,T,C>::crbegin() const
+{
+    return values.crbegin();
+}
+
+/**
+ * @brief End const reverse iterator
+ *
+ * @return Const reverse iterator preceding the minimum entry
+ */
+template <class K, class T, class C>
+typename StaticBST<K,T,C>::const_reverse_iterator StaticBST<K,T,C>::crend() const
+{
+    return values.crend();
+}
+
+
+
+/* ----- SWAP FUNCTION ----- */
+
+/**
+ * @brief Swap BST with another one
+ * @param[out] bst BST to be swapped with this object
+ */
+template <class K, class T, class C>
+void StaticBST<K,T,C>::swap(StaticBST<K,T,C>& bst)
+{
+    using std::swap;
+    swap(this->keys, bst.keys);
+    swap(this->ranks, bst.ranks);
+    swap(this->values, bst.values);
+    swap(this->comparator, bst.comparator);
+}
+
+/**
+ * @brief Swap BST with another one
+ * @param b1 First BST
+ * @param b2 Second BST
+ */
+template <class K, class T, class C>
+void swap(StaticBST<K,T,C>& b1, StaticBST<K,T,C>& b2)
+{
+    b1.swap(b2);
+}
+
+
+
+/* --------- PROTECTED METHODS --------- */
+
+/**
+ * @brief Find the position of the first key which is not less than a given key
+ *
+ * The loop has no branches depending on the keys: the comparison
+ * result selects the child. When the loop exits, the answer is the
+ * last node where the search went left, which is obtained removing
+ * the trailing ones (and the following zero) from the position.
+ *
+ * @param[in] key Input key
+ * @return Position in the Eytzinger layout, 0 if all the keys are less
+ * than the input key
+ */
+template <class K, class T, class C>
+size_t StaticBST<K,T,C>::lowerBoundHelper(const K& key) const
+{
+    const size_t n = keys.size();
+    C comp = this->comparator;
+
+    size_t k = 1;
+    while (k < n) {
+        this->prefetchHelper(k);
+        k = 2 * k + static_cast<size_t>(internal::isLess(keys[k], key, comp));
+    }
+
+    //Remove the trailing ones and the last zero
+    return k >> (countTrailingZeros64(~static_cast<uint64_t>(k)) + 1);
+}
+
+/**
+ * @brief Find the position of the first key which is greater than a given key
+ *
+ * @param[in] key Input key
+ * @return Position in the Eytzinger layout, 0 if all the keys are less
+ * than or equal to the input key
+ */
+template <class K, class T, class C>
+size_t StaticBST<K,T,C>::upperBoundHelper(const K& key) const
+{
+    const size_t n = keys.size();
+    C comp = this->comparator;
+
+    size_t k = 1;
+    while (k < n) {
+        this->prefetchHelper(k);
+        k = 2 * k + static_cast<size_t>(!internal::isLess(key, keys[k], comp));
+    }
+
+    //Remove the trailing ones and the last zero
+    return k >> (countTrailingZeros64(~static_cast<uint64_t>(k)) + 1);
+}
+
+/**
+ * @brief Prefetch the descendants of a node some levels below, which
+ * are contiguous in the Eytzinger layout
+ *
+ * @param[in] k Position of the node
+ */
+template <class K, class T, class C>
+void StaticBST<K,T,C>::prefetchHelper(size_t k) const
+{
+#if defined(__GNUC__) || defined(__clang__)
+    //Descendants of k filling a cache line
+    static const size_t PREFETCH_MULTIPLIER = sizeof(K) >= 64 ? 1 : 64 / sizeof(K);
+
+    const size_t d = k * PREFETCH_MULTIPLIER;
+    if (d < keys.size())
+        __builtin_prefetch(keys.data() + d);
+#else
+    (void) k;
+#endif
+}
+
+/**
+ * @brief Fill the Eytzinger layout with an in-order visit of the implicit tree
+ *
+ * @param[in] sortedKeys Sorted keys
+ * @param[in] i Next sorted key to be placed
+ * @param[in] k Position of the node
+ * @return Next sorted key to be placed after the visit of the subtree
+ */
+template <class K, class T, class C>
+size_t StaticBST<K,T,C>::eytzingerConstructionHelper(
+        const std::vector<K>& sortedKeys,
+        size_t i,
+        size_t k)
+{
+    if (k < keys.size()) {
+        i = this->eytzingerConstructionHelper(sortedKeys, i, 2 * k);
+        keys[k] = sortedKeys[i];
+        ranks[k] = i;
+        i++;
+        i = this->eytzingerConstructionHelper(sortedKeys, i, 2 * k + 1);
+    }
+    return i;
+}
+
+}
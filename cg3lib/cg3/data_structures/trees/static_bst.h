@@ -0,0 +1,133 @@
+/*
+ * This file is part of cg3lib: https://github.com/cg3hci/cg3lib
+ * This Source Code Form is subject to the terms of the GNU GPL 3.0
+ */
+#ifndef CG3_STATIC_BST_H
+#define CG3_STATIC_BST_H
+
+#include <vector>
+#include <utility>
+#include <cstddef>
+
+#include "includes/tree_common.h"
+
+namespace cg3 {
+
+/**
+ * @brief A read-only binary search tree stored in the implicit
+ * Eytzinger (breadth-first) layout
+ *
+ * Bulk-built counterpart of BSTLeaf/AVLLeaf for key sets that do not
+ * change after the construction. Keys are stored in a single array
+ * where the children of the position k are 2k and 2k+1: the search
+ * is branch-free and the next levels are prefetched, so there are no
+ * pointers and no nodes to be allocated.
+ * Values are stored in a separate array sorted by key, which is the
+ * range of the iterators.
+ *
+ * No duplicates are allowed: the first occurrence of a key is kept.
+ */
+template <class K, class T = K, class C = DefaultComparatorType<K>>
+class StaticBST
+{
+
+public:
+
+    /* Typedefs */
+
+    typedef typename std::vector<T>::const_iterator iterator;
+    typedef typename std::vector<T>::const_iterator const_iterator;
+    typedef typename std::vector<T>::const_reverse_iterator reverse_iterator;
+    typedef typename std::vector<T>::const_reverse_iterator const_reverse_iterator;
+
+
+    /* Constructors */
+
+    explicit StaticBST(const C& customComparator = &internal::defaultComparator<K>);
+    explicit StaticBST(const std::vector<std::pair<K,T>>& vec,
+            const C& customComparator = &internal::defaultComparator<K>);
+    explicit StaticBST(const std::vector<K>& vec,
+            const C& customComparator = &internal::defaultComparator<K>);
+
+
+    /* Public methods */
+
+    void construction(const std::vector<K>& vec);
+    void construction(const std::vector<std::pair<K,T>>& vec);
+
+    iterator find(const K& key) const;
+
+    iterator findLower(const K& key) const;
+    iterator findUpper(const K& key) const;
+
+    TreeSize size() const;
+    bool empty() const;
+
+    void clear();
+
+    template <class OutputIterator>
+    void rangeQuery(
+            const K& start, const K& end,
+            OutputIterator out) const;
+
+
+    /* Iterator Min/Max */
+
+    iterator getMin() const;
+    iterator getMax() const;
+
+
+    /* Iterators */
+
+    iterator begin() const;
+    iterator end() const;
+
+    const_iterator cbegin() const;
+    const_iterator cend() const;
+
+    reverse_iterator rbegin() const;
+    reverse_iterator rend() const;
+
+    const_reverse_iterator crbegin() const;
+    const_reverse_iterator crend() const;
+
+
+    /* Swap function */
+
+    inline void swap(StaticBST<K,T,C>& bst);
+
+protected:
+
+    /* Protected fields */
+
+    std::vector<K> keys;
+    std::vector<size_t> ranks;
+
+    std::vector<T> values;
+
+    C comparator;
+
+
+    /* Protected methods */
+
+    inline size_t lowerBoundHelper(const K& key) const;
+    inline size_t upperBoundHelper(const K& key) const;
+
+    inline void prefetchHelper(size_t k) const;
+
+    size_t eytzingerConstructionHelper(
+            const std::vector<K>& sortedKeys,
+            size_t i,
+            size_t k);
+
+};
+
+template <class K, class T, class C>
+void swap(StaticBST<K,T,C>& b1, StaticBST<K,T,C>& b2);
+
+}
+
+
+#include "static_bst.cpp"
+
+#endif // CG3_STATIC_BST_H
@@ -0,0 +1,422 @@
+/*
+ * This file is part of cg3lib: https://github.com/cg3hci/cg3lib
+ * This Source Code Form is subject to the terms of the GNU GPL 3.0
+ */
+#include "static_rangetree.h"
+
+#include "assert.h"
+
+#include <algorithm>
+#include <numeric>
+#include <limits>
+
+#include "cg3/utilities/bits.h"
+
+namespace cg3 {
+
+
+/* --------- CONSTRUCTORS --------- */
+
+/**
+ * @brief Default constructor
+ *
+ * @param[in] customComparators Vector of comparators for each
+ * dimension of the range tree (only the first two are used)
+ */
+template <class K, class T, class C>
+StaticRangeTree<K,T,C>::StaticRangeTree(
+        const std::vector<C>& customComparators) :
+    nLevels(0),
+    wordsPerLevel(0),
+    xComparator(customComparators[0]),
+    yComparator(customComparators[1])
+{
+
+}
+
+/**
+ * @brief Constructor with a vector of entries (key/value pairs) to be inserted
+ *
+ * @param[in] vec Vector of pairs of keys/values
+ * @param[in] customComparators Vector of comparators for each
+ * dimension of the range tree (only the first two are used)
+ */
+template <class K, class T, class C>
+StaticRangeTree<K,T,C>::StaticRangeTree(
+        const std::vector<std::pair<K,T>>& vec,
+        const std::vector<C>& customComparators) :
+    StaticRangeTree<K,T,C>(customComparators)
+{
+    this->construction(vec);
+}
+
+/**
+ * @brief Constructor with a vector of values to be inserted
+ *
+ * @param[in] vec Vector of values
+ * @param[in] customComparators Vector of comparators for each
+ * dimension of the range tree (only the first two are used)
+ */
+template <class K, class T, class C>
+StaticRangeTree<K,T,C>::StaticRangeTree(
+        const std::vector<K>& vec,
+        const std::vector<C>& customComparators) :
+    StaticRangeTree<K,T,C>(customComparators)
+{
+    this->construction(vec);
+}
+
+
+
+/* --------- PUBLIC METHODS --------- */
+
+/**
+ * @brief Construction of the range tree given the values
+ *
+ * A clear operation is performed before the construction
+ *
+ * @param[in] vec Vector of values
+ */
+template <class K, class T, class C>
+void StaticRangeTree<K,T,C>::construction(const std::vector<K>& vec)
+{
+    std::vector<std::pair<K,T>> pairVec;
+    pairVec.reserve(vec.size());
+
+    for (const K& entry : vec) {
+        pairVec.push_back(std::make_pair(entry, entry));
+    }
+
+    construction(pairVec);
+}
+
+/**
+ * @brief Construction of the range tree given the values
+ * (pairs of keys/values)
+ *
+ * A clear operation is performed before the construction.
+ * Each level is obtained from the previous one by a stable partition
+ * of every node, so the order of the second dimension is preserved
+ * and the whole construction costs O(n log n).
+ *
+ * @param[in] vec Vector of pairs of keys/values
+ */
+template <class K, class T, class C>
+void StaticRangeTree<K,T,C>::construction(const std::vector<std::pair<K,T>>& vec)
+{
+    this->clear();
+
+    if (vec.size() == 0)
+        return;
+
+    //Sort the collection on the first dimension, keeping the first of the duplicates
+    std::vector<std::pair<K,T>> sortedVec(vec.begin(), vec.end());
+    C& xComp = this->xComparator;
+    std::stable_sort(sortedVec.begin(), sortedVec.end(),
+        [&xComp](const std::pair<K,T>& p1, const std::pair<K,T>& p2) {
+            return internal::isLess(p1.first, p2.first, xComp);
+        });
+
+    keys.reserve(sortedVec.size());
+    values.reserve(sortedVec.size());
+    for (const std::pair<K,T>& pair : sortedVec) {
+        if (keys.empty() || !internal::isEqual(keys.back(), pair.first, xComp)) {
+            keys.push_back(pair.first);
+            values.push_back(pair.second);
+        }
+    }
+
+    const size_t n = keys.size();
+    assert(n < std::numeric_limits<uint32_t>::max());
+
+    //Number of levels: the nodes of the last one contain a single entry
+    nLevels = 1;
+    while ((static_cast<size_t>(1) << (nLevels - 1)) < n)
+        nLevels++;
+
+    wordsPerLevel = n / 64 + 1;
+
+    levelIds.resize(nLevels * n);
+    levelBits.resize(nLevels * wordsPerLevel, 0);
+    levelRanks.resize(nLevels * wordsPerLevel, 0);
+
+    //Root level: all the entries sorted on the second dimension
+    std::iota(levelIds.begin(), levelIds.begin() + n, 0);
+    C& yComp = this->yComparator;
+    const std::vector<K>& k = this->keys;
+    std::stable_sort(levelIds.begin(), levelIds.begin() + n,
+        [&yComp, &k](uint32_t id1, uint32_t id2) {
+            return internal::isLess(k[id1], k[id2], yComp);
+        });
+
+    std::vector<std::pair<size_t, size_t>> nodes(1, std::make_pair(0, n));
+    std::vector<std::pair<size_t, size_t>> childNodes;
+
+    for (size_t level = 0; level < nLevels; level++) {
+        const uint32_t* ids = levelIds.data() + level * n;
+        uint64_t* bits = levelBits.data() + level * wordsPerLevel;
+        uint32_t* ranks = levelRanks.data() + level * wordsPerLevel;
+
+        const bool hasNext = level + 1 < nLevels;
+        uint32_t* nextIds = hasNext ? levelIds.data() + (level + 1) * n : nullptr;
+
+        childNodes.clear();
+
+        for (const std::pair<size_t, size_t>& node : nodes) {
+            const size_t lo = node.first;
+            const size_t hi = node.second;
+            const size_t mid = (lo + hi) / 2;
+
+            size_t left = lo;
+            size_t right = mid;
+
+            for (size_t p = lo; p < hi; p++) {
+                const uint32_t id = ids[p];
+
+                if (id < mid) {
+                    bits[p >> 6] |= static_cast<uint64_t>(1) << (p & 63);
+                    if (hasNext)
+                        nextIds[left++] = id;
+                }
+                else if (hasNext) {
+                    nextIds[right++] = id;
+                }
+            }
+
+            if (hasNext) {
+                if (mid > lo)
+                    childNodes.push_back(std::make_pair(lo, mid));
+                childNodes.push_back(std::make_pair(mid, hi));
+            }
+        }
+
+        //Prefix counts of the bits set before each word
+        uint32_t count = 0;
+        for (size_t w = 0; w < wordsPerLevel; w++) {
+            ranks[w] = count;
+            count += popcount64(bits[w]);
+        }
+
+        nodes.swap(childNodes);
+    }
+}
+
+/**
+ * @brief Get the number of entries in the range tree
+ * @return Number of entries
+ */
+template <class K, class T, class C>
+size_t StaticRangeTree<K,T,C>::size() const
+{
+    return keys.size();
+}
+
+/**
+ * @brief Check if the range tree is empty
+ * @return True if the range tree is empty
+ */
+template <class K, class T, class C>
+bool StaticRangeTree<K,T,C>::empty() const
+{
+    return keys.empty();
+}
+
+/**
+ * @brief Clear the range tree, deleting all its entries
+ */
+template <class K, class T, class C>
+void StaticRangeTree<K,T,C>::clear()
+{
+    keys.clear();
+    values.clear();
+    levelIds.clear();
+    levelBits.clear();
+    levelRanks.clear();
+    nLevels = 0;
+    wordsPerLevel = 0;
+}
+
+/**
+ * @brief Range query
+ *
+ * @param[in] start Starting key
+ * @param[in] end End key
+ * @param[out] out Output iterator on the values contained in the range
+ */
+template <class K, class T, class C>
+template <class OutputIterator>
+void StaticRangeTree<K,T,C>::rangeQuery(
+        const K& start, const K& end,
+        OutputIterator out) const
+{
+    size_t a, b, pl, ph;
+
+    xBoundsHelper(start, end, a, b);
+    if (a >= b || !yBoundsHelper(start, end, pl, ph))
+        return;
+
+    const size_t n = keys.size();
+    const std::vector<uint32_t>& ids = levelIds;
+    const std::vector<T>& v = values;
+    auto reporter = [&out, &ids, &v, n](size_t level, size_t p1, size_t p2) {
+        for (size_t p = p1; p < p2; p++) {
+            *out = v[ids[level * n + p]];
+            out++;
+        }
+    };
+
+    rangeQueryHelper(0, 0, n, pl, ph, a, b, reporter);
+}
+
+/**
+ * @brief Count the entries contained in a range, without reporting them
+ *
+ * @param[in] start Starting key
+ * @param[in] end End key
+ * @return Number of entries contained in the range
+ */
+template <class K, class T, class C>
+size_t StaticRangeTree<K,T,C>::rangeCount(
+        const K& start, const K& end) const
+{
+    size_t a, b, pl, ph;
+
+    xBoundsHelper(start, end, a, b);
+    if (a >= b || !yBoundsHelper(start, end, pl, ph))
+        return 0;
+
+    size_t count = 0;
+    auto counter = [&count](size_t, size_t p1, size_t p2) {
+        count += p2 - p1;
+    };
+
+    rangeQueryHelper(0, 0, keys.size(), pl, ph, a, b, counter);
+
+    return count;
+}
+
+
+
+/* --------- PROTECTED METHODS --------- */
+
+/**
+ * @brief Number of entries going into the left child
+ * before a position of a level
+ *
+ * @param[in] level Level
+ * @param[in] pos Position in the level
+ * @return Number of bits set in the level before the position
+ */
+template <class K, class T, class C>
+size_t StaticRangeTree<K,T,C>::rankHelper(size_t level, size_t pos) const
+{
+    const size_t w = level * wordsPerLevel + (pos >> 6);
+    return levelRanks[w] + popcount64(levelBits[w] & lowBitsMask64(pos & 63));
+}
+
+/**
+ * @brief Compute the range of the entries, sorted on the
+ * first dimension, contained in the range
+ *
+ * @param[in] start Starting key
+ * @param[in] end End key
+ * @param[out] a First entry in the range
+ * @param[out] b Entry following the last one in the range
+ */
+template <class K, class T, class C>
+void StaticRangeTree<K,T,C>::xBoundsHelper(
+        const K& start, const K& end,
+        size_t& a, size_t& b) const
+{
+    C xComp = this->xComparator;
+
+    a = std::lower_bound(keys.begin(), keys.end(), start,
+        [&xComp](const K& key, const K& bound) {
+            return internal::isLess(key, bound, xComp);
+        }) - keys.begin();
+    b = std::upper_bound(keys.begin(), keys.end(), end,
+        [&xComp](const K& bound, const K& key) {
+            return internal::isLess(bound, key, xComp);
+        }) - keys.begin();
+}
+
+/**
+ * @brief Compute the range of positions of the root level
+ * contained in the range of the second dimension.
+ *
+ * This is the only binary search of the second dimension: the
+ * positions in the other levels are obtained by the rank helper.
+ *
+ * @param[in] start Starting key
+ * @param[in] end End key
+ * @param[out] pl First position in the range
+ * @param[out] ph Position following the last one in the range
+ * @return True if the range is not empty
+ */
+template <class K, class T, class C>
+bool StaticRangeTree<K,T,C>::yBoundsHelper(
+        const K& start, const K& end,
+        size_t& pl, size_t& ph) const
+{
+    C yComp = this->yComparator;
+    const std::vector<K>& k = this->keys;
+    std::vector<uint32_t>::const_iterator rootBegin = levelIds.begin();
+    std::vector<uint32_t>::const_iterator rootEnd = levelIds.begin() + keys.size();
+
+    pl = std::lower_bound(rootBegin, rootEnd, start,
+        [&yComp, &k](uint32_t id, const K& bound) {
+            return internal::isLess(k[id], bound, yComp);
+        }) - rootBegin;
+    ph = std::upper_bound(rootBegin, rootEnd, end,
+        [&yComp, &k](const K& bound, uint32_t id) {
+            return internal::isLess(bound, k[id], yComp);
+        }) - rootBegin;
+
+    return pl < ph;
+}
+
+/**
+ * @brief Visit the canonical nodes of a range query
+ *
+ * @param[in] level Level of the node
+ * @param[in] lo First entry of the node
+ * @param[in] hi Entry following the last one of the node
+ * @param[in] pl First position of the node in the range of the second dimension
+ * @param[in] ph Position following the last one in the range of the second dimension
+ * @param[in] a First entry in the range of the first dimension
+ * @param[in] b Entry following the last one in the range of the first dimension
+ * @param[in] visitor Function called on each maximal range of positions
+ * contained in the query range
+ */
+template <class K, class T, class C>
+template <class Visitor>
+void StaticRangeTree<K,T,C>::rangeQueryHelper(
+        size_t level,
+        size_t lo, size_t hi,
+        size_t pl, size_t ph,
+        size_t a, size_t b,
+        Visitor& visitor) const
+{
+    if (pl >= ph || hi <= a || b <= lo)
+        return;
+
+    //Node contained in the range of the first dimension
+    if (a <= lo && hi <= b) {
+        visitor(level, pl, ph);
+        return;
+    }
+
+    //Nodes with a single entry are always reported or discarded
+    assert(level + 1 < nLevels);
+
+    const size_t mid = (lo + hi) / 2;
+
+    const size_t rankLo = rankHelper(level, lo);
+    const size_t leftPl = rankHelper(level, pl) - rankLo;
+    const size_t leftPh = rankHelper(level, ph) - rankLo;
+
+    rangeQueryHelper(level + 1, lo, mid, lo + leftPl, lo + leftPh, a, b, visitor);
+    rangeQueryHelper(level + 1, mid, hi, mid + (pl - lo) - leftPl, mid + (ph - lo) - leftPh, a, b, visitor);
+}
+
+}
@@ -0,0 +1,126 @@
+/*
+ * This file is part of cg3lib: https://github.com/cg3hci/cg3lib
+ * This Source Code Form is subject to the terms of the GNU GPL 3.0
+ */
+#ifndef CG3_STATIC_RANGETREE_H
+#define CG3_STATIC_RANGETREE_H
+
+#include <vector>
+#include <cstdint>
+
+#include "includes/tree_common.h"
+#include "includes/rangetree_types.h"
+
+namespace cg3 {
+
+/**
+ * @brief Static two-dimensional range tree with fractional cascading
+ *
+ * Bulk-built counterpart of RangeTree for point sets that do not change
+ * after the construction. The primary tree is implicit over the entries
+ * sorted by the first comparator; each level stores, for every node, the
+ * entries sorted by the second comparator, together with a bit vector
+ * telling which entries go into the left child. Rank queries on the bit
+ * vectors give in constant time the position of a y-bound in the children
+ * (fractional cascading), so a range query costs O(log n + k) and the whole
+ * structure is made by a few contiguous arrays.
+ *
+ * Range queries have the same semantics of RangeTree::rangeQuery (inclusive
+ * bounds in each dimension). No duplicates are allowed: the first occurrence
+ * of a key is kept. Insertion and deletion are not supported, call
+ * construction() to rebuild the tree.
+ */
+template <class K, class T = K, class C = DefaultComparatorType<K>>
+class StaticRangeTree
+{
+
+public:
+
+    /* Constructors */
+
+    explicit StaticRangeTree(
+            const std::vector<C>& customComparators);
+    explicit StaticRangeTree(
+            const std::vector<std::pair<K,T>>& vec,
+            const std::vector<C>& customComparators);
+    explicit StaticRangeTree(
+            const std::vector<K>& vec,
+            const std::vector<C>& customComparators);
+
+
+    /* Public methods */
+
+    void construction(const std::vector<K>& vec);
+    void construction(const std::vector<std::pair<K,T>>& vec);
+
+    size_t size() const;
+    bool empty() const;
+
+    void clear();
+
+    template <class OutputIterator>
+    void rangeQuery(
+            const K& start, const K& end,
+            OutputIterator out) const;
+
+    size_t rangeCount(
+            const K& start, const K& end) const;
+
+protected:
+
+    /* Protected fields */
+
+    std::vector<K> keys;
+    std::vector<T> values;
+
+    size_t nLevels;
+
+    std::vector<uint32_t> levelIds;
+    std::vector<uint64_t> levelBits;
+    std::vector<uint32_t> levelRanks;
+    size_t wordsPerLevel;
+
+    C xComparator;
+    C yComparator;
+
+
+    /* Protected methods */
+
+    inline size_t rankHelper(size_t level, size_t pos) const;
+
+    inline void xBoundsHelper(
+            const K& start, const K& end,
+            size_t& a, size_t& b) const;
+    inline bool yBoundsHelper(
+            const K& start, const K& end,
+            size_t& pl, size_t& ph) const;
+
+    template <class Visitor>
+    void rangeQueryHelper(
+            size_t level,
+            size_t lo, size_t hi,
+            size_t pl, size_t ph,
+            size_t a, size_t b,
+            Visitor& visitor) const;
+
+};
+
+
+/**
+ * Static range tree of 2D points (double components)
+ */
+class StaticRangeTree2D : public StaticRangeTree<Point2d> {
+public:
+    StaticRangeTree2D()
+        : StaticRangeTree<Point2d>(internal::getComparatorsForPoint2D()) {}
+    StaticRangeTree2D(const std::vector<Point2d>& vec)
+        : StaticRangeTree<Point2d>(vec, internal::getComparatorsForPoint2D()) {}
+};
+
+}
+
+
+#include "static_rangetree.cpp"
+
+
+#endif // CG3_STATIC_RANGETREE_H
@@ -12,6 +12,8 @@
 #include "intersections2.h"
 
 #include <numeric>
+#include <algorithm>
+#include <cmath>
 
 
 namespace cg3 {
@@ -210,30 +212,143 @@ inline bool isPointLyingInTriangle(
 
 /**
  * @ingroup cg3core
- * @brief Check if the triangulation is a Delaunay triangulation (brute force, O(n^2))
+ * @brief Check if the triangulation is a Delaunay triangulation
  * @param points Vector of points
  * @param triangles Vector of triangles (represented by a vector of three points)
- * @return
+ * @return True if the triangulation is a Delaunay triangulation
+ * @see isDeulaunayTriangulation(const std::vector<Point2<T>>&, const std::vector<std::vector<Point2<T>>>&, std::vector<unsigned int>&)
  */
 template<class T>
 inline bool isDeulaunayTriangulation(
         const std::vector<Point2<T>>& points,
         const std::vector<std::vector<Point2<T>>>& trianglePoints)
 {
-    for (const std::vector<Point2<T>>& triangle : trianglePoints) {
-        const Point2<T>& a = triangle.at(0);
-        const Point2<T>& b = triangle.at(1);
-        const Point2<T>& c = triangle.at(2);
-
-        for (const Point2<T>& p : points) {
-            if (p != a && p != b && p != c) {
-                if (isPointLyingInCircle(a,b,c,p,false)) {
-                    return false;
+    std::vector<unsigned int> offendingTriangles;
+    return isDeulaunayTriangulation(points, trianglePoints, offendingTriangles);
+}
+
+/**
+ * @ingroup cg3core
+ * @brief Check if the triangulation is a Delaunay triangulation, reporting
+ * the triangles that violate the Delaunay condition.
+ *
+ * A triangle violates the condition if one of the points, other than its vertices,
+ * lies in its circumcircle. The points are bucketed in a uniform grid with about
+ * one point per cell, and every triangle is checked, in parallel, only against the
+ * points in the cells covered by the bounding box of its circumcircle.
+ * Nothing is assumed on the triangles: clockwise or degenerate triangles, whose
+ * circumcircle is not bounded by that box, are checked against all the points.
+ *
+ * @param points Vector of points
+ * @param triangles Vector of triangles (represented by a vector of three points)
+ * @param offendingTriangles Indices of the triangles whose circumcircle
+ * contains a point, in increasing order
+ * @return True if the triangulation is a Delaunay triangulation
+ *
+ * @par Complexity:
+ *      \e O(n + m + k), where n is the number of triangles, m the number of
+ *      points and k the number of points in the circumcircle boxes, about O(n)
+ *      for a Delaunay triangulation of evenly distributed points
+ */
+template<class T>
+inline bool isDeulaunayTriangulation(
+        const std::vector<Point2<T>>& points,
+        const std::vector<std::vector<Point2<T>>>& trianglePoints,
+        std::vector<unsigned int>& offendingTriangles)
+{
+    const long long int nTriangles = (long long int)trianglePoints.size();
+    const size_t nPoints = points.size();
+    offendingTriangles.clear();
+    if (nPoints == 0)
+        return true;
+
+    //Uniform grid on the points, stored as a compressed array of cells
+    double minX = points[0].x(), minY = points[0].y();
+    double maxX = minX, maxY = minY;
+    for (const Point2<T>& p : points) {
+        minX = std::min(minX, (double)p.x());
+        minY = std::min(minY, (double)p.y());
+        maxX = std::max(maxX, (double)p.x());
+        maxY = std::max(maxY, (double)p.y());
+    }
+    double side = std::sqrt((maxX - minX) * (maxY - minY) / nPoints);
+    if (!(side > 0))
+        side = std::max(maxX - minX, maxY - minY) / nPoints;
+    if (!(side > 0))
+        side = 1;
+    const size_t nx = std::min(nPoints, (size_t)((maxX - minX) / side) + 1);
+    const size_t ny = std::min(nPoints, (size_t)((maxY - minY) / side) + 1);
+
+    auto cellX = [&](double x) {
+        return (size_t)std::min((double)(nx - 1), std::max(0.0, std::floor((x - minX) / side)));
+    };
+    auto cellY = [&](double y) {
+        return (size_t)std::min((double)(ny - 1), std::max(0.0, std::floor((y - minY) / side)));
+    };
+
+    std::vector<size_t> cellStart(nx * ny + 1, 0);
+    for (const Point2<T>& p : points)
+        cellStart[cellY(p.y()) * nx + cellX(p.x()) + 1]++;
+    std::partial_sum(cellStart.begin(), cellStart.end(), cellStart.begin());
+    std::vector<size_t> cellPoints(nPoints);
+    std::vector<size_t> position(cellStart.begin(), cellStart.end() - 1);
+    for (size_t i = 0; i < nPoints; i++)
+        cellPoints[position[cellY(points[i].y()) * nx + cellX(points[i].x())]++] = i;
+
+    std::vector<char> offending(nTriangles, 0);
+    #pragma omp parallel for schedule(dynamic, 64)
+    for (long long int t = 0; t < nTriangles; t++) {
+        const Point2<T>& a = trianglePoints[t].at(0);
+        const Point2<T>& b = trianglePoints[t].at(1);
+        const Point2<T>& c = trianglePoints[t].at(2);
+
+        auto inCircle = [&](const Point2<T>& p) {
+            return p != a && p != b && p != c && isPointLyingInCircle(a, b, c, p, false);
+        };
+
+        //Circumcircle, for counter-clockwise triangles
+        double d = 2 * ((b.x() - a.x()) * (c.y() - a.y()) - (b.y() - a.y()) * (c.x() - a.x()));
+        double bx = b.x() - a.x(), by = b.y() - a.y();
+        double cx = c.x() - a.x(), cy = c.y() - a.y();
+        double ux = (cy * (bx * bx + by * by) - by * (cx * cx + cy * cy)) / d;
+        double uy = (bx * (cx * cx + cy * cy) - cx * (bx * bx + by * by)) / d;
+        double r = std::sqrt(ux * ux + uy * uy);
+        ux += a.x();
+        uy += a.y();
+
+        if (!(d > 0) || !std::isfinite(r)) {
+            for (const Point2<T>& p : points) {
+                if (inCircle(p)) {
+                    offending[t] = 1;
+                    break;
                 }
             }
+            continue;
         }
+
+        //Margin for the rounding of the circumcircle
+        r += 1e-6 * r + 1e-12 * (std::abs(ux) + std::abs(uy));
+        if (ux + r < minX || ux - r > maxX || uy + r < minY || uy - r > maxY)
+            continue;
+        const size_t x1 = cellX(ux - r), x2 = cellX(ux + r);
+        const size_t y1 = cellY(uy - r), y2 = cellY(uy + r);
+        for (size_t j = y1; j <= y2 && !offending[t]; j++) {
+            for (size_t i = x1; i <= x2 && !offending[t]; i++) {
+                for (size_t k = cellStart[j * nx + i]; k < cellStart[j * nx + i + 1]; k++) {
+                    if (inCircle(points[cellPoints[k]])) {
+                        offending[t] = 1;
+                        break;
+                    }
+                }
+            }
+        }
+    }
+
+    for (long long int t = 0; t < nTriangles; t++) {
+        if (offending[t])
+            offendingTriangles.push_back((unsigned int)t);
     }
-    return true;
+    return offendingTriangles.empty();
 }
 
 } //namespace cg3
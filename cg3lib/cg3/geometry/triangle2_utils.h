@@ -44,6 +44,12 @@ inline bool isDeulaunayTriangulation(
         const std::vector<Point2<T>>& points,
         const std::vector<std::vector<Point2<T>>>& triangles);
 
+template<class T>
+inline bool isDeulaunayTriangulation(
+        const std::vector<Point2<T>>& points,
+        const std::vector<std::vector<Point2<T>>>& triangles,
+        std::vector<unsigned int>& offendingTriangles);
+
 template<class T>
 bool areTriangleOverlapping(
         const cg3::Triangle<Point2<T>>& t1,
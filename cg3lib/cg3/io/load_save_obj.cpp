@@ -5,12 +5,17 @@
  * @author Alessandro Muntoni (muntoni.alessandro@gmail.com)
  */
 #include "load_save_obj.h"
-#include "../utilities/tokenizer.h"
 
 #include <fstream>
 #include <sstream>
 #include <iostream>
 #include <clocale>
+#include <cstdlib>
+#include <cstring>
+#include <algorithm>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
 
 namespace cg3 {
 namespace internal {
@@ -74,40 +79,238 @@ inline bool loadMtlFile(
 		std::map<std::string, Color> &mapColors)
 {
 	std::setlocale(LC_NUMERIC, "en_US.UTF-8"); // makes sure "." is the decimal separator
-	std::ifstream mtufile(mtuFile.c_str());
-	std::string line;
-	if (mtufile.is_open()){
-		while(std::getline(mtufile,line)) {
-			cg3::Tokenizer spaceTokenizer(line, ' ');
-
-			if (spaceTokenizer.begin() != spaceTokenizer.end()){
-
-				cg3::Tokenizer::iterator token = spaceTokenizer.begin();
-				if (*token == "newmtl"){
-					++token;
-					std::string colorname = *token;
-					do {
-						std::getline(mtufile,line);
-						spaceTokenizer = Tokenizer(line, ' ');
-						token = spaceTokenizer.begin();
-					} while (*token != "Kd");
-					std::string r = *(++token);
-					std::string g = *(++token);
-					std::string b = *(++token);
-
-					std::istringstream rstr(r), gstr(g), bstr(b);
-					float  rf, gf, bf;
-					rstr >> rf;
-					gstr >> gf;
-					bstr >> bf;
-					mapColors[colorname] = Color(rf*255, gf*255, bf*255);
-				}
+	std::vector<char> buffer;
+	if (! readObjFile(mtuFile, buffer))
+		return false;
+
+	const char* end = buffer.data() + buffer.size() - 1;
+	std::string colorname;
+	bool hasColor = false;
+	for (const char* line = buffer.data(); line < end; ) {
+		const char* lineEnd = objLineEnd(line, end);
+		const char* p = skipObjSpaces(line, lineEnd);
+		const char* headerEnd = objTokenEnd(p, lineEnd);
+		if (isObjToken(p, headerEnd, "newmtl")){
+			p = skipObjSpaces(headerEnd, lineEnd);
+			colorname = std::string(p, objTokenEnd(p, lineEnd));
+			hasColor = true;
+		}
+		else if (isObjToken(p, headerEnd, "Kd") && hasColor){
+			//only the first Kd of every material is considered
+			double r, g, b;
+			p = headerEnd;
+			if (readObjNumber(p, lineEnd, r) && readObjNumber(p, lineEnd, g) && readObjNumber(p, lineEnd, b)){
+				float rf = r, gf = g, bf = b;
+				mapColors[colorname] = Color(rf*255, gf*255, bf*255);
+			}
+			hasColor = false;
+		}
+		line = lineEnd + 1;
+	}
+	return true;
+}
+
+/**
+ * @brief Reads the whole content of a file in a buffer, terminated by '\0'.
+ * @return false if the file cannot be opened
+ */
+inline bool readObjFile(const std::string& filename, std::vector<char>& buffer)
+{
+	std::ifstream file(filename.c_str(), std::ios::in | std::ios::binary);
+	if(!file.is_open())
+		return false;
+	file.seekg(0, std::ios::end);
+	std::streamoff size = file.tellg();
+	file.seekg(0, std::ios::beg);
+	buffer.resize(size + 1);
+	file.read(buffer.data(), size);
+	buffer[size] = '\0';
+	return true;
+}
+
+inline bool isObjSpace(char c)
+{
+	return c == ' ' || c == '\t' || c == '\r';
+}
+
+inline const char* skipObjSpaces(const char* p, const char* end)
+{
+	while (p < end && isObjSpace(*p))
+		++p;
+	return p;
+}
+
+inline const char* objTokenEnd(const char* p, const char* end)
+{
+	while (p < end && !isObjSpace(*p))
+		++p;
+	return p;
+}
+
+/**
+ * @brief Returns the position of the '\n' which terminates the line starting
+ * at the given position, or end if the line is the last one.
+ */
+inline const char* objLineEnd(const char* line, const char* end)
+{
+	const char* lineEnd = static_cast<const char*>(std::memchr(line, '\n', end - line));
+	return lineEnd == nullptr ? end : lineEnd;
+}
+
+inline bool isObjToken(const char* begin, const char* end, const char* token)
+{
+	size_t size = std::strlen(token);
+	return (size_t)(end - begin) == size && std::strncmp(begin, token, size) == 0;
+}
+
+/**
+ * @brief Reads the next token of the line as a floating point number,
+ * and moves p at the end of the token.
+ * @return false if the line has no more tokens or if the token is not a number
+ */
+inline bool readObjNumber(const char*& p, const char* lineEnd, double& d)
+{
+	p = skipObjSpaces(p, lineEnd);
+	if (p == lineEnd)
+		return false;
+	char* e;
+	d = std::strtod(p, &e);
+	if (e == p)
+		return false;
+	p = objTokenEnd(e, lineEnd);
+	return true;
+}
+
+/**
+ * @brief Reads the integer at the beginning of the next token of the line
+ * (e.g. 3 in "3/1/2"), and moves p at the end of the token.
+ * @return false if the line has no more tokens or if the token does not start with an integer
+ */
+inline bool readObjInteger(const char*& p, const char* lineEnd, long int& i)
+{
+	p = skipObjSpaces(p, lineEnd);
+	if (p == lineEnd)
+		return false;
+	char* e;
+	i = std::strtol(p, &e, 10);
+	if (e == p)
+		return false;
+	p = objTokenEnd(e, lineEnd);
+	return true;
+}
+
+/**
+ * @brief Parses all the lines contained in [begin, end) of an obj file.
+ * Material lines are only stored, and are resolved after all the chunks of the file
+ * have been parsed.
+ * @return false if the lines are not well formed
+ */
+template <typename T, typename V, typename C, typename W>
+bool parseObjChunk(const char* begin, const char* end, ObjChunk<T, V, C, W>& chunk)
+{
+	for (const char* line = begin; line < end; line = objLineEnd(line, end) + 1) {
+		const char* lineEnd = objLineEnd(line, end);
+		const char* p = skipObjSpaces(line, lineEnd);
+		const char* headerEnd = objTokenEnd(p, lineEnd);
+
+		// Handle
+		//
+		// v 0.123 0.234 0.345
+		// v 0.123 0.234 0.345 1.0
+		// v 0.123 0.234 0.345 1.0 0.5 0.2
+		if (isObjToken(p, headerEnd, "v")){
+			double x, y, z, r, g, b;
+			p = headerEnd;
+			if (!readObjNumber(p, lineEnd, x) || !readObjNumber(p, lineEnd, y) || !readObjNumber(p, lineEnd, z))
+				return false;
+			chunk.coords.push_back(x);
+			chunk.coords.push_back(y);
+			chunk.coords.push_back(z);
+			if (readObjNumber(p, lineEnd, r) && readObjNumber(p, lineEnd, g) && readObjNumber(p, lineEnd, b)){
+				long int alpha = 255;
+				readObjInteger(p, lineEnd, alpha);
+				chunk.verticesColors.push_back(Color(r*255, g*255, b*255, alpha));
 			}
 		}
-		mtufile.close();
-		return true;
+		else if (isObjToken(p, headerEnd, "vn")){
+			double x, y, z;
+			p = headerEnd;
+			if (!readObjNumber(p, lineEnd, x) || !readObjNumber(p, lineEnd, y) || !readObjNumber(p, lineEnd, z))
+				return false;
+			chunk.verticesNormals.push_back(x);
+			chunk.verticesNormals.push_back(y);
+			chunk.verticesNormals.push_back(z);
+		}
+		// Handle
+		//
+		// f 1 2 3
+		// f 3/1 4/2 5/3
+		// f 6/4/1 3/5/3 7/6/5
+		else if (isObjToken(p, headerEnd, "f")){
+			long int id;
+			W nVert = 0;
+			p = headerEnd;
+			while (readObjInteger(p, lineEnd, id)){
+				chunk.faces.push_back(id-1);
+				nVert++;
+			}
+			if (skipObjSpaces(p, lineEnd) != lineEnd)
+				return false;
+			chunk.faceSizes.push_back(nVert);
+		}
+		else if (isObjToken(p, headerEnd, "mtllib") || isObjToken(p, headerEnd, "usemtl")){
+			bool library = *p == 'm';
+			p = skipObjSpaces(headerEnd, lineEnd);
+			if (p != lineEnd){
+				ObjMaterialLine m;
+				m.face = chunk.faceSizes.size();
+				m.library = library;
+				m.name = std::string(p, objTokenEnd(p, lineEnd));
+				chunk.materials.push_back(m);
+			}
+		}
+	}
+	return true;
+}
+
+/**
+ * @brief Splits the buffer in at most nChunks ranges of whole lines, having similar sizes.
+ * @return the nChunks+1 boundaries of the ranges
+ */
+inline std::vector<const char*> splitObjBuffer(const char* begin, const char* end, unsigned int nChunks)
+{
+	std::vector<const char*> bounds(nChunks+1);
+	bounds[0] = begin;
+	bounds[nChunks] = end;
+	for (unsigned int i = 1; i < nChunks; i++){
+		const char* p = begin + (end - begin) / nChunks * i;
+		if (p < bounds[i-1])
+			p = bounds[i-1];
+		p = objLineEnd(p, end);
+		bounds[i] = p < end ? p + 1 : end;
+	}
+	return bounds;
+}
+
+/**
+ * @brief Concatenates the vectors of all the chunks in result, which is resized only once.
+ */
+template <typename T, typename Chunk>
+void mergeObjChunks(
+		std::vector<T>& result,
+		std::vector<Chunk>& chunks,
+		std::vector<T> Chunk::* member)
+{
+	std::vector<size_t> offsets(chunks.size()+1, 0);
+	for (unsigned int i = 0; i < chunks.size(); i++)
+		offsets[i+1] = offsets[i] + (chunks[i].*member).size();
+	result.resize(offsets.back());
+	#pragma omp parallel for
+	for (long long int i = 0; i < (long long int)chunks.size(); i++){
+		std::vector<T>& v = chunks[i].*member;
+		std::copy(v.begin(), v.end(), result.begin() + offsets[i]);
+		std::vector<T>().swap(v);
 	}
-	return false;
 }
 
 } //namespace cg3::internal
@@ -115,38 +318,35 @@ inline bool loadMtlFile(
 /**
  * @ingroup cg3core
  * @brief loadMeshFromObj
+ *
+ * The whole file is read in memory and, if it is large enough, it is splitted in chunks of
+ * lines which are parsed in parallel. All the output vectors are allocated only once.
+ *
  * @param filename
  * @param coords
  * @param faces
- * @param meshType
  * @param modality
  * @param verticesNormals
  * @param verticesColors
  * @param faceColors
  * @param faceSizes
- * @return
+ * @return false if the file cannot be opened or it is not a well formed obj file
  */
 template <typename T, typename V, typename C, typename W>
 bool loadMeshFromObj(
 		const std::string& filename,
-		std::list<T>& coords,
-		std::list<V>& faces,
+		std::vector<T>& coords,
+		std::vector<V>& faces,
 		io::FileMeshMode& modality,
-		std::list<C> &verticesNormals,
-		std::list<Color> &verticesColors,
-		std::list<Color> &faceColors,
-		std::list<W> &faceSizes)
+		std::vector<C> &verticesNormals,
+		std::vector<Color> &verticesColors,
+		std::vector<Color> &faceColors,
+		std::vector<W> &faceSizes)
 {
 	std::setlocale(LC_NUMERIC, "en_US.UTF-8"); // makes sure "." is the decimal separator
 
-	static const std::string vertex = "v";
-	static const std::string vertexNormal = "vn";
-	static const std::string face   = "f";
-
-	std::ifstream file(filename.c_str());
-	std::string   line;
+	std::vector<char> buffer;
 	bool usemtu = false;
-	bool first = true;
 	std::map<std::string, Color> mapColors;
 	Color actualColor;
 
@@ -155,134 +355,128 @@ bool loadMeshFromObj(
 	verticesNormals.clear();
 	verticesColors.clear();
 	faceColors.clear();
+	faceSizes.clear();
 	modality.reset();
 
-	if(!file.is_open()) {
+	if (!internal::readObjFile(filename, buffer)) {
 		return false;
 	}
-	while(std::getline(file,line)) {
-
-		cg3::Tokenizer spaceTokenizer(line, ' ');
 
-		if (spaceTokenizer.begin() != spaceTokenizer.end()) {
-
-			cg3::Tokenizer::iterator token = spaceTokenizer.begin();
-			std::string header = *token;
+	const char* begin = buffer.data();
+	const char* end = buffer.data() + buffer.size() - 1;
+	unsigned int nChunks = 1;
+	#ifdef _OPENMP
+	if (end - begin > (1 << 20))
+		nChunks = omp_get_max_threads();
+	#endif
+	std::vector<const char*> bounds = internal::splitObjBuffer(begin, end, nChunks);
+
+	typedef internal::ObjChunk<T, V, C, W> Chunk;
+	std::vector<Chunk> chunks(nChunks);
+	std::vector<char> valid(nChunks);
+	#pragma omp parallel for
+	for (long long int i = 0; i < (long long int)nChunks; i++){
+		valid[i] = internal::parseObjChunk(bounds[i], bounds[i+1], chunks[i]);
+	}
+	if (std::find(valid.begin(), valid.end(), false) != valid.end())
+		return false;
 
-			if (header == "mtllib"){
+	//materials are resolved sequentially, following the order of the lines
+	for (const Chunk& chunk : chunks){
+		size_t face = 0;
+		for (const internal::ObjMaterialLine& m : chunk.materials){
+			if (usemtu)
+				faceColors.insert(faceColors.end(), m.face - face, actualColor);
+			face = m.face;
+			if (m.library){
 				modality.setFaceColors();
-				usemtu = true;
-				std::string mtufilename = *(++token);
+				std::string mtufilename = m.name;
 				size_t lastSlash = filename.find_last_of("/");
 				if (lastSlash < filename.size()){
 					std::string path = filename.substr(0, lastSlash);
 					mtufilename = path + "/" + mtufilename;
 				}
-				if (! internal::loadMtlFile(mtufilename, mapColors))
-					usemtu = false;
-			}
-
-			if (header == vertexNormal) {
-				modality.setVertexNormals();
-				std::string x = *(++token);
-				std::string y = *(++token);
-				std::string z = *(++token);
-
-				verticesNormals.push_back(std::stod(x));
-				verticesNormals.push_back(std::stod(y));
-				verticesNormals.push_back(std::stod(z));
-			}
-
-			// Handle
-			//
-			// v 0.123 0.234 0.345
-			// v 0.123 0.234 0.345 1.0
-			if (header == vertex) {
-				std::string x = *(++token);
-				std::string y = *(++token);
-				std::string z = *(++token);
-
-				coords.push_back(std::stod(x));
-				coords.push_back(std::stod(y));
-				coords.push_back(std::stod(z));
-
-				++token;
-
-				if (token != spaceTokenizer.end()){
-					modality.setVertexColors();
-					std::string r = *(token);
-					std::string g = *(++token);
-					std::string b = *(++token);
-					++token;
-					double alpha = 255;
-					if (token != spaceTokenizer.end()){
-						alpha = std::stoi(*token);
-					}
-					Color c(std::stod(r)*255, std::stod(g)*255, std::stod(b)*255, alpha);
-					verticesColors.push_back(c);
-				}
-			}
-			// Handle
-			//
-			// f 1 2 3
-			// f 3/1 4/2 5/3
-			// f 6/4/1 3/5/3 7/6/5
-
-			else if (header == face) {
-				std::vector<std::string> dummy;
-				token++;
-				for (unsigned int i = 0; token != spaceTokenizer.end(); i++) {
-					dummy.push_back(*(token));
-					token++;
-				}
-				unsigned int nVert = (unsigned int)dummy.size();
-				faceSizes.push_back(nVert);
-
-				if (first == true){
-					first = false;
-					if (nVert == 3)
-						modality.setTriangleMesh();
-					else if (nVert == 4)
-						modality.setQuadMesh();
-					else
-						modality.setPolygonMesh();
-				}
-				else {
-					if (modality.isTriangleMesh() && nVert != 3)
-						modality.setPolygonMesh();
-					if (modality.isQuadMesh() && nVert != 4)
-						modality.setPolygonMesh();
-				}
-
-				std::vector<cg3::Tokenizer> slashTokenizer;
-				for (unsigned int i=0; i<dummy.size(); i++){
-					cg3::Tokenizer t(dummy[i], '/');
-					slashTokenizer.push_back(t);
-				}
-
-				for (unsigned int i=0; i<dummy.size(); i++){
-					std::string ids = *(slashTokenizer[i].begin());
-					faces.push_back(std::stoi(ids)-1);
-				}
-
-				if (usemtu){
-					faceColors.push_back(actualColor);
-				}
+				usemtu = internal::loadMtlFile(mtufilename, mapColors);
 			}
-			else if (header == "usemtl" && usemtu){
-				std::string color = *(++token);
-				if (mapColors.find(color) == mapColors.end()) {
+			else if (usemtu){
+				std::map<std::string, Color>::const_iterator it = mapColors.find(m.name);
+				if (it == mapColors.end())
 					actualColor = cg3::Color(128,128,128);
-				}
 				else
-					actualColor = mapColors[color];
+					actualColor = it->second;
 			}
 		}
+		if (usemtu)
+			faceColors.insert(faceColors.end(), chunk.faceSizes.size() - face, actualColor);
+	}
+
+	internal::mergeObjChunks(coords, chunks, &Chunk::coords);
+	internal::mergeObjChunks(verticesNormals, chunks, &Chunk::verticesNormals);
+	internal::mergeObjChunks(verticesColors, chunks, &Chunk::verticesColors);
+	internal::mergeObjChunks(faces, chunks, &Chunk::faces);
+	internal::mergeObjChunks(faceSizes, chunks, &Chunk::faceSizes);
+
+	if (verticesNormals.size() > 0)
+		modality.setVertexNormals();
+	if (verticesColors.size() > 0)
+		modality.setVertexColors();
+	if (faceSizes.size() > 0){
+		bool allTriangles = true, allQuads = true;
+		for (W nVert : faceSizes){
+			allTriangles = allTriangles && nVert == 3;
+			allQuads = allQuads && nVert == 4;
+		}
+		if (allTriangles)
+			modality.setTriangleMesh();
+		else if (allQuads)
+			modality.setQuadMesh();
+		else
+			modality.setPolygonMesh();
 	}
-	file.close();
 	return true;
 }
 
+/**
+ * @ingroup cg3core
+ * @brief loadMeshFromObj
+ * @param filename
+ * @param coords
+ * @param faces
+ * @param meshType
+ * @param modality
+ * @param verticesNormals
+ * @param verticesColors
+ * @param faceColors
+ * @param faceSizes
+ * @return
+ */
+template <typename T, typename V, typename C, typename W>
+bool loadMeshFromObj(
+		const std::string& filename,
+		std::list<T>& coords,
+		std::list<V>& faces,
+		io::FileMeshMode& modality,
+		std::list<C> &verticesNormals,
+		std::list<Color> &verticesColors,
+		std::list<Color> &faceColors,
+		std::list<W> &faceSizes)
+{
+	std::vector<T> vcoords;
+	std::vector<V> vfaces;
+	std::vector<C> vnormals;
+	std::vector<Color> vcolors, fcolors;
+	std::vector<W> fsizes;
+
+	bool r = loadMeshFromObj(filename, vcoords, vfaces, modality, vnormals, vcolors, fcolors, fsizes);
+	coords.assign(vcoords.begin(), vcoords.end());
+	faces.assign(vfaces.begin(), vfaces.end());
+	verticesNormals.assign(vnormals.begin(), vnormals.end());
+	verticesColors.assign(vcolors.begin(), vcolors.end());
+	faceColors.assign(fcolors.begin(), fcolors.end());
+	faceSizes.assign(fsizes.begin(), fsizes.end());
+	return r;
+}
+
 /**
  * @ingroup cg3core
  * @brief loadTriangleMeshFromObj
@@ -305,39 +499,30 @@ bool loadTriangleMeshFromObj(
 		std::vector<Color> &verticesColors,
 		std::vector<Color> &triangleColors)
 {
-	std::list<T> dummyc;
-	std::list<V> dummyt;
+	std::vector<T> dummyc;
+	std::vector<V> dummyt;
 	modality.reset();
-	std::list<C> dummyvn;
-	std::list<Color> dummycv;
-	std::list<Color> dummyct;
-	bool r = loadMeshFromObj(filename, dummyc, dummyt, modality, dummyvn, dummycv, dummyct);
+	std::vector<C> dummyvn;
+	std::vector<Color> dummycv;
+	std::vector<Color> dummyct;
+	std::vector<unsigned int> faceSizes;
+	bool r = loadMeshFromObj(filename, dummyc, dummyt, modality, dummyvn, dummycv, dummyct, faceSizes);
 	if (r == true && dummyt.size() > 0 && !modality.isTriangleMesh()){
 		std::cerr << "Error: mesh contained on " << filename << " is not a triangle mesh\n";
 		r = false;
 	}
 	if (r) {
-		coords.clear();
-		triangles.clear();
-		coords = std::vector<T>{ std::make_move_iterator(std::begin(dummyc)),
-									  std::make_move_iterator(std::end(dummyc)) };
-		triangles = std::vector<V>{ std::make_move_iterator(std::begin(dummyt)),
-										 std::make_move_iterator(std::end(dummyt)) };
 		if (modality.hasVertexNormals() && dummyc.size() == dummyvn.size()){
-			verticesNormals.clear();
-			verticesNormals = std::vector<C>{ std::make_move_iterator(std::begin(dummyvn)),
-										  std::make_move_iterator(std::end(dummyvn)) };
+			verticesNormals = std::move(dummyvn);
 		}
 		if (modality.hasVertexColors() && dummyc.size() == dummycv.size()*3){
-			verticesColors.clear();
-			verticesColors = std::vector<Color>{ std::make_move_iterator(std::begin(dummycv)),
-													  std::make_move_iterator(std::end(dummycv)) };
+			verticesColors = std::move(dummycv);
 		}
 		if (modality.hasFaceColors() && dummyt.size() == dummyct.size()*3){
-			triangleColors.clear();
-			triangleColors = std::vector<Color>{ std::make_move_iterator(std::begin(dummyct)),
-													  std::make_move_iterator(std::end(dummyct)) };
+			triangleColors = std::move(dummyct);
 		}
+		coords = std::move(dummyc);
+		triangles = std::move(dummyt);
 	}
 	return r;
 }
@@ -357,36 +542,29 @@ bool loadTriangleMeshFromObj(
 		Eigen::PlainObjectBase<T>& coords,
 		Eigen::PlainObjectBase<V>& triangles)
 {
-	std::list<typename Eigen::PlainObjectBase<T>::Scalar> dummyc;
-	std::list<typename Eigen::PlainObjectBase<V>::Scalar> dummyt;
+	std::vector<typename Eigen::PlainObjectBase<T>::Scalar> dummyc;
+	std::vector<typename Eigen::PlainObjectBase<V>::Scalar> dummyt;
 	io::FileMeshMode modality;
-	std::list<unsigned int> faceSizes;
-	bool r = loadMeshFromObj(filename, dummyc, dummyt, modality,
-							 internal::dummyListDouble,
-							 internal::dummyListColor, internal::dummyListColor, faceSizes);
+	std::vector<double> dummyvn;
+	std::vector<Color> dummycv, dummyct;
+	std::vector<unsigned int> faceSizes;
+	bool r = loadMeshFromObj(filename, dummyc, dummyt, modality, dummyvn, dummycv, dummyct, faceSizes);
     if (r == true && dummyt.size() > 0 && !modality.isTriangleMesh()){
         std::cerr << "Warning: mesh contained on " << filename << " is not a triangle mesh\n";
     }
 	if (r) {
 		coords.resize(dummyc.size()/3, 3);
 		triangles.resize(faceSizes.size(), 3);
-		int v = 0;
-		for (typename std::list<typename Eigen::PlainObjectBase<T>::Scalar>::iterator it = dummyc.begin(); it != dummyc.end();){
-			coords(v,0) = *it++;
-			coords(v,1) = *it++;
-			coords(v,2) = *it++;
-			v++;
+		for (unsigned int v = 0; v < dummyc.size()/3; v++){
+			coords(v,0) = dummyc[v*3];
+			coords(v,1) = dummyc[v*3+1];
+			coords(v,2) = dummyc[v*3+2];
 		}
-		int t = 0;
-		std::list<unsigned int>::iterator fsit = faceSizes.begin();
-		for (typename std::list<typename Eigen::PlainObjectBase<V>::Scalar>::iterator it = dummyt.begin(); it != dummyt.end();){
-			for (unsigned int id = 0; id < *fsit; id++){
-				if (id < 3)
-					triangles(t,id) = *it++;
-				else it++;
-			}
-			t++;
-			fsit++;
+		size_t id = 0;
+		for (unsigned int t = 0; t < faceSizes.size(); t++){
+			for (unsigned int i = 0; i < faceSizes[t] && i < 3; i++)
+				triangles(t,i) = dummyt[id+i];
+			id += faceSizes[t];
 		}
 	}
 	return r;
@@ -414,13 +592,13 @@ bool loadTriangleMeshFromObj(
 		Eigen::PlainObjectBase<W> &verticesColors,
 		Eigen::PlainObjectBase<X> &triangleColors)
 {
-	std::list<typename Eigen::PlainObjectBase<T>::Scalar> dummyc;
-	std::list<typename Eigen::PlainObjectBase<V>::Scalar> dummyt;
+	std::vector<typename Eigen::PlainObjectBase<T>::Scalar> dummyc;
+	std::vector<typename Eigen::PlainObjectBase<V>::Scalar> dummyt;
 	modality.reset();
-	std::list<typename Eigen::PlainObjectBase<C>::Scalar> dummyvn;
-	std::list<Color> dummycv;
-	std::list<Color> dummyct;
-	std::list<unsigned int> faceSizes;
+	std::vector<typename Eigen::PlainObjectBase<C>::Scalar> dummyvn;
+	std::vector<Color> dummycv;
+	std::vector<Color> dummyct;
+	std::vector<unsigned int> faceSizes;
 	bool r = loadMeshFromObj(filename, dummyc, dummyt, modality, dummyvn, dummycv, dummyct, faceSizes);
     if (r == true && dummyt.size() > 0 && !modality.isTriangleMesh()){
         std::cerr << "Warning: mesh contained on " << filename << " is not a triangle mesh\n";
@@ -428,40 +606,30 @@ bool loadTriangleMeshFromObj(
 	if (r) {
 		coords.resize(dummyc.size()/3, 3);
 		triangles.resize(faceSizes.size(), 3);
-		int v = 0;
-		for (typename std::list<typename Eigen::PlainObjectBase<T>::Scalar>::iterator it = dummyc.begin(); it != dummyc.end(); ){
-			coords(v,0) = *it++;
-			coords(v,1) = *it++;
-			coords(v,2) = *it++;
-			v++;
+		for (unsigned int v = 0; v < dummyc.size()/3; v++){
+			coords(v,0) = dummyc[v*3];
+			coords(v,1) = dummyc[v*3+1];
+			coords(v,2) = dummyc[v*3+2];
 		}
-		int t = 0;
-		std::list<unsigned int>::iterator fsit = faceSizes.begin();
-		for (typename std::list<typename Eigen::PlainObjectBase<V>::Scalar>::iterator it = dummyt.begin(); it != dummyt.end(); ){
-			for (unsigned int id = 0; id < *fsit; id++){
-				if (id < 3)
-					triangles(t,id) = *it++;
-				else it++;
-			}
-			t++;
-			fsit++;
+		size_t id = 0;
+		for (unsigned int t = 0; t < faceSizes.size(); t++){
+			for (unsigned int i = 0; i < faceSizes[t] && i < 3; i++)
+				triangles(t,i) = dummyt[id+i];
+			id += faceSizes[t];
 		}
 		if (modality.hasVertexNormals()
 				&& dummyc.size() == dummyvn.size()) {
 			verticesNormals.resize(dummyc.size()/3, 3);
-			int vn = 0;
-			for (typename std::list<typename Eigen::PlainObjectBase<C>::Scalar>::iterator it = dummyvn.begin(); it != dummyvn.end(); ){
-				verticesNormals(vn, 0) = *it++;
-				verticesNormals(vn, 1) = *it++;
-				verticesNormals(vn, 2) = *it++;
-				vn++;
+			for (unsigned int vn = 0; vn < dummyvn.size()/3; vn++){
+				verticesNormals(vn, 0) = dummyvn[vn*3];
+				verticesNormals(vn, 1) = dummyvn[vn*3+1];
+				verticesNormals(vn, 2) = dummyvn[vn*3+2];
 			}
 		}
 		if (modality.hasVertexColors() && dummyc.size() == dummycv.size()*3){
 			verticesColors.resize(dummyc.size()/3, 3);
-			int vc = 0;
-			for (typename std::list<Color>::iterator it = dummycv.begin(); it != dummycv.end(); ++it) {
-				Color c = *it;
+			for (unsigned int vc = 0; vc < dummycv.size(); vc++) {
+				const Color& c = dummycv[vc];
 				if (typeid(typename Eigen::PlainObjectBase<W>::Scalar) == typeid(float) ||
 						typeid(typename Eigen::PlainObjectBase<W>::Scalar) == typeid(double)) {
 					verticesColors(vc, 0) = c.redF();
@@ -473,14 +641,12 @@ bool loadTriangleMeshFromObj(
 					verticesColors(vc, 1) = c.green();
 					verticesColors(vc, 2) = c.blue();
 				}
-				vc++;
 			}
 		}
 		if (modality.hasFaceColors() && faceSizes.size() == dummyct.size()){
 			triangleColors.resize(faceSizes.size(), 3);
-			int vc = 0;
-			for (typename std::list<Color>::iterator it = dummyct.begin(); it != dummyct.end(); ++it) {
-				Color c = *it;
+			for (unsigned int vc = 0; vc < dummyct.size(); vc++) {
+				const Color& c = dummyct[vc];
 				if (typeid(typename Eigen::PlainObjectBase<X>::Scalar) == typeid(float) ||
 						typeid(typename Eigen::PlainObjectBase<X>::Scalar) == typeid(double)) {
 					triangleColors(vc, 0) = c.redF();
@@ -492,7 +658,6 @@ bool loadTriangleMeshFromObj(
 					triangleColors(vc, 1) = c.green();
 					triangleColors(vc, 2) = c.blue();
 				}
-				vc++;
 			}
 		}
 	}
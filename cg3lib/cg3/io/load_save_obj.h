@@ -31,12 +31,68 @@ bool loadMtlFile(
 		const std::string &mtuFile,
 		std::map<std::string, Color> &mapColors);
 
+bool readObjFile(const std::string& filename, std::vector<char>& buffer);
+
+bool isObjSpace(char c);
+const char* skipObjSpaces(const char* p, const char* end);
+const char* objTokenEnd(const char* p, const char* end);
+const char* objLineEnd(const char* line, const char* end);
+bool isObjToken(const char* begin, const char* end, const char* token);
+bool readObjNumber(const char*& p, const char* lineEnd, double& d);
+bool readObjInteger(const char*& p, const char* lineEnd, long int& i);
+
+/**
+ * @brief A mtllib or usemtl line of an obj file
+ */
+struct ObjMaterialLine
+{
+	size_t face; //number of faces of the chunk that precede the line
+	bool library; //true if mtllib, false if usemtl
+	std::string name;
+};
+
+/**
+ * @brief Elements read from a contiguous range of lines of an obj file
+ */
+template <typename T, typename V, typename C, typename W>
+struct ObjChunk
+{
+	std::vector<T> coords;
+	std::vector<C> verticesNormals;
+	std::vector<Color> verticesColors;
+	std::vector<V> faces;
+	std::vector<W> faceSizes;
+	std::vector<ObjMaterialLine> materials;
+};
+
+template <typename T, typename V, typename C, typename W>
+bool parseObjChunk(const char* begin, const char* end, ObjChunk<T, V, C, W>& chunk);
+
+std::vector<const char*> splitObjBuffer(const char* begin, const char* end, unsigned int nChunks);
+
+template <typename T, typename Chunk>
+void mergeObjChunks(
+		std::vector<T>& result,
+		std::vector<Chunk>& chunks,
+		std::vector<T> Chunk::* member);
+
 } //namespace cg3::internal
 
 /*
  * Load
  */
 template <typename T, typename V, typename C = double, typename W = unsigned int>
+bool loadMeshFromObj(
+		const std::string &filename,
+		std::vector<T>& coords,
+		std::vector<V>& faces,
+		io::FileMeshMode& modality = internal::dummyFileMeshMode,
+		std::vector<C>& verticesNormals = internal::dummyVectorDouble,
+		std::vector<Color>& verticesColors = internal::dummyVectorColor,
+		std::vector<Color>& faceColors = internal::dummyVectorColor2,
+		std::vector<W>& faceSizes = internal::dummyVectorUnsignedInt);
+
+template <typename T, typename V, typename C = double, typename W = unsigned int>
 bool loadMeshFromObj(
 		const std::string &filename,
 		std::list<T>& coords,
@@ -31,7 +31,7 @@ bool loadMeshFromPly(
 		std::vector<Color>& edgeColors,
 		std::vector<W>& faceSizes)
 {
-	std::ifstream file(filename.c_str());
+	std::ifstream file(filename.c_str(), std::ios::in | std::ios::binary);
 	if(!file.is_open()) {
 		std::cerr << "ERROR : read() : could not open input file " << filename.c_str() << "\n";
 		return false;
@@ -45,12 +45,13 @@ bool loadMeshFromPly(
 
 	uint nV = header.numberVertices();
 	uint nF = header.numberFaces();
-	uint nE = header.numberEdges();
+	uint nE = header.hasEdges() ? header.numberEdges() : 0;
 	std::vector<uint> vc, fc, ec; //v and f colors
 	std::vector<double> fn; //f normals
 	coords.resize(nV*3);
 	edges.resize(nE*2);
 	faces.clear();
+	faces.reserve(nF*3);
 	vertexNormals.resize(nV*3);
 	vc.resize(nV*4); //also alpha
 	fc.resize(nF*4); //also alpha
@@ -206,7 +207,7 @@ bool loadTriangleMeshFromPly(
 	bool r = loadMeshFromPly(filename, dummyc, dummyt, meshType,
 							 internal::dummyVectorDouble,
 							 internal::dummyVectorColor, internal::dummyVectorColor, faceSizes);
-	if (r == true && meshType.isTriangleMesh()){
+	if (r == true && !meshType.isTriangleMesh()){
 		std::cerr << "Warning: mesh contained on " << filename << " is not a triangle mesh\n";
 	}
 	if (r) {
@@ -341,6 +342,7 @@ bool loadTriangleMeshFromPly(
 	}
 	return r;
 }
+#endif
 
 template <typename A, typename B, typename E, typename C, typename D, typename T, typename V, typename X, typename W>
 bool saveMeshOnPly(
@@ -375,7 +377,7 @@ bool saveMeshOnPly(
 	header.setNumberVertices((unsigned long int)nVertices);
 	header.setNumberFaces((unsigned long int)nFaces);
 	header.setNumberEdges((unsigned long int)nEdges);
-	fp.open (plyfilename);
+	fp.open (plyfilename, std::ios::out | std::ios::binary);
 	if(!fp) {
 		return false;
 	}
@@ -434,7 +436,7 @@ inline bool saveMeshOnPly(
 	header.setModality(modality, binary);
         header.setNumberVertices((unsigned long int)nVertices);
         header.setNumberFaces((unsigned long int)nFaces);
-	fp.open (plyfilename);
+	fp.open (plyfilename, std::ios::out | std::ios::binary);
 	if(!fp) {
 		return false;
 	}
@@ -445,6 +447,4 @@ inline bool saveMeshOnPly(
 	return true;
 }
 
-#endif
-
 } //namespace std
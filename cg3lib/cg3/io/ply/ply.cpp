@@ -6,11 +6,99 @@
  */
 #include "ply.h"
 
+#include <cstring>
+
 namespace cg3 {
 namespace ply {
 
 namespace internal {
 
+inline BinaryReader::BinaryReader(std::ifstream& file) :
+	file(file),
+	buffer(BUFFER_SIZE),
+	position(0),
+	size(0),
+	error(false)
+{
+}
+
+inline BinaryReader::~BinaryReader()
+{
+	if (position < size)
+		file.seekg(-(std::streamoff)(size - position), std::ios::cur);
+}
+
+/**
+ * @brief Copies the next n bytes of the file in data.
+ * Large reads bypass the buffer and are done directly on data.
+ */
+inline void BinaryReader::read(char* data, std::size_t n)
+{
+	if (position + n <= size){
+		std::memcpy(data, buffer.data() + position, n);
+		position += n;
+		return;
+	}
+	std::size_t available = size - position;
+	std::memcpy(data, buffer.data() + position, available);
+	data += available;
+	n -= available;
+	position = size = 0;
+	if (n >= BUFFER_SIZE){
+		if (!file.read(data, n))
+			error = true;
+	}
+	else {
+		file.read(buffer.data(), BUFFER_SIZE);
+		size = file.gcount();
+		file.clear(); //the end of the file could have been reached
+		if (size < n){
+			error = true;
+			std::memset(data, 0, n);
+		}
+		else {
+			std::memcpy(data, buffer.data(), n);
+			position = n;
+		}
+	}
+}
+
+/**
+ * @brief Returns false if the reader tried to read beyond the end of the file.
+ */
+inline bool BinaryReader::good() const
+{
+	return !error;
+}
+
+inline BinaryWriter::BinaryWriter(std::ofstream& file) :
+	file(file),
+	buffer(BUFFER_SIZE),
+	size(0)
+{
+}
+
+inline BinaryWriter::~BinaryWriter()
+{
+	flush();
+}
+
+inline void BinaryWriter::write(const char* data, std::size_t n)
+{
+	if (size + n > BUFFER_SIZE)
+		flush();
+	std::memcpy(buffer.data() + size, data, n);
+	size += n;
+}
+
+inline void BinaryWriter::flush()
+{
+	if (size > 0){
+		file.write(buffer.data(), size);
+		size = 0;
+	}
+}
+
 template<typename T>
 void writeChar(std::ofstream& file, T p, bool bin, bool isColor)
 {
@@ -108,8 +196,54 @@ void writeProperty(std::ofstream& file, const T& p, PropertyType type, bool bin,
 	}
 }
 
+/**
+ * @brief Writes p as a binary value of type S, with the same conversions of the write functions.
+ */
+template <typename S, typename T>
+void writeBinary(BinaryWriter& file, T p, bool isColor)
+{
+	if (isColor && std::is_integral<S>::value && !std::is_integral<T>::value) p*= 255;
+	S tmp = p;
+	if (isColor && !std::is_integral<S>::value && std::is_integral<T>::value) tmp/= 255;
+	file.write((const char*)&tmp, sizeof(S));
+}
+
+template<typename T>
+void writeProperty(BinaryWriter& file, const T& p, PropertyType type, bool, bool isColor)
+{
+	switch (type) {
+		case CHAR:
+			writeBinary<char>(file, p, isColor); break;
+		case UCHAR:
+			writeBinary<unsigned char>(file, p, isColor); break;
+		case SHORT:
+			writeBinary<short>(file, p, isColor); break;
+		case USHORT:
+			writeBinary<unsigned short>(file, p, isColor); break;
+		case INT:
+			writeBinary<int>(file, p, isColor); break;
+		case UINT:
+			writeBinary<unsigned int>(file, p, isColor); break;
+		case FLOAT:
+			writeBinary<float>(file, p, isColor); break;
+		case DOUBLE:
+			writeBinary<double>(file, p, isColor); break;
+		default:
+			assert(0);
+	}
+}
+
+inline void newLine(std::ofstream& file)
+{
+	file << "\n";
+}
+
+inline void newLine(BinaryWriter&)
+{
+}
+
 template<typename T>
-T readChar(std::ifstream& file)
+T readChar(BinaryReader& file)
 {
 	char c;
 	file.read(&c, 1);
@@ -117,7 +251,7 @@ T readChar(std::ifstream& file)
 }
 
 template<typename T>
-T readUChar(std::ifstream& file)
+T readUChar(BinaryReader& file)
 {
 	unsigned char c;
 	file.read((char*)&c, 1);
@@ -125,7 +259,7 @@ T readUChar(std::ifstream& file)
 }
 
 template<typename T>
-T readShort(std::ifstream& file)
+T readShort(BinaryReader& file)
 {
 	short c;
 	file.read((char*)&c, 2);
@@ -133,7 +267,7 @@ T readShort(std::ifstream& file)
 }
 
 template<typename T>
-T readUShort(std::ifstream& file)
+T readUShort(BinaryReader& file)
 {
 	unsigned short c;
 	file.read((char*)&c, 2);
@@ -141,7 +275,7 @@ T readUShort(std::ifstream& file)
 }
 
 template<typename T>
-T readInt(std::ifstream& file)
+T readInt(BinaryReader& file)
 {
 	int c;
 	file.read((char*)&c, 4);
@@ -149,7 +283,7 @@ T readInt(std::ifstream& file)
 }
 
 template<typename T>
-T readUInt(std::ifstream& file)
+T readUInt(BinaryReader& file)
 {
 	unsigned int c;
 	file.read((char*)&c, 4);
@@ -157,7 +291,7 @@ T readUInt(std::ifstream& file)
 }
 
 template<typename T>
-T readFloat(std::ifstream& file, bool isColor)
+T readFloat(BinaryReader& file, bool isColor)
 {
 	float c;
 	file.read((char*)&c, 4);
@@ -167,7 +301,7 @@ T readFloat(std::ifstream& file, bool isColor)
 }
 
 template<typename T>
-T readDouble(std::ifstream& file, bool isColor)
+T readDouble(BinaryReader& file, bool isColor)
 {
 	double c;
 	file.read((char*)&c, 8);
@@ -177,7 +311,7 @@ T readDouble(std::ifstream& file, bool isColor)
 }
 
 template<typename T>
-T readProperty(std::ifstream& file, PropertyType type, bool isColor)
+T readProperty(BinaryReader& file, PropertyType type, bool isColor)
 {
 	T p;
 	switch (type) {
@@ -245,6 +379,8 @@ inline bool nextLine(std::ifstream& file, cg3::Tokenizer& tokenizer)
 		bool error = ! std::getline(file, line);
 		if (error)
 			return false;
+		if (!line.empty() && line[line.size()-1] == '\r')
+			line.erase(line.size()-1);
 		tokenizer = cg3::Tokenizer(line, ' ');
 	} while(tokenizer.begin() == tokenizer.end());
 	return true;
@@ -8,6 +8,7 @@
 #define CG3_PLY_H
 
 #include <list>
+#include <vector>
 #include <fstream>
 #include <assert.h>
 #include <cg3/utilities/tokenizer.h>
@@ -36,6 +37,50 @@ struct Element {
 
 namespace internal {
 
+/**
+ * @brief Reads the binary content of a ply file through a large memory buffer.
+ *
+ * When the reader is destroyed, the bytes that have been buffered but not read
+ * are given back to the file, whose position is left exactly after the last byte read.
+ */
+class BinaryReader
+{
+public:
+	BinaryReader(std::ifstream& file);
+	~BinaryReader();
+	void read(char* data, std::size_t n);
+	bool good() const;
+
+private:
+	static const std::size_t BUFFER_SIZE = 1 << 20;
+
+	std::ifstream& file;
+	std::vector<char> buffer;
+	std::size_t position;
+	std::size_t size;
+	bool error;
+};
+
+/**
+ * @brief Writes the binary content of a ply file in large blocks.
+ * The buffer is flushed on the file when it is full and when the writer is destroyed.
+ */
+class BinaryWriter
+{
+public:
+	BinaryWriter(std::ofstream& file);
+	~BinaryWriter();
+	void write(const char* data, std::size_t n);
+	void flush();
+
+private:
+	static const std::size_t BUFFER_SIZE = 1 << 20;
+
+	std::ofstream& file;
+	std::vector<char> buffer;
+	std::size_t size;
+};
+
 //write/bin
 
 template<typename T>
@@ -65,34 +110,44 @@ void writeDouble(std::ofstream& file, const T& p, bool bin = true, bool isColor
 template <typename T>
 void writeProperty(std::ofstream& file, const T& p, PropertyType type, bool bin = true, bool isColor = false);
 
+template <typename S, typename T>
+void writeBinary(BinaryWriter& file, T p, bool isColor);
+
+template <typename T>
+void writeProperty(BinaryWriter& file, const T& p, PropertyType type, bool bin = true, bool isColor = false);
+
+void newLine(std::ofstream& file);
+
+void newLine(BinaryWriter& file);
+
 //read/bin
 
 template<typename T>
-T readChar(std::ifstream& file);
+T readChar(BinaryReader& file);
 
 template<typename T>
-T readUChar(std::ifstream& file);
+T readUChar(BinaryReader& file);
 
 template<typename T>
-T readShort(std::ifstream& file);
+T readShort(BinaryReader& file);
 
 template<typename T>
-T readUShort(std::ifstream& file);
+T readUShort(BinaryReader& file);
 
 template<typename T>
-T readInt(std::ifstream& file);
+T readInt(BinaryReader& file);
 
 template<typename T>
-T readUInt(std::ifstream& file);
+T readUInt(BinaryReader& file);
 
 template<typename T>
-T readFloat(std::ifstream& file, bool isColor = false);
+T readFloat(BinaryReader& file, bool isColor = false);
 
 template<typename T>
-T readDouble(std::ifstream& file, bool isColor = false);
+T readDouble(BinaryReader& file, bool isColor = false);
 
 template <typename T>
-T readProperty(std::ifstream& file, PropertyType type, bool isColor = false);
+T readProperty(BinaryReader& file, PropertyType type, bool isColor = false);
 
 //read/txt
 
@@ -24,12 +24,12 @@ bool loadEdgesTxt(
 	if (colorMod == io::RGBA)
 		colorStep = 4;
 	cg3::Tokenizer spaceTokenizer;
-	error = internal::nextLine(file, spaceTokenizer);
+	error = !internal::nextLine(file, spaceTokenizer);
 	cg3::Tokenizer::iterator token = spaceTokenizer.begin();
 	for(uint e = 0; e < header.numberEdges(); ++e) {
-		for (ply::Property p : header.faceProperties()) {
+		for (const ply::Property& p : header.edgeProperties()) {
 			if (token == spaceTokenizer.end()){
-				error = nextLine(file, spaceTokenizer);
+				error = !nextLine(file, spaceTokenizer);
 				token = spaceTokenizer.begin();
 			}
 			if (error) return false;
@@ -81,58 +81,57 @@ bool loadEdgesBin(
 	uint colorStep = 3;
 	if (colorMod == io::RGBA)
 		colorStep = 4;
+	BinaryReader reader(file);
 	for(uint e = 0; e < header.numberEdges(); ++e) {
-		for (ply::Property p : header.faceProperties()) {
+		for (const ply::Property& p : header.edgeProperties()) {
 			switch (p.name) {
 			case ply::red :
-				edgeColors[e*colorStep] = internal::readProperty<B>(file, p.type); break;
+				edgeColors[e*colorStep] = internal::readProperty<B>(reader, p.type); break;
 			case ply::green :
-				edgeColors[e*colorStep+1] = internal::readProperty<B>(file, p.type); break;
+				edgeColors[e*colorStep+1] = internal::readProperty<B>(reader, p.type); break;
 			case ply::blue :
-				edgeColors[e*colorStep+2] = internal::readProperty<B>(file, p.type); break;
+				edgeColors[e*colorStep+2] = internal::readProperty<B>(reader, p.type); break;
 			case ply::alpha :
 				if (colorStep == 4)
-					edgeColors[e*colorStep+3] = internal::readProperty<B>(file, p.type);
+					edgeColors[e*colorStep+3] = internal::readProperty<B>(reader, p.type);
 				else
-					internal::readProperty<B>(file, p.type);
+					internal::readProperty<B>(reader, p.type);
 					;
 				break;
 			case ply::vertex1:
-				edges[e*2] = internal::readProperty<A>(file, p.type); break;
+				edges[e*2] = internal::readProperty<A>(reader, p.type); break;
 			case ply::vertex2:
-				edges[e*2+1] = internal::readProperty<A>(file, p.type); break;
+				edges[e*2+1] = internal::readProperty<A>(reader, p.type); break;
 			case ply::unknown :
 			default:
 				if (p.list){
-					uint s = internal::readProperty<int>(file, p.listSizeType);
+					uint s = internal::readProperty<int>(reader, p.listSizeType);
 					for (uint i = 0; i < s; ++i)
-						internal::readProperty<int>(file, p.type);
+						internal::readProperty<int>(reader, p.type);
 				}
 				else {
-					internal::readProperty<int>(file, p.type);
+					internal::readProperty<int>(reader, p.type);
 				}
 			}
 		}
 	}
-	return true;
+	return reader.good();
 }
 
-} //namespace cg3::ply::internal
-
-template <typename A, typename B>
-void saveEdges(
-		std::ofstream& file,
+template <typename Stream, typename A, typename B>
+void writeEdges(
+		Stream& file,
 		const PlyHeader& header,
 		const A edges[],
 		io::FileColorMode colorMod ,
-		const B edgeColors[])
+		const B edgeColors[],
+		bool bin)
 {
-	bool bin = header.format() == ply::BINARY;
 	uint colorStep = 3;
 	if (colorMod == io::RGBA)
 		colorStep = 4;
 	for(uint e = 0; e < header.numberEdges(); ++e) {
-		for (ply::Property p : header.edgeProperties()) {
+		for (const ply::Property& p : header.edgeProperties()) {
 			switch (p.name) {
 			case ply::red :
 				internal::writeProperty(file, edgeColors[e*colorStep], p.type, bin, true); break;
@@ -159,6 +158,25 @@ void saveEdges(
 	}
 }
 
+} //namespace cg3::ply::internal
+
+template <typename A, typename B>
+void saveEdges(
+		std::ofstream& file,
+		const PlyHeader& header,
+		const A edges[],
+		io::FileColorMode colorMod ,
+		const B edgeColors[])
+{
+	if (header.format() == ply::BINARY){
+		internal::BinaryWriter writer(file);
+		internal::writeEdges(writer, header, edges, colorMod, edgeColors, true);
+	}
+	else {
+		internal::writeEdges(file, header, edges, colorMod, edgeColors, false);
+	}
+}
+
 template <typename A, typename B>
 bool loadEdges(
 		std::ifstream& file,
@@ -33,6 +33,15 @@ bool loadEdgesBin(
 		io::FileColorMode colorMod ,
 		B edgeColors[]);
 
+template <typename Stream, typename A, typename B>
+void writeEdges(
+		Stream& file,
+		const PlyHeader& header,
+		const A edges[],
+		io::FileColorMode colorMod ,
+		const B edgeColors[],
+		bool bin);
+
 }
 
 template <typename A, typename B>
@@ -11,10 +11,10 @@ namespace ply {
 
 namespace internal {
 
-template <typename A, typename D>
+template <typename Stream, typename A, typename D>
 void saveFaceIndices(
-		std::ofstream& file,
-		Property p,
+		Stream& file,
+		const Property& p,
 		uint f,
 		uint& startingIndex,
 		const A faces[],
@@ -51,7 +51,7 @@ template <template <typename... Args> class Container, typename A, typename D>
 bool loadFaceIndicesTxt(
 		const cg3::Tokenizer& spaceTokenizer,
 		cg3::Tokenizer::iterator& token,
-		Property p,
+		const Property& p,
 		uint f,	
 		Container<A>& faces,
 		D polygonSizes[])
@@ -84,12 +84,12 @@ bool loadFacesTxt(
 	if (colorMod == io::RGBA)
 		colorStep = 4;
 	cg3::Tokenizer spaceTokenizer;
-	error = internal::nextLine(file, spaceTokenizer);
+	error = !internal::nextLine(file, spaceTokenizer);
 	cg3::Tokenizer::iterator token = spaceTokenizer.begin();
 	for(uint f = 0; f < header.numberFaces(); ++f) {
-		for (ply::Property p : header.faceProperties()) {
+		for (const ply::Property& p : header.faceProperties()) {
 			if (token == spaceTokenizer.end()){
-				error = nextLine(file, spaceTokenizer);
+				error = !nextLine(file, spaceTokenizer);
 				token = spaceTokenizer.begin();
 			}
 			if (error) return false;
@@ -151,8 +151,8 @@ bool loadFacesTxt(
 
 template <template <typename... Args> class Container, typename A, typename D>
 bool loadFaceIndicesBin(
-		std::ifstream& file,
-		Property p,
+		BinaryReader& file,
+		const Property& p,
 		uint f,
 		Container<A>& faces,
 		D polygonSizes[])
@@ -183,39 +183,40 @@ bool loadFacesBin(
 	uint colorStep = 3;
 	if (colorMod == io::RGBA)
 		colorStep = 4;
+	BinaryReader reader(file);
 	for(uint f = 0; f < header.numberFaces(); ++f) {
-		for (ply::Property p : header.faceProperties()) {
+		for (const ply::Property& p : header.faceProperties()) {
 			switch (p.name) {
 				case ply::nx :
-					faceNormals[f*3] = internal::readProperty<B>(file, p.type); break;
+					faceNormals[f*3] = internal::readProperty<B>(reader, p.type); break;
 				case ply::ny :
-					faceNormals[f*3+1] = internal::readProperty<B>(file, p.type); break;
+					faceNormals[f*3+1] = internal::readProperty<B>(reader, p.type); break;
 				case ply::nz :
-					faceNormals[f*3+2] = internal::readProperty<B>(file, p.type); break;
+					faceNormals[f*3+2] = internal::readProperty<B>(reader, p.type); break;
 				case ply::red :
-					faceColors[f*colorStep] = internal::readProperty<C>(file, p.type); break;
+					faceColors[f*colorStep] = internal::readProperty<C>(reader, p.type); break;
 				case ply::green :
-					faceColors[f*colorStep+1] = internal::readProperty<C>(file, p.type); break;
+					faceColors[f*colorStep+1] = internal::readProperty<C>(reader, p.type); break;
 				case ply::blue :
-					faceColors[f*colorStep+2] = internal::readProperty<C>(file, p.type); break;
+					faceColors[f*colorStep+2] = internal::readProperty<C>(reader, p.type); break;
 				case ply::alpha :
 					if (colorStep == 4)
-						faceColors[f*colorStep+3] = internal::readProperty<C>(file, p.type);
+						faceColors[f*colorStep+3] = internal::readProperty<C>(reader, p.type);
 					else
-						internal::readProperty<C>(file, p.type);
+						internal::readProperty<C>(reader, p.type);
 						;
 					break;
 				case ply::vertex_indices :
-					loadFaceIndicesBin(file, p, f, faces, polygonSizes);
+					loadFaceIndicesBin(reader, p, f, faces, polygonSizes);
 					break;
 				default:
 					if (p.list){
-						uint s = internal::readProperty<int>(file, p.listSizeType);
+						uint s = internal::readProperty<int>(reader, p.listSizeType);
 						for (uint i = 0; i < s; ++i)
-							internal::readProperty<int>(file, p.type);
+							internal::readProperty<int>(reader, p.type);
 					}
 					else {
-						internal::readProperty<int>(file, p.type);
+						internal::readProperty<int>(reader, p.type);
 					}
 			}
 		}
@@ -234,29 +235,27 @@ bool loadFacesBin(
 				meshType = io::POLYGON_MESH;
 		}
 	}
-	return true;
+	return reader.good();
 }
 
-} //namespace cg3::ply::internal
-
-template <typename A, typename B, typename C, typename D>
-void saveFaces(
-		std::ofstream& file,
+template <typename Stream, typename A, typename B, typename C, typename D>
+void writeFaces(
+		Stream& file,
 		const PlyHeader& header,
 		const A faces[],
 		io::FileMeshMode meshMode,
 		const B faceNormals[],
 		io::FileColorMode colorMod ,
 		const C faceColors[],
-		const D polygonSizes[])
+		const D polygonSizes[],
+		bool bin)
 {
-	bool bin = header.format() == ply::BINARY;
 	uint colorStep = 3;
 	uint startingIndex = 0;
 	if (colorMod == io::RGBA)
 		colorStep = 4;
 	for(uint f = 0; f < header.numberFaces(); ++f) {
-		for (ply::Property p : header.faceProperties()) {
+		for (const ply::Property& p : header.faceProperties()) {
 			switch (p.name) {
 				case ply::nx :
 					internal::writeProperty(file, faceNormals[f*3], p.type, bin); break;
@@ -285,7 +284,29 @@ void saveFaces(
 			}
 		}
 		if (!bin)
-			file << std::endl;
+			newLine(file);
+	}
+}
+
+} //namespace cg3::ply::internal
+
+template <typename A, typename B, typename C, typename D>
+void saveFaces(
+		std::ofstream& file,
+		const PlyHeader& header,
+		const A faces[],
+		io::FileMeshMode meshMode,
+		const B faceNormals[],
+		io::FileColorMode colorMod ,
+		const C faceColors[],
+		const D polygonSizes[])
+{
+	if (header.format() == ply::BINARY){
+		internal::BinaryWriter writer(file);
+		internal::writeFaces(writer, header, faces, meshMode, faceNormals, colorMod, faceColors, polygonSizes, true);
+	}
+	else {
+		internal::writeFaces(file, header, faces, meshMode, faceNormals, colorMod, faceColors, polygonSizes, false);
 	}
 }
 
@@ -17,10 +17,10 @@ namespace ply {
 
 namespace internal {
 
-template <typename A, typename D>
+template <typename Stream, typename A, typename D>
 void saveFaceIndices(
-		std::ofstream& file,
-		Property p,
+		Stream& file,
+		const Property& p,
 		uint f,
 		uint& startingIndex,
 		const A faces[],
@@ -33,7 +33,7 @@ template <template <typename... Args> class Container, typename A, typename D>
 bool loadFaceIndicesTxt(
 		const cg3::Tokenizer& spaceTokenizer,
 		cg3::Tokenizer::iterator& token,
-		Property p,
+		const Property& p,
 		uint f,
 		Container<A>& faces,
 		D polygonSizes[]);
@@ -51,8 +51,8 @@ bool loadFacesTxt(
 
 template <template <typename... Args> class Container, typename A, typename D>
 bool loadFaceIndicesBin(
-		std::ifstream& file,
-		Property p,
+		BinaryReader& file,
+		const Property& p,
 		uint f,
 		Container<A>& faces,
 		D polygonSizes[]);
@@ -68,6 +68,18 @@ bool loadFacesBin(
 		C faceColors[],
 		D polygonSizes[]);
 
+template <typename Stream, typename A, typename B, typename C, typename D>
+void writeFaces(
+		Stream& file,
+		const PlyHeader& header,
+		const A faces[],
+		io::FileMeshMode meshMode,
+		const B faceNormals[],
+		io::FileColorMode colorMod ,
+		const C faceColors[],
+		const D polygonSizes[],
+		bool bin);
+
 } //namespace cg3::ply::internal
 
 template <typename A, typename B, typename C, typename D>
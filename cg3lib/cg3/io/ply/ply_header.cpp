@@ -48,7 +48,10 @@ CG3_INLINE PlyHeader::PlyHeader(ply::Format f, const ply::Element &vElement, con
 
 CG3_INLINE PlyHeader::PlyHeader(std::ifstream &file) :
 	_format(ply::UNKNOWN),
-	isValid(false)
+	isValid(false),
+	v(-1),
+	f(-1),
+	e(-1)
 {
 	std::setlocale(LC_NUMERIC, "en_US.UTF-8"); // makes sure "." is the decimal separator
 	if (file.is_open()){
@@ -61,6 +64,8 @@ CG3_INLINE PlyHeader::PlyHeader(std::ifstream &file) :
 			do {
 				error = !(std::getline(file,line));
 				if (!error){
+					if (!line.empty() && line[line.size()-1] == '\r')
+						line.erase(line.size()-1);
 					cg3::Tokenizer spaceTokenizer(line, ' ');
 					if (spaceTokenizer.begin() == spaceTokenizer.end()) continue;
 					cg3::Tokenizer::iterator token = spaceTokenizer.begin();
@@ -26,12 +26,12 @@ bool loadVerticesTxt(
 	if (colorMod == io::RGBA)
 		colorStep = 4;
 	cg3::Tokenizer spaceTokenizer;
-	error = internal::nextLine(file, spaceTokenizer);
+	error = !internal::nextLine(file, spaceTokenizer);
 	cg3::Tokenizer::iterator token = spaceTokenizer.begin();
 	for(uint v = 0; v < header.numberVertices(); ++v) {
-		for (ply::Property p : header.vertexProperties()) {
+		for (const ply::Property& p : header.vertexProperties()) {
 			if (token == spaceTokenizer.end()){
-				error = nextLine(file, spaceTokenizer);
+				error = !nextLine(file, spaceTokenizer);
 				token = spaceTokenizer.begin();
 			}
 			if (error) return false;
@@ -89,65 +89,79 @@ bool loadVerticesBin(
 	uint colorStep = 3;
 	if (colorMod == io::RGBA)
 		colorStep = 4;
+	BinaryReader reader(file);
+	const std::list<ply::Property>& properties = header.vertexProperties();
+
+	//vertices stored just as x y z with the type of the output array: they are copied directly
+	if (properties.size() == 3 && (std::is_same<A, float>::value || std::is_same<A, double>::value)){
+		PropertyType t = std::is_same<A, float>::value ? FLOAT : DOUBLE;
+		std::list<ply::Property>::const_iterator it = properties.begin();
+		bool xyz = it->name == ply::x && !it->list && it->type == t; ++it;
+		xyz = xyz && it->name == ply::y && !it->list && it->type == t; ++it;
+		xyz = xyz && it->name == ply::z && !it->list && it->type == t;
+		if (xyz){
+			reader.read((char*)vertices, sizeof(A) * 3 * header.numberVertices());
+			return reader.good();
+		}
+	}
+
 	for(uint v = 0; v < header.numberVertices(); ++v) {
-		for (ply::Property p : header.vertexProperties()) {
+		for (const ply::Property& p : properties) {
 			switch (p.name) {
 				case ply::x :
-					vertices[v*3] = internal::readProperty<A>(file, p.type); break;
+					vertices[v*3] = internal::readProperty<A>(reader, p.type); break;
 				case ply::y :
-					vertices[v*3+1] = internal::readProperty<A>(file, p.type); break;
+					vertices[v*3+1] = internal::readProperty<A>(reader, p.type); break;
 				case ply::z :
-					vertices[v*3+2] = internal::readProperty<A>(file, p.type); break;
+					vertices[v*3+2] = internal::readProperty<A>(reader, p.type); break;
 				case ply::nx :
-					vertexNormals[v*3] = internal::readProperty<B>(file, p.type); break;
+					vertexNormals[v*3] = internal::readProperty<B>(reader, p.type); break;
 				case ply::ny :
-					vertexNormals[v*3+1] = internal::readProperty<B>(file, p.type); break;
+					vertexNormals[v*3+1] = internal::readProperty<B>(reader, p.type); break;
 				case ply::nz :
-					vertexNormals[v*3+2] = internal::readProperty<B>(file, p.type); break;
+					vertexNormals[v*3+2] = internal::readProperty<B>(reader, p.type); break;
 				case ply::red :
-					vertexColors[v*colorStep] = internal::readProperty<C>(file, p.type, true); break;
+					vertexColors[v*colorStep] = internal::readProperty<C>(reader, p.type, true); break;
 				case ply::green :
-					vertexColors[v*colorStep+1] = internal::readProperty<C>(file, p.type, true); break;
+					vertexColors[v*colorStep+1] = internal::readProperty<C>(reader, p.type, true); break;
 				case ply::blue :
-					vertexColors[v*colorStep+2] = internal::readProperty<C>(file, p.type, true); break;
+					vertexColors[v*colorStep+2] = internal::readProperty<C>(reader, p.type, true); break;
 				case ply::alpha :
 					if (colorStep == 4)
-						vertexColors[v*colorStep+3] = internal::readProperty<C>(file, p.type, true);
+						vertexColors[v*colorStep+3] = internal::readProperty<C>(reader, p.type, true);
 					else
-						internal::readProperty<C>(file, p.type, true); //read without save anywhere
+						internal::readProperty<C>(reader, p.type, true); //read without save anywhere
 					break;
 				default:
 					if (p.list){
-						uint s = internal::readProperty<int>(file, p.listSizeType);
+						uint s = internal::readProperty<int>(reader, p.listSizeType);
 						for (uint i = 0; i < s; ++i)
-							internal::readProperty<int>(file, p.type);
+							internal::readProperty<int>(reader, p.type);
 					}
 					else {
-						internal::readProperty<int>(file, p.type);
+						internal::readProperty<int>(reader, p.type);
 					}
 			}
 		}
 	}
-	return true;
+	return reader.good();
 }
 
-} //namespace cg3::ply::internal
-
-template <typename A, typename B, typename C>
-void saveVertices(
-		std::ofstream& file,
+template <typename Stream, typename A, typename B, typename C>
+void writeVertices(
+		Stream& file,
 		const PlyHeader& header,
 		const A vertices[],
 		const B vertexNormals[],
 		io::FileColorMode colorMod ,
-		const C vertexColors[])
+		const C vertexColors[],
+		bool bin)
 {
-	bool bin = header.format() == ply::BINARY;
 	uint colorStep = 3;
 	if (colorMod == io::RGBA)
 		colorStep = 4;
 	for(uint v = 0; v < header.numberVertices(); ++v) {
-		for (ply::Property p : header.vertexProperties()) {
+		for (const ply::Property& p : header.vertexProperties()) {
 			switch (p.name) {
 				case ply::x :
 					internal::writeProperty(file, vertices[v*3], p.type, bin); break;
@@ -179,7 +193,27 @@ void saveVertices(
 			}
 		}
 		if (!bin)
-			file << std::endl;
+			newLine(file);
+	}
+}
+
+} //namespace cg3::ply::internal
+
+template <typename A, typename B, typename C>
+void saveVertices(
+		std::ofstream& file,
+		const PlyHeader& header,
+		const A vertices[],
+		const B vertexNormals[],
+		io::FileColorMode colorMod ,
+		const C vertexColors[])
+{
+	if (header.format() == ply::BINARY){
+		internal::BinaryWriter writer(file);
+		internal::writeVertices(writer, header, vertices, vertexNormals, colorMod, vertexColors, true);
+	}
+	else {
+		internal::writeVertices(file, header, vertices, vertexNormals, colorMod, vertexColors, false);
 	}
 }
 
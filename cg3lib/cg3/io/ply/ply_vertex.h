@@ -34,6 +34,16 @@ bool loadVerticesBin(
 		io::FileColorMode colorMod ,
 		C vertexColors[]);
 
+template <typename Stream, typename A, typename B, typename C>
+void writeVertices(
+		Stream& file,
+		const PlyHeader& header,
+		const A vertices[],
+		const B vertexNormals[],
+		io::FileColorMode colorMod ,
+		const C vertexColors[],
+		bool bin);
+
 } //namespace cg3::ply::internal
 
 template <typename A, typename B, typename C>
@@ -10,6 +10,7 @@
 #include <exception>
 #include <memory>
 #include <cstring>
+#include <iterator>
 #ifndef _MSC_VER
 #   include <cxxabi.h>
 #endif
@@ -94,7 +95,10 @@ inline void serializeObjectAttributes(
         const Args&... args)
 {
     std::ofstream file;
+    std::vector<char> fileBuffer(internal::SERIALIZATION_BUFFER_SIZE);
 
+    //a larger stream buffer reduces the number of write calls on the file
+    file.rdbuf()->pubsetbuf(fileBuffer.data(), fileBuffer.size());
     file.open (fileName, std::ios::out | std::ios::binary);
     if (file.is_open()){
         cg3::serializeObjectAttributes(s, file, args...);
@@ -126,7 +130,9 @@ inline void deserializeObjectAttributes(
         Args&... args)
 {
     std::ifstream file;
+    std::vector<char> fileBuffer(internal::SERIALIZATION_BUFFER_SIZE);
 
+    file.rdbuf()->pubsetbuf(fileBuffer.data(), fileBuffer.size());
     file.open (fileName, std::ios::in | std::ios::binary);
     if (file.is_open()){
         cg3::deserializeObjectAttributes(s, file, args...);
@@ -252,8 +258,8 @@ inline void deserialize(
     static_assert(std::is_base_of<SerializableObject, T>::value || std::is_fundamental<T>::value || std::is_enum<T>::value,
                   "Please provide cg3::deserialize specialization for this type!");
     #endif
-    std::streampos begin = binaryFile.tellg();
     if (std::is_base_of<SerializableObject, T>::value){
+        std::streampos begin = binaryFile.tellg();
         SerializableObject* o =(SerializableObject*) &obj;
         try {
             o->deserialize(binaryFile);
@@ -269,7 +275,11 @@ inline void deserialize(
     }
     else{ //primitive type deserialization
         if (! binaryFile.read(reinterpret_cast<char*>(&obj), sizeof(T))){
-            restoreFilePosition(binaryFile, begin);
+            //tellg is not called for every primitive: the position is restored
+            //moving back of the bytes actually read
+            std::streamsize n = binaryFile.gcount();
+            binaryFile.clear();
+            binaryFile.seekg(-n, std::ios_base::cur);
             throw std::ios_base::failure("Deserialization failed of " + internal::typeName<decltype(obj)>(false, false, false));
         }
     }
@@ -398,6 +408,225 @@ inline void deserialize(std::string& str, std::ifstream& binaryFile)
 
 }
 
+inline internal::BinaryFileWriter::BinaryFileWriter(std::ofstream& binaryFile) :
+    binaryFile(binaryFile),
+    buffer(SERIALIZATION_BUFFER_SIZE),
+    used(0)
+{
+}
+
+inline internal::BinaryFileWriter::~BinaryFileWriter()
+{
+    flush();
+}
+
+template<typename T>
+inline void internal::BinaryFileWriter::write(const T& obj)
+{
+    static_assert(isBulkSerializable<T>::value, "BinaryFileWriter can write only primitive types");
+    writeBytes(reinterpret_cast<const char*>(&obj), sizeof(T));
+}
+
+template<typename T1, typename T2>
+inline void internal::BinaryFileWriter::write(const std::pair<T1, T2>& p)
+{
+    write(p.first);
+    write(p.second);
+}
+
+/**
+ * @brief Writes on the file all the bytes stored in the buffer.
+ */
+inline void internal::BinaryFileWriter::flush()
+{
+    if (used > 0){
+        binaryFile.write(buffer.data(), used);
+        used = 0;
+    }
+}
+
+inline void internal::BinaryFileWriter::writeBytes(const char* data, std::size_t n)
+{
+    if (used + n > buffer.size())
+        flush();
+    std::memcpy(buffer.data() + used, data, n);
+    used += n;
+}
+
+inline internal::BinaryFileReader::BinaryFileReader(
+        std::ifstream& binaryFile,
+        unsigned long long int nBytes) :
+    binaryFile(binaryFile),
+    position(0),
+    remaining(nBytes)
+{
+}
+
+/**
+ * @throws std::ios_base::failure if there are not enough bytes on the file.
+ */
+template<typename T>
+inline void internal::BinaryFileReader::read(T& obj)
+{
+    static_assert(isBulkSerializable<T>::value, "BinaryFileReader can read only primitive types");
+    readBytes(reinterpret_cast<char*>(&obj), sizeof(T));
+}
+
+template<typename T1, typename T2>
+inline void internal::BinaryFileReader::read(std::pair<T1, T2>& p)
+{
+    read(p.first);
+    read(p.second);
+}
+
+inline void internal::BinaryFileReader::readBytes(char* data, std::size_t n)
+{
+    if (position + n > buffer.size()){
+        //moves the unread bytes at the beginning of the buffer and refills it
+        std::size_t left = buffer.size() - position;
+        if (left > 0)
+            std::memmove(buffer.data(), buffer.data() + position, left);
+        std::size_t toRead = SERIALIZATION_BUFFER_SIZE - left;
+        if (toRead > remaining)
+            toRead = remaining;
+        buffer.resize(left + toRead);
+        position = 0;
+        if (! binaryFile.read(buffer.data() + left, toRead) || n > buffer.size())
+            throw std::ios_base::failure("Unexpected end of file");
+        remaining -= toRead;
+    }
+    std::memcpy(data, buffer.data() + position, n);
+    position += n;
+}
+
+/**
+ * @brief Serializes size contiguous objects.
+ * If their memory contains exactly the serialized bytes (primitive types), they are
+ * written with a single operation, otherwise they are serialized one by one.
+ */
+template<typename T>
+inline void internal::serializeBuffer(
+        const T* data,
+        unsigned long long int size,
+        std::ofstream& binaryFile)
+{
+    if (isRawSerializable<T>::value){
+        binaryFile.write(reinterpret_cast<const char*>(data), size * sizeof(T));
+    }
+    else {
+        serializeElements(data, data + size, binaryFile);
+    }
+}
+
+/**
+ * @brief Deserializes size contiguous objects, which must be already allocated.
+ * If their memory contains exactly the serialized bytes (primitive types), they are
+ * read with a single operation, otherwise they are deserialized one by one.
+ * @throws std::ios_base::failure if the objects cannot be deserialized.
+ */
+template<typename T>
+inline void internal::deserializeBuffer(
+        T* data,
+        unsigned long long int size,
+        std::ifstream& binaryFile)
+{
+    if (isRawSerializable<T>::value){
+        if (! binaryFile.read(reinterpret_cast<char*>(data), size * sizeof(T)))
+            throw std::ios_base::failure("Unexpected end of file");
+    }
+    else {
+        deserializeElements<T>(size, data, binaryFile);
+    }
+}
+
+namespace internal {
+
+template <typename Iterator>
+inline void serializeElements(
+        Iterator first,
+        Iterator last,
+        std::ofstream& binaryFile,
+        std::true_type)
+{
+    BinaryFileWriter writer(binaryFile);
+    for (; first != last; ++first)
+        writer.write(*first);
+}
+
+template <typename Iterator>
+inline void serializeElements(
+        Iterator first,
+        Iterator last,
+        std::ofstream& binaryFile,
+        std::false_type)
+{
+    for (; first != last; ++first)
+        serialize(*first, binaryFile);
+}
+
+} //namespace cg3::internal
+
+/**
+ * @brief Serializes all the objects in the range [first, last).
+ * Primitive types (and pairs of primitive types) are buffered and written in blocks.
+ */
+template<typename Iterator>
+inline void internal::serializeElements(
+        Iterator first,
+        Iterator last,
+        std::ofstream& binaryFile)
+{
+    typedef typename std::iterator_traits<Iterator>::value_type T;
+    serializeElements(first, last, binaryFile, isBulkSerializable<typename std::remove_cv<T>::type>());
+}
+
+namespace internal {
+
+template <typename T, typename OutputIterator>
+inline void deserializeElements(
+        unsigned long long int size,
+        OutputIterator out,
+        std::ifstream& binaryFile,
+        std::true_type)
+{
+    BinaryFileReader reader(binaryFile, size * isBulkSerializable<T>::bytes);
+    for (unsigned long long int i = 0; i < size; ++i){
+        T obj;
+        reader.read(obj);
+        *out++ = std::move(obj);
+    }
+}
+
+template <typename T, typename OutputIterator>
+inline void deserializeElements(
+        unsigned long long int size,
+        OutputIterator out,
+        std::ifstream& binaryFile,
+        std::false_type)
+{
+    for (unsigned long long int i = 0; i < size; ++i){
+        T obj;
+        deserialize(obj, binaryFile);
+        *out++ = std::move(obj);
+    }
+}
+
+} //namespace cg3::internal
+
+/**
+ * @brief Deserializes size objects of type T, assigning them in order to the output iterator.
+ * Primitive types (and pairs of primitive types) are read in blocks.
+ * @throws std::ios_base::failure if the objects cannot be deserialized.
+ */
+template<typename T, typename OutputIterator>
+inline void internal::deserializeElements(
+        unsigned long long int size,
+        OutputIterator out,
+        std::ifstream& binaryFile)
+{
+    deserializeElements<T>(size, out, binaryFile, isBulkSerializable<T>());
+}
+
 template<typename T>
 inline std::string internal::typeName(
         bool specifyIfConst,
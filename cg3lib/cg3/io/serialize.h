@@ -10,6 +10,9 @@
 
 #include "serializable_object.h"
 
+#include <vector>
+#include <utility>
+
 namespace cg3 {
 
 //utilities functions for the serialization of an entire object by its attributes
@@ -71,6 +74,128 @@ void deserialize(std::string& str, std::ifstream& binaryFile);
 
 namespace internal {
 
+/**
+ * @brief Tells if objects of type T are serialized as their raw bytes, and therefore
+ * if a range of them can be written/read with a single operation on the file.
+ * bytes is the number of bytes written for an object (pairs are serialized without padding).
+ */
+template <typename T>
+struct isBulkSerializable :
+        std::integral_constant<bool, std::is_fundamental<T>::value || std::is_enum<T>::value>
+{
+    static const std::size_t bytes = sizeof(T);
+};
+
+template <typename T1, typename T2>
+struct isBulkSerializable<std::pair<T1, T2>> :
+        std::integral_constant<bool, isBulkSerializable<T1>::value && isBulkSerializable<T2>::value>
+{
+    static const std::size_t bytes = isBulkSerializable<T1>::bytes + isBulkSerializable<T2>::bytes;
+};
+
+/**
+ * @brief Tells if a contiguous range of objects of type T has in memory exactly the
+ * bytes written by the serialization (no padding), and therefore can be written/read
+ * directly from memory.
+ */
+template <typename T>
+struct isRawSerializable :
+        std::integral_constant<bool, isBulkSerializable<T>::value && isBulkSerializable<T>::bytes == sizeof(T)>
+{
+};
+
+static const std::size_t SERIALIZATION_BUFFER_SIZE = 1 << 16;
+
+/**
+ * @brief Writes raw bytes on a binary file through a memory buffer,
+ * which is flushed on the file when it is full and when the writer is destroyed.
+ * Used to serialize sequences of bulk serializable objects with few write operations.
+ */
+class BinaryFileWriter
+{
+public:
+    BinaryFileWriter(std::ofstream& binaryFile);
+    ~BinaryFileWriter();
+
+    template <typename T>
+    void write(const T& obj);
+
+    template <typename T1, typename T2>
+    void write(const std::pair<T1, T2>& p);
+
+    void flush();
+
+private:
+    void writeBytes(const char* data, std::size_t n);
+
+    std::ofstream& binaryFile;
+    std::vector<char> buffer;
+    std::size_t used;
+};
+
+/**
+ * @brief Reads raw bytes from a binary file through a memory buffer.
+ * The reader never reads more than the given number of bytes from the file,
+ * hence the position of the file is exactly after the last object read when
+ * all the nBytes have been read.
+ */
+class BinaryFileReader
+{
+public:
+    BinaryFileReader(std::ifstream& binaryFile, unsigned long long int nBytes);
+
+    template <typename T>
+    void read(T& obj);
+
+    template <typename T1, typename T2>
+    void read(std::pair<T1, T2>& p);
+
+private:
+    void readBytes(char* data, std::size_t n);
+
+    std::ifstream& binaryFile;
+    std::vector<char> buffer;
+    std::size_t position;
+    unsigned long long int remaining;
+};
+
+/**
+ * @brief Output iterator that assigns the pairs written on it to a map (m[first] = second),
+ * hence if a key is written more than once, the last value is kept.
+ */
+template <typename Map>
+class MapAssignIterator
+{
+public:
+    MapAssignIterator(Map& m) : m(&m) {}
+
+    MapAssignIterator& operator * () { return *this; }
+    MapAssignIterator& operator ++ () { return *this; }
+    MapAssignIterator operator ++ (int) { return *this; }
+
+    template <typename Pair>
+    MapAssignIterator& operator = (Pair&& p)
+    {
+        (*m)[std::move(p.first)] = std::move(p.second);
+        return *this;
+    }
+
+private:
+    Map* m;
+};
+
+template <typename T>
+void serializeBuffer(const T* data, unsigned long long int size, std::ofstream& binaryFile);
+
+template <typename T>
+void deserializeBuffer(T* data, unsigned long long int size, std::ifstream& binaryFile);
+
+template <typename Iterator>
+void serializeElements(Iterator first, Iterator last, std::ofstream& binaryFile);
+
+template <typename T, typename OutputIterator>
+void deserializeElements(unsigned long long int size, OutputIterator out, std::ifstream& binaryFile);
+
 template <typename T>
 std::string typeName(bool specifyIfConst = true, bool specifyIfVolatile = true, bool specifyIfReference = true);
 
@@ -49,8 +49,7 @@ inline void serialize(const std::set<T, A...> &s, std::ofstream& binaryFile)
     unsigned long long int size = s.size();
     serialize("stdset", binaryFile);
     serialize(size, binaryFile);
-    for (typename std::set<T, A...>::const_iterator it = s.begin(); it != s.end(); ++it)
-        serialize((*it), binaryFile);
+    internal::serializeElements(s.begin(), s.end(), binaryFile);
 }
 
 /**
@@ -71,11 +70,7 @@ inline void deserialize(std::set<T, A...> &s, std::ifstream& binaryFile)
         if (str != "stdset")
             throw std::ios_base::failure("Mismatching String: " + str + " != stdset");
         deserialize(size, binaryFile);
-        for (unsigned int it = 0; it < size; ++it){
-            T obj;
-            deserialize(obj, binaryFile);
-            tmp.insert(obj);
-        }
+        internal::deserializeElements<T>(size, std::inserter(tmp, tmp.end()), binaryFile);
         s = std::move(tmp);
     }
     catch(std::ios_base::failure& e){
@@ -100,8 +95,7 @@ inline void serialize(const std::unordered_set<T, A...> &s, std::ofstream& binar
     unsigned long long int size = s.size();
     serialize("stdunorderedset", binaryFile);
     serialize(size, binaryFile);
-    for (typename std::unordered_set<T, A...>::const_iterator it = s.begin(); it != s.end(); ++it)
-        serialize((*it), binaryFile);
+    internal::serializeElements(s.begin(), s.end(), binaryFile);
 }
 
 /**
@@ -122,11 +116,7 @@ inline void deserialize(std::unordered_set<T, A...> &s, std::ifstream& binaryFil
         if (str != "stdunorderedset")
             throw std::ios_base::failure("Mismatching String: " + str + " != stdset");
         deserialize(size, binaryFile);
-        for (unsigned int it = 0; it < size; ++it){
-            T obj;
-            deserialize(obj, binaryFile);
-            tmp.insert(obj);
-        }
+        internal::deserializeElements<T>(size, std::inserter(tmp, tmp.end()), binaryFile);
         s = std::move(tmp);
     }
     catch(std::ios_base::failure& e){
@@ -154,13 +144,12 @@ inline void serialize(const std::vector<bool, A...> &v, std::ofstream& binaryFil
     serialize("stdvectorBool", binaryFile);
     serialize(size, binaryFile);
 
-    for(typename std::vector<bool, A...>::size_type i = 0; i < size;) {
-        unsigned char aggr = 0;
-        for(unsigned char mask = 1; mask > 0 && i < size; ++i, mask <<= 1)
-            if(v.at(i))
-                aggr |= mask;
-        binaryFile.write((const char*)&aggr, sizeof(unsigned char));
-    }
+    //bits are packed in a buffer which is written with a single operation
+    std::vector<unsigned char> bytes((size + 7) / 8, 0);
+    for(typename std::vector<bool, A...>::size_type i = 0; i < size; ++i)
+        if(v[i])
+            bytes[i / 8] |= (unsigned char)(1 << (i % 8));
+    binaryFile.write((const char*)bytes.data(), bytes.size());
 }
 
 /**
@@ -175,8 +164,7 @@ inline void serialize(const std::vector<T, A...> &v, std::ofstream& binaryFile)
     unsigned long long int size = v.size();
     serialize(std::string("stdvector"), binaryFile);
     serialize(size, binaryFile);
-    for (typename std::vector<T, A...>::const_iterator it = v.begin(); it != v.end(); ++it)
-        serialize((*it), binaryFile);
+    internal::serializeBuffer(v.data(), size, binaryFile);
 }
 
 /**
@@ -200,12 +188,11 @@ inline void deserialize(std::vector<bool, A...> &v, std::ifstream& binaryFile)
         deserialize(size, binaryFile);
         tmpv.resize(size);
 
-        for(typename std::vector<bool, A...>::size_type i = 0; i < size;) {
-            unsigned char aggr;
-            binaryFile.read((char*)&aggr, sizeof(unsigned char));
-            for(unsigned char mask = 1; mask > 0 && i < size; ++i, mask <<= 1)
-                tmpv.at(i) = aggr & mask;
-        }
+        std::vector<unsigned char> bytes((size + 7) / 8);
+        if (! binaryFile.read((char*)bytes.data(), bytes.size()))
+            throw std::ios_base::failure("Unexpected end of file");
+        for(typename std::vector<bool, A...>::size_type i = 0; i < size; ++i)
+            tmpv[i] = bytes[i / 8] & (1 << (i % 8));
         v = std::move(tmpv);
     }
     catch(std::ios_base::failure& e){
@@ -237,9 +224,7 @@ inline void deserialize(std::vector<T, A...> &v, std::ifstream& binaryFile)
             throw std::ios_base::failure("Mismatching String: " + s + " != stdvector");
         deserialize(size, binaryFile);
         tmpv.resize(size);
-        for (unsigned int it = 0; it < size; ++it){
-            deserialize(tmpv[it], binaryFile);
-        }
+        internal::deserializeBuffer(tmpv.data(), size, binaryFile);
         v = std::move(tmpv);
 
     }
@@ -265,8 +250,7 @@ inline void serialize(const std::list<T, A...> &l, std::ofstream& binaryFile)
     unsigned long long int size = l.size();
     serialize("stdlist", binaryFile);
     serialize(size, binaryFile);
-    for (typename std::list<T, A...>::const_iterator it = l.begin(); it != l.end(); ++it)
-        serialize((*it), binaryFile);
+    internal::serializeElements(l.begin(), l.end(), binaryFile);
 }
 
 /**
@@ -288,11 +272,7 @@ inline void deserialize(std::list<T, A...> &l, std::ifstream& binaryFile)
         if (s != "stdlist")
             throw std::ios_base::failure("Mismatching String: " + s + " != stdlist");
         deserialize(size, binaryFile);
-        for (unsigned int it = 0; it < size; ++it){
-            T obj;
-            deserialize(obj, binaryFile);
-            tmp.push_back(obj);
-        }
+        internal::deserializeElements<T>(size, std::back_inserter(tmp), binaryFile);
         l = std::move(tmp);
     }
     catch(std::ios_base::failure& e){
@@ -317,10 +297,7 @@ inline void serialize(const std::map<T1, T2, A...> &m, std::ofstream& binaryFile
     unsigned long long int size = m.size();
     serialize("stdmap", binaryFile);
     serialize(size, binaryFile);
-    for (typename std::map<T1, T2, A...>::const_iterator it = m.begin(); it != m.end(); ++it){
-        serialize((it->first), binaryFile);
-        serialize((it->second), binaryFile);
-    }
+    internal::serializeElements(m.begin(), m.end(), binaryFile);
 }
 
 /**
@@ -342,15 +319,7 @@ inline void deserialize(std::map<T1, T2, A...> &m, std::ifstream& binaryFile)
         if (s != "stdmap")
             throw std::ios_base::failure("Mismatching String: " + s + " != stdmap");
         deserialize(size, binaryFile);
-
-        for (unsigned int it = 0; it < size; ++it){
-            T1 o1;
-            T2 o2;
-
-            deserialize(o1, binaryFile);
-            deserialize(o2, binaryFile);
-            tmp[std::move(o1)] = std::move(o2);
-        }
+        internal::deserializeElements<std::pair<T1, T2>>(size, internal::MapAssignIterator<decltype(tmp)>(tmp), binaryFile);
         m = std::move(tmp);
     }
     catch(std::ios_base::failure& e){
@@ -375,10 +344,7 @@ inline void serialize(const std::unordered_map<T1, T2, A...> &m, std::ofstream&
     unsigned long long int size = m.size();
     serialize("stdunorderedmap", binaryFile);
     serialize(size, binaryFile);
-    for (typename std::unordered_map<T1, T2, A...>::const_iterator it = m.begin(); it != m.end(); ++it){
-        serialize((it->first), binaryFile);
-        serialize((it->second), binaryFile);
-    }
+    internal::serializeElements(m.begin(), m.end(), binaryFile);
 }
 
 /**
@@ -400,15 +366,7 @@ inline void deserialize(std::unordered_map<T1, T2, A...> &m, std::ifstream& bina
         if (s != "stdunorderedmap")
             throw std::ios_base::failure("Mismatching String: " + s + " != stdunorderedmap");
         deserialize(size, binaryFile);
-
-        for (unsigned int it = 0; it < size; ++it){
-            T1 o1;
-            T2 o2;
-
-            deserialize(o1, binaryFile);
-            deserialize(o2, binaryFile);
-            tmp[std::move(o1)] = std::move(o2);
-        }
+        internal::deserializeElements<std::pair<T1, T2>>(size, internal::MapAssignIterator<decltype(tmp)>(tmp), binaryFile);
         m = std::move(tmp);
     }
     catch(std::ios_base::failure& e){
@@ -433,8 +391,7 @@ inline void serialize(const std::array<T, A...> &a, std::ofstream& binaryFile)
     unsigned long long int size = a.size();
     serialize("stdarray", binaryFile);
     serialize(size, binaryFile);
-    for (typename std::array<T, A...>::const_iterator it = a.begin(); it != a.end(); ++it)
-        serialize((*it), binaryFile);
+    internal::serializeBuffer(a.data(), size, binaryFile);
 }
 
 /**
@@ -458,9 +415,7 @@ inline void deserialize(std::array<T, A...> &a, std::ifstream& binaryFile)
         if (size != a.size())
             throw std::ios_base::failure(std::string("Mismatching std::array size: ") + std::to_string(size) + " != " + std::to_string(a.size()));
         std::vector<T> tmp(size);
-        for (unsigned int it = 0; it < size; ++it){
-            deserialize(tmp[it], binaryFile);
-        }
+        internal::deserializeBuffer(tmp.data(), size, binaryFile);
         std::copy_n(tmp.begin(), size, a.begin());
     }
     catch(std::ios_base::failure& e){
@@ -20,6 +20,7 @@ HEADERS += \
     $$PWD/meshes/dcel/dcel_face_iterators.h \
     $$PWD/meshes/dcel/dcel_half_edge.h \
     $$PWD/meshes/dcel/dcel_iterators.h \
+    $$PWD/meshes/dcel/dcel_pool.h \
     $$PWD/meshes/dcel/dcel_struct.h \
     $$PWD/meshes/dcel/dcel_vertex.h \
     $$PWD/meshes/dcel/dcel_vertex_iterators.h \
@@ -46,6 +47,7 @@ SOURCES += \
     $$PWD/meshes/dcel/dcel_builder.cpp \
     $$PWD/meshes/dcel/dcel_face.cpp \
     $$PWD/meshes/dcel/dcel_half_edge.cpp \
+    $$PWD/meshes/dcel/dcel_pool.cpp \
     $$PWD/meshes/dcel/dcel_struct.cpp \
     $$PWD/meshes/dcel/dcel_vertex.cpp
 }
@@ -8,7 +8,6 @@
 #include "dcel_connected_components.h"
 #include "dcel_flooding.h"
 
-#include <cg3/utilities/set.h>
 #include "../dcel_builder.h"
 
 namespace cg3 {
@@ -23,29 +22,49 @@ bool isAConnectedComponent(InputIterator first,
                            InputIterator last)
 {
     struct Comp{
-        const std::set<const Dcel::Face*> &cf;
-        Comp(const std::set<const Dcel::Face*> &cf) : cf(cf) {}
+        const std::vector<bool> &cf;
+        Comp(const std::vector<bool> &cf) : cf(cf) {}
         bool operator()(const Dcel::Face* f) {
-            return cf.find(f) != cf.end();
+            return f->id() < cf.size() && cf[f->id()];
         }
     };
 
-    std::set<const Dcel::Face*> containedFaces(first, last);
+    if (first == last)
+        return true;
+
+    //faces of the range, marked by id
+    std::vector<bool> containedFaces;
+    unsigned int nFaces = 0;
+    for (InputIterator it = first; it != last; ++it){
+        unsigned int fid = (*it)->id();
+        if (containedFaces.size() <= fid)
+            containedFaces.resize(fid + 1, false);
+        if (!containedFaces[fid]){
+            containedFaces[fid] = true;
+            nFaces++;
+        }
+    }
+
     Comp comp(containedFaces);
-    const Dcel::Face* f = *(containedFaces.begin());
-    std::set<const Dcel::Face*> cc = floodBFS(f, comp);
+    std::vector<bool> visited;
+    std::vector<const Dcel::Face*> cc;
+    internal::floodFaces((const Dcel::Face*)*first, comp, false, visited, cc);
 
-    return cc.size() == containedFaces.size();
+    return cc.size() == nFaces;
 }
 
 inline std::vector<Dcel> connectedComponents(const Dcel &inputMesh)
 {
     std::vector<Dcel> cc;
 
-    std::vector< std::set<const Dcel::Face*> > cci = connectedComponents(inputMesh.faceBegin(), inputMesh.faceEnd());
+    std::vector<int> labels;
+    unsigned int nComponents = connectedComponents(inputMesh, labels);
 
-    if (cci.size() > 1) {
-        for (const std::set<const Dcel::Face*> &s : cci){
+    if (nComponents > 1) {
+        std::vector< std::vector<const Dcel::Face*> > cci(nComponents);
+        for (const Dcel::Face* f : inputMesh.faceIterator())
+            cci[labels[f->id()]].push_back(f);
+        for (const std::vector<const Dcel::Face*> &s : cci){
             DcelBuilder builder;
             for (const Dcel::Face* f : s){
                 builder.addFace(f->vertex1()->coordinate(), f->vertex2()->coordinate(), f->vertex3()->coordinate(), f->color(), f->id());
@@ -65,25 +84,99 @@ std::vector< std::set<const Dcel::Face*> > connectedComponents(
         InputIterator last)
 {
     struct Comp{
-        const std::set<const Dcel::Face*> &cf;
-        Comp(const std::set<const Dcel::Face*> &cf) : cf(cf) {}
+        const std::vector<bool> &cf;
+        Comp(const std::vector<bool> &cf) : cf(cf) {}
         bool operator()(const Dcel::Face* f) {
-            return cf.find(f) != cf.end();
+            return f->id() < cf.size() && cf[f->id()];
         }
     };
 
+    std::vector<bool> containedFaces;
+    for (InputIterator it = first; it != last; ++it){
+        unsigned int fid = (*it)->id();
+        if (containedFaces.size() <= fid)
+            containedFaces.resize(fid + 1, false);
+        containedFaces[fid] = true;
+    }
+
+    //the visited marks are shared by all the floodings: every face is visited once
     std::vector< std::set<const Dcel::Face*> > connectedComp;
-    std::set<const Dcel::Face*> containedFaces(first, last);
-
-    while (containedFaces.size() > 0){
-        Comp comp(containedFaces);
-        const Dcel::Face* f = *(containedFaces.begin());
-        std::set<const Dcel::Face*> cc = floodBFS(f, comp);
-        connectedComp.push_back(cc);
-        containedFaces = difference(containedFaces, cc);
+    Comp comp(containedFaces);
+    std::vector<bool> visited(containedFaces.size(), false);
+    std::vector<const Dcel::Face*> cc;
+    for (InputIterator it = first; it != last; ++it){
+        const Dcel::Face* f = *it;
+        if (!visited[f->id()]){
+            internal::floodFaces(f, comp, false, visited, cc);
+            connectedComp.push_back(std::set<const Dcel::Face*>(cc.begin(), cc.end()));
+        }
     }
     return connectedComp;
 }
 
+/**
+ * @brief Computes the connected components of the faces of a Dcel.
+ * @param[in] inputMesh
+ * @param[out] labels: for every face id, the index of the connected component
+ * of the face (-1 for ids of deleted faces)
+ * @return the number of connected components
+ */
+inline unsigned int connectedComponents(const Dcel& inputMesh, std::vector<int>& labels)
+{
+    return connectedComponents(inputMesh, labels, [](const Dcel::Face*, const Dcel::Face*){
+        return true;
+    });
+}
+
+/**
+ * @brief Computes the connected components of the faces of a Dcel, where two adjacent
+ * faces f1 and f2 belong to the same component only if c(f1, f2) returns true
+ * (e.g. faces with the same segmentation label).
+ *
+ * Every face is visited once using a BFS that uses the labels as visited marks:
+ * the complexity is linear in the number of faces.
+ *
+ * @param[in] inputMesh
+ * @param[out] labels: for every face id, the index of the connected component
+ * of the face (-1 for ids of deleted faces)
+ * @param[in] c: a structure which contains an operator () that takes two adjacent
+ * faces and returns a bool
+ * @return the number of connected components
+ */
+template <typename Comp>
+unsigned int connectedComponents(
+        const Dcel& inputMesh,
+        std::vector<int>& labels,
+        Comp c)
+{
+    labels.assign(internal::faceIdBound(inputMesh), -1);
+    std::vector<unsigned int> queue;
+    queue.reserve(inputMesh.numberFaces());
+
+    int nComponents = 0;
+    for (const Dcel::Face* seed : inputMesh.faceIterator()){
+        if (labels[seed->id()] >= 0)
+            continue;
+
+        labels[seed->id()] = nComponents;
+        queue.clear();
+        queue.push_back(seed->id());
+        for (unsigned int head = 0; head < queue.size(); ++head){
+            const Dcel::Face* f = inputMesh.face(queue[head]);
+            for (const Dcel::HalfEdge* he : f->incidentHalfEdgeIterator()){
+                if (he->twin() == nullptr || he->twin()->face() == nullptr)
+                    continue;
+                const Dcel::Face* adjacent = he->twin()->face();
+                if (labels[adjacent->id()] < 0 && c(f, adjacent)){
+                    labels[adjacent->id()] = nComponents;
+                    queue.push_back(adjacent->id());
+                }
+            }
+        }
+        nComponents++;
+    }
+    return nComponents;
+}
+
 } //namespace cg3::dcelAlgorithms
 } //namesoace cg3
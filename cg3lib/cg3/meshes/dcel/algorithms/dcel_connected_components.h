@@ -25,6 +25,14 @@ std::vector< std::set<const Dcel::Face*> > connectedComponents(
         InputIterator first,
         InputIterator last);
 
+unsigned int connectedComponents(const cg3::Dcel& inputMesh, std::vector<int>& labels);
+
+template <typename Comp>
+unsigned int connectedComponents(
+        const cg3::Dcel& inputMesh,
+        std::vector<int>& labels,
+        Comp c);
+
 } //namespace cg3::dcelAlgorithms
 } //namespace cg3
 
@@ -19,63 +19,19 @@ namespace cg3 {
 template <typename Comp>
 std::set<const Dcel::Face*> dcelAlgorithms::floodDFS(const Dcel::Face* seed, Comp c)
 {
-    std::set<const Dcel::Face*> faces;
-    std::vector<const Dcel::Face *> stack_faces; // only triangles with same label of
-                                                 //the patch will stay on the stack
-    if (!c(seed))
-        return  faces;
-
-    faces.insert(seed);
-
-    for (const Dcel::Face* adjacent : seed->adjacentFaceIterator()){
-        // adding neighbor triangles (if comp returns true) to the stack
-        if (c(adjacent)) stack_faces.push_back(adjacent);
-    }
-
-    // while there aren't other triangles on the stack
-    while (stack_faces.size() > 0) {
-        const Dcel::Face* fi = stack_faces[stack_faces.size()-1];
-        stack_faces.pop_back(); //pop
-        faces.insert(fi);
-        for (const Dcel::Face* adjacent : fi->adjacentFaceIterator()) {
-            if (c(adjacent)) {
-                if (faces.find(adjacent) == faces.end())
-                    stack_faces.push_back(adjacent);
-            }
-        }
-    }
-    return faces;
+    std::vector<bool> visited;
+    std::vector<const Dcel::Face*> flooded;
+    internal::floodFaces(seed, c, true, visited, flooded);
+    return std::set<const Dcel::Face*>(flooded.begin(), flooded.end());
 }
 
 template<typename Comp>
 std::set<unsigned int> dcelAlgorithms::floodDFS(const Dcel& d, unsigned int seed, Comp c)
 {
-    std::set<unsigned int> faces;
-    std::vector<const Dcel::Face *> stack_faces; // only triangles with same label of
-                                                 //the patch will stay on the stack
-    if (!c(d.face(seed)))
-        return  faces;
-
-    faces.insert(seed);
-
-    for (const Dcel::Face* adjacent : d.face(seed)->adjacentFaceIterator()){
-        // adding neighbor triangles (if comp returns true) to the stack
-        if (c(adjacent)) stack_faces.push_back(adjacent);
-    }
-
-    // while there aren't other triangles on the stack
-    while (stack_faces.size() > 0) {
-        const Dcel::Face* fi = stack_faces[stack_faces.size()-1];
-        stack_faces.pop_back(); //pop
-        faces.insert(fi->id());
-        for (const Dcel::Face* adjacent : fi->adjacentFaceIterator()) {
-            if (c(adjacent)) {
-                if (faces.find(adjacent->id()) == faces.end())
-                    stack_faces.push_back(adjacent);
-            }
-        }
-    }
-    return faces;
+    std::vector<bool> visited;
+    std::vector<const Dcel::Face*> flooded;
+    internal::floodFaces(d.face(seed), c, true, visited, flooded);
+    return internal::floodedIds(flooded);
 }
 
 /**
@@ -89,68 +45,160 @@ std::set<unsigned int> dcelAlgorithms::floodDFS(const Dcel& d, unsigned int seed
 template <typename Comp>
 std::set<const Dcel::Face*> dcelAlgorithms::floodBFS(const Dcel::Face* seed, Comp c)
 {
-    std::set<const cg3::Dcel::Face*> set;
-
-    if (!c(seed))
-        return  set;
+    std::vector<bool> visited;
+    std::vector<const Dcel::Face*> flooded;
+    internal::floodFaces(seed, c, false, visited, flooded);
+    return std::set<const Dcel::Face*>(flooded.begin(), flooded.end());
+}
 
-    set.insert(seed);
-    std::list<const cg3::Dcel::Face *> queue_faces; // only triangles with same label of
-                                                     //the patch will stay on the queue
-    for (const cg3::Dcel::Face* adjacent : seed->adjacentFaceIterator()){
-        if (c(adjacent))
-            queue_faces.push_back(adjacent);
-    }
+template<typename Comp>
+std::set<unsigned int> dcelAlgorithms::floodBFS(const Dcel& d, unsigned int seed, Comp c)
+{
+    std::vector<bool> visited;
+    std::vector<const Dcel::Face*> flooded;
+    internal::floodFaces(d.face(seed), c, false, visited, flooded);
+    return internal::floodedIds(flooded);
+}
 
-    // while there aren't other triangles on the stack
-    while (queue_faces.size() > 0) {
-        const cg3::Dcel::Face* fi = queue_faces.front();
-        queue_faces.pop_front(); //pop
-        if (set.find(fi) == set.end()){
-            set.insert(fi);
-            for (const cg3::Dcel::Face* adjacent : fi->adjacentFaceIterator()) {
-                if (c(adjacent) &&
-                        set.find(adjacent) == set.end()) {
-                    queue_faces.push_back(adjacent);
-                }
+/**
+ * @brief DcelAlgorithms::floodBFS
+ * executes a flood starting from the seed face and sets labels[f] = label for all the
+ * faces f reached such that c(f) returns true and labels[f] is negative.
+ * The labels are used as visited marks, and the queue of the BFS is a single array
+ * of face ids. Both grow only with the flooded faces, so a seed that is already
+ * labelled costs constant time and flooding every face from every seed is linear.
+ *
+ * @param d: the Dcel
+ * @param seed: id of the start face
+ * @param c: a structure which contains a single parameter operator () that takes a face
+ * and returns a bool
+ * @param[in/out] labels: label of every face, indexed by face id. Faces that can be
+ * flooded must have a negative label; if a face id is out of the vector, the vector is
+ * resized with -1
+ * @param label: non-negative label assigned to the flooded faces
+ * @return the number of flooded faces
+ */
+template<typename Comp>
+unsigned int dcelAlgorithms::floodBFS(
+        const Dcel& d,
+        unsigned int seed,
+        Comp c,
+        std::vector<int>& labels,
+        int label)
+{
+    if (seed < labels.size() && labels[seed] >= 0)
+        return 0;
+
+    const Dcel::Face* fseed = d.face(seed);
+    if (fseed == nullptr || !c(fseed))
+        return 0;
+
+    //every face is pushed once: the queue is an array of ids with a moving head
+    std::vector<unsigned int> queue;
+    if (labels.size() <= seed)
+        labels.resize(seed + 1, -1);
+    labels[seed] = label;
+    queue.push_back(seed);
+    for (unsigned int head = 0; head < queue.size(); ++head){
+        const Dcel::Face* f = d.face(queue[head]);
+        for (const Dcel::HalfEdge* he : f->incidentHalfEdgeIterator()){
+            if (he->twin() == nullptr || he->twin()->face() == nullptr)
+                continue;
+            const Dcel::Face* adjacent = he->twin()->face();
+            if (labels.size() <= adjacent->id())
+                labels.resize(adjacent->id() + 1, -1);
+            if (labels[adjacent->id()] < 0 && c(adjacent)){
+                labels[adjacent->id()] = label;
+                queue.push_back(adjacent->id());
             }
         }
     }
-    return set;
+    return queue.size();
 }
 
-template<typename Comp>
-std::set<unsigned int> dcelAlgorithms::floodBFS(const Dcel& d, unsigned int seed, Comp c)
+/**
+ * @brief Returns an upper bound of the ids of the faces of the Dcel,
+ * to be used as size of the containers indexed by face id.
+ */
+inline unsigned int dcelAlgorithms::internal::faceIdBound(const Dcel& d)
 {
-    std::set<unsigned int> set;
-
-    if (!c(d.face(seed)))
-        return  set;
+    unsigned int bound = 0;
+    for (const Dcel::Face* f : d.faceIterator())
+        bound = std::max(bound, f->id() + 1);
+    return bound;
+}
 
-    set.insert(seed);
-    const cg3::Dcel::Face* fseed = d.face(seed);
-    std::list<const cg3::Dcel::Face *> queue_faces; // only triangles with same label of
-                                                     //the patch will stay on the queue
-    for (const cg3::Dcel::Face* adjacent : fseed->adjacentFaceIterator()){
-        if (c(adjacent))
-            queue_faces.push_back(adjacent);
-    }
+/**
+ * @brief Returns the set of the ids of the flooded faces.
+ * The ids are sorted first, so the set is filled in linear time.
+ */
+inline std::set<unsigned int> dcelAlgorithms::internal::floodedIds(
+        const std::vector<const Dcel::Face*>& flooded)
+{
+    std::vector<unsigned int> ids;
+    ids.reserve(flooded.size());
+    for (const Dcel::Face* f : flooded)
+        ids.push_back(f->id());
+    std::sort(ids.begin(), ids.end());
+    return std::set<unsigned int>(ids.begin(), ids.end());
+}
 
-    // while there aren't other triangles on the stack
-    while (queue_faces.size() > 0) {
-        const cg3::Dcel::Face* fi = queue_faces.front();
-        queue_faces.pop_front(); //pop
-        if (set.find(fi->id()) == set.end()){
-            set.insert(fi->id());
-            for (const cg3::Dcel::Face* adjacent : fi->adjacentFaceIterator()) {
-                if (c(adjacent) &&
-                        set.find(adjacent->id()) == set.end()) {
-                    queue_faces.push_back(adjacent);
-                }
+/**
+ * @brief Flooding shared by floodDFS and floodBFS.
+ *
+ * The faces reached from the seed are appended to flooded, which is used also as
+ * the stack (depthFirst = true) or the queue (depthFirst = false) of the visit.
+ * Visited faces are marked in a bit vector indexed by face id, that grows if
+ * a face with a greater id is reached.
+ */
+template <typename Comp>
+void dcelAlgorithms::internal::floodFaces(
+        const Dcel::Face* seed,
+        Comp& c,
+        bool depthFirst,
+        std::vector<bool>& visited,
+        std::vector<const Dcel::Face*>& flooded)
+{
+    flooded.clear();
+    if (seed == nullptr || !c(seed))
+        return;
+
+    if (visited.size() <= seed->id())
+        visited.resize(seed->id() + 1, false);
+    visited[seed->id()] = true;
+
+    std::vector<const Dcel::Face*> stack;
+    if (depthFirst)
+        stack.push_back(seed);
+    else
+        flooded.push_back(seed);
+
+    size_t head = 0;
+    while (depthFirst ? !stack.empty() : head < flooded.size()) {
+        const Dcel::Face* fi;
+        if (depthFirst){
+            fi = stack.back();
+            stack.pop_back();
+            flooded.push_back(fi);
+        }
+        else {
+            fi = flooded[head++];
+        }
+        for (const Dcel::HalfEdge* he : fi->incidentHalfEdgeIterator()) {
+            if (he->twin() == nullptr || he->twin()->face() == nullptr)
+                continue;
+            const Dcel::Face* adjacent = he->twin()->face();
+            if (visited.size() <= adjacent->id())
+                visited.resize(adjacent->id() + 1, false);
+            if (!visited[adjacent->id()] && c(adjacent)) {
+                visited[adjacent->id()] = true;
+                if (depthFirst)
+                    stack.push_back(adjacent);
+                else
+                    flooded.push_back(adjacent);
             }
         }
     }
-    return set;
 }
 
 } //namespace cg3
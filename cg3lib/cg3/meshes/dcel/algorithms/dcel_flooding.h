@@ -35,6 +35,30 @@ std::set<const Dcel::Face*> floodBFS(const Dcel::Face* seed, Comp c);
 template <typename Comp>
 std::set<unsigned int> floodBFS(const Dcel& d, unsigned int seed, Comp c);
 
+template <typename Comp>
+unsigned int floodBFS(
+        const Dcel& d,
+        unsigned int seed,
+        Comp c,
+        std::vector<int>& labels,
+        int label);
+
+namespace internal {
+
+unsigned int faceIdBound(const Dcel& d);
+
+std::set<unsigned int> floodedIds(const std::vector<const Dcel::Face*>& flooded);
+
+template <typename Comp>
+void floodFaces(
+        const Dcel::Face* seed,
+        Comp& c,
+        bool depthFirst,
+        std::vector<bool>& visited,
+        std::vector<const Dcel::Face*>& flooded);
+
+} //namespace cg3::dcelAlgorithms::internal
+
 } //namespace cg3::dcelAlgorithms
 } //namespace cg3
 
@@ -8,14 +8,11 @@
 
 namespace cg3 {
 
-CG3_INLINE DcelBuilder::DcelBuilder(Dcel startingDcel) : d(startingDcel), updateNormalOnInsertion(true)
+CG3_INLINE DcelBuilder::DcelBuilder(Dcel startingDcel) :
+    d(startingDcel),
+    mapsUpToDate(false),
+    updateNormalOnInsertion(true)
 {
-    for (cg3::Dcel::Vertex* v : d.vertexIterator()) {
-        mapVertices[v->coordinate()] = v->id();
-    }
-    for (cg3::Dcel::HalfEdge* he : d.halfEdgeIterator()){
-        mapHalfEdges[std::make_pair(he->fromVertex()->id(), he->toVertex()->id())] = he->id();
-    }
 }
 
 CG3_INLINE Dcel& DcelBuilder::dcel()
@@ -25,14 +22,17 @@ CG3_INLINE Dcel& DcelBuilder::dcel()
 
 CG3_INLINE unsigned int DcelBuilder::addVertex(const Point3d& p, const Vec3d& n, const Color &c, int flag)
 {
-    if (mapVertices.find(p) == mapVertices.end()){
+    if (!mapsUpToDate)
+        updateMaps();
+    std::unordered_map<cg3::Point3d, unsigned int>::iterator it = mapVertices.find(p);
+    if (it == mapVertices.end()){
         cg3::Dcel::Vertex* v = d.addVertex(p, n, c);
         mapVertices[p] = v->id();
         v->setFlag(flag);
         return v->id();
     }
     else
-        return mapVertices[p];
+        return it->second;
 }
 
 CG3_INLINE int DcelBuilder::addFace(
@@ -67,32 +67,26 @@ CG3_INLINE int DcelBuilder::addFace(
 
 CG3_INLINE int DcelBuilder::addFace(const std::vector<uint>& vids, const Color& c, int flag)
 {
+    if (!mapsUpToDate)
+        updateMaps();
+
     //one of the ids does not exist in the dcel
     for (const uint& vid : vids)
         if (d.vertex(vid) == nullptr)
             return -1;
 
-    std::vector<std::pair<uint, uint>> pes;
-    for (uint i = 0; i < vids.size(); ++i){
-        pes.push_back(std::make_pair(vids[i], vids[(i+1)%vids.size()]));
-    }
-
     // one of the three edges already exists in the dcel ->
     // bad orientation of face or non edge-manifold mesh
-    for (const std::pair<uint, uint>& pe : pes)
-        if (mapHalfEdges.find(pe) != mapHalfEdges.end())
+    for (uint i = 0; i < vids.size(); ++i)
+        if (mapHalfEdges.find(edgeKey(vids[i], vids[(i+1)%vids.size()])) != mapHalfEdges.end())
             return -1;
 
     //looking for twins...
-    std::vector<std::pair<uint, uint>>  tpes;
-    for (const std::pair<uint, uint>& pe : pes)
-        tpes.push_back(std::make_pair(pe.second, pe.first));
-
-    std::vector<cg3::Dcel::HalfEdge*> tes(tpes.size(), nullptr);
+    std::vector<cg3::Dcel::HalfEdge*> tes(vids.size(), nullptr);
 
-    std::map<std::pair<unsigned int, unsigned int>, unsigned int>::iterator it;
-    for (uint i = 0; i < tpes.size(); ++i){
-        it = mapHalfEdges.find(tpes[i]);
+    std::unordered_map<unsigned long long int, unsigned int>::iterator it;
+    for (uint i = 0; i < vids.size(); ++i){
+        it = mapHalfEdges.find(edgeKey(vids[(i+1)%vids.size()], vids[i]));
         if (it != mapHalfEdges.end()){
             tes[i] = d.halfEdge(it->second);
             if (tes[i]->twin() != nullptr){
@@ -141,7 +135,7 @@ CG3_INLINE int DcelBuilder::addFace(const std::vector<uint>& vids, const Color&
 
         //mapHalfEdges
         mapHalfEdges.insert(std::make_pair(
-                                std::make_pair(vids[i], vids[(i+1)%vids.size()]),
+                                edgeKey(vids[i], vids[(i+1)%vids.size()]),
                                 hes[i]->id()));
 
     }
@@ -166,27 +160,10 @@ CG3_INLINE int DcelBuilder::addFace(
         const Color& c,
         int flag)
 {
-    unsigned int vid1, vid2, vid3;
-
-    //setting vids
-    std::map<cg3::Point3d, unsigned int>::iterator it;
-    it = mapVertices.find(p1);
-    if (it == mapVertices.end())
-        vid1 = addVertex(p1);
-    else
-        vid1 = it->second;
-
-    it = mapVertices.find(p2);
-    if (it == mapVertices.end())
-        vid2 = addVertex(p2);
-    else
-        vid2 = it->second;
-
-    it = mapVertices.find(p3);
-    if (it == mapVertices.end())
-        vid3 = addVertex(p3);
-    else
-        vid3 = it->second;
+    //addVertex returns the id of the vertex if it already exists
+    unsigned int vid1 = addVertex(p1);
+    unsigned int vid2 = addVertex(p2);
+    unsigned int vid3 = addVertex(p3);
 
     return addFace(vid1, vid2, vid3, c, flag);
 }
@@ -199,33 +176,10 @@ CG3_INLINE int DcelBuilder::addFace(
         const Color& c,
         int flag)
 {
-    unsigned int vid1, vid2, vid3, vid4;
-
-    //setting vids
-    std::map<cg3::Point3d, unsigned int>::iterator it;
-    it = mapVertices.find(p1);
-    if (it == mapVertices.end())
-        vid1 = addVertex(p1);
-    else
-        vid1 = it->second;
-
-    it = mapVertices.find(p2);
-    if (it == mapVertices.end())
-        vid2 = addVertex(p2);
-    else
-        vid2 = it->second;
-
-    it = mapVertices.find(p3);
-    if (it == mapVertices.end())
-        vid3 = addVertex(p3);
-    else
-        vid3 = it->second;
-
-    it = mapVertices.find(p4);
-    if (it == mapVertices.end())
-        vid4 = addVertex(p4);
-    else
-        vid4 = it->second;
+    unsigned int vid1 = addVertex(p1);
+    unsigned int vid2 = addVertex(p2);
+    unsigned int vid3 = addVertex(p3);
+    unsigned int vid4 = addVertex(p4);
 
     return addFace(vid1, vid2, vid3, vid4, c, flag);
 }
@@ -233,17 +187,36 @@ CG3_INLINE int DcelBuilder::addFace(
 CG3_INLINE int DcelBuilder::addFace(const std::vector<Point3d>& ps, const Color& c, int flag)
 {
     std::vector<uint> vids(ps.size());
-    std::map<cg3::Point3d, unsigned int>::iterator it;
-    for (uint i = 0; i < ps.size(); i++){
-        it = mapVertices.find(ps[i]);
-        if (it == mapVertices.end())
-            vids[i] = addVertex(ps[i]);
-        else
-            vids[i] = it->second;
-    }
+    for (uint i = 0; i < ps.size(); i++)
+        vids[i] = addVertex(ps[i]);
     return addFace(vids, c, flag);
 }
 
+/**
+ * @brief Replaces the Dcel of the builder with the given indexed mesh, built in a
+ * single linear pass (see Dcel::buildFromIndexedMesh).
+ *
+ * Vertices are not merged by coordinates. The maps used by the other insertion methods
+ * are rebuilt only if they are used afterwards.
+ *
+ * @param[in] coords: coordinates of the vertices
+ * @param[in] faceIndices: vertex indices of the faces
+ * @param[in] faceSizes: number of vertices of every face, empty if all the faces are triangles
+ * @return false if the input is not valid
+ */
+CG3_INLINE bool DcelBuilder::buildFromIndexedMesh(
+        const std::vector<Point3d>& coords,
+        const std::vector<uint>& faceIndices,
+        const std::vector<uint>& faceSizes)
+{
+    if (!d.buildFromIndexedMesh(coords, faceIndices, faceSizes))
+        return false;
+    mapVertices.clear();
+    mapHalfEdges.clear();
+    mapsUpToDate = false;
+    return true;
+}
+
 CG3_INLINE void DcelBuilder::finalize()
 {
     d.updateBoundingBox();
@@ -256,4 +229,27 @@ CG3_INLINE void DcelBuilder::setUpdateNormalOnInsertion(bool b)
     updateNormalOnInsertion = b;
 }
 
+CG3_INLINE unsigned long long int DcelBuilder::edgeKey(unsigned int fromVid, unsigned int toVid)
+{
+    return ((unsigned long long int)fromVid << 32) | toVid;
+}
+
+/**
+ * @brief Fills the maps of vertices and half edges with the content of the Dcel.
+ */
+CG3_INLINE void DcelBuilder::updateMaps()
+{
+    mapVertices.clear();
+    mapHalfEdges.clear();
+    mapVertices.reserve(d.numberVertices());
+    mapHalfEdges.reserve(d.numberHalfEdges());
+    for (const cg3::Dcel::Vertex* v : d.vertexIterator()) {
+        mapVertices[v->coordinate()] = v->id();
+    }
+    for (const cg3::Dcel::HalfEdge* he : d.halfEdgeIterator()){
+        mapHalfEdges[edgeKey(he->fromVertex()->id(), he->toVertex()->id())] = he->id();
+    }
+    mapsUpToDate = true;
+}
+
 }
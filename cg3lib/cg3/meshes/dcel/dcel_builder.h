@@ -66,15 +66,24 @@ public:
                 const Color &c = Color(128, 128, 128),
                 int flag = 0);
 
+    bool buildFromIndexedMesh(
+            const std::vector<cg3::Point3d>& coords,
+            const std::vector<uint>& faceIndices,
+            const std::vector<uint>& faceSizes = std::vector<uint>());
+
     void finalize();
 
     void setUpdateNormalOnInsertion(bool b = true);
 
 protected:
 
+    static unsigned long long int edgeKey(unsigned int fromVid, unsigned int toVid);
+    void updateMaps();
+
     cg3::Dcel d;
-    std::map<cg3::Point3d, unsigned int> mapVertices;
-    std::map<std::pair<unsigned int, unsigned int>, unsigned int> mapHalfEdges;
+    std::unordered_map<cg3::Point3d, unsigned int> mapVertices;
+    std::unordered_map<unsigned long long int, unsigned int> mapHalfEdges;
+    bool mapsUpToDate;
     bool updateNormalOnInsertion;
 };
 
@@ -16,6 +16,24 @@ class TemplatedDcel;
 
 namespace internal{
 
+/**
+ * @brief Hints the processor to load the element that will be visited a few
+ * iterations after the position it. Elements are stored in memory pools, hence
+ * a linear scan of the Dcel touches mostly contiguous memory.
+ */
+template <class Element>
+inline void prefetchElement(const std::vector<Element*>& v, unsigned int it)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    static const unsigned int PREFETCH_DISTANCE = 4;
+    if (it + PREFETCH_DISTANCE < v.size() && v[it + PREFETCH_DISTANCE] != nullptr)
+        __builtin_prefetch(v[it + PREFETCH_DISTANCE]);
+#else
+    (void) v;
+    (void) it;
+#endif
+}
+
 /**
  * @class DcelIterator
  * @brief Iterator that iterates on a vector of elements (Vertex, HalfEdge, Face) of the Dcel.
@@ -52,6 +70,7 @@ public:
         do {
             ++iterator;
         } while (iterator != vector->size() && (*vector)[iterator] == nullptr);
+        prefetchElement(*vector, iterator);
         return *this;
     };
     DcelIterator<Element> operator ++ (int) {
@@ -59,6 +78,7 @@ public:
         do {
             ++iterator;
         } while (iterator != vector->size() && (*vector)[iterator] == nullptr);
+        prefetchElement(*vector, iterator);
         return old;
     };
     DcelIterator<Element> operator -- () {
@@ -122,6 +142,7 @@ public:
         do {
             ++iterator;
         } while (iterator != vector->size() && (*vector)[iterator] == nullptr);
+        prefetchElement(*vector, iterator);
         return *this;
     };
     ConstDcelIterator<Element> operator ++ (int) {
@@ -129,6 +150,7 @@ public:
         do {
             ++iterator;
         } while (iterator != vector->size() && (*vector)[iterator] == nullptr);
+        prefetchElement(*vector, iterator);
         return old;
     };
     ConstDcelIterator<Element> operator -- () {
@@ -0,0 +1,171 @@
+/*
+ * This file is part of cg3lib: https://github.com/cg3hci/cg3lib
+ * This Source Code Form is subject to the terms of the GNU GPL 3.0
+ */
+#include "dcel_pool.h"
+
+namespace cg3 {
+namespace internal {
+
+template <class T>
+const size_t DcelPool<T>::MIN_BLOCK_SIZE;
+
+template <class T>
+DcelPool<T>::DcelPool() :
+    nextSlot(nullptr),
+    remainingSlots(0),
+    totalSlots(0)
+{
+}
+
+template <class T>
+DcelPool<T>::DcelPool(DcelPool&& other) :
+    DcelPool()
+{
+    swap(other);
+}
+
+template <class T>
+DcelPool<T>& DcelPool<T>::operator= (DcelPool&& other)
+{
+    clear();
+    swap(other);
+    return *this;
+}
+
+/**
+ * @brief Returns uninitialized memory for one element.
+ *
+ * The last released slot is reused if available, otherwise the slot is taken
+ * from the current block, which is stored after the previously allocated ones.
+ *
+ * @par Complexity:
+ *      \e O(1) amortized
+ */
+template <class T>
+T* DcelPool<T>::allocate()
+{
+    if (!freeSlots.empty()){
+        T* slot = freeSlots.back();
+        freeSlots.pop_back();
+        return slot;
+    }
+    if (remainingSlots == 0)
+        addBlock(totalSlots < MIN_BLOCK_SIZE ? MIN_BLOCK_SIZE : totalSlots);
+    T* slot = reinterpret_cast<T*>(nextSlot);
+    ++nextSlot;
+    --remainingSlots;
+    return slot;
+}
+
+/**
+ * @brief Gives back the slot of an element to the pool.
+ * The element must have been already destroyed.
+ * @param[in] element: pointer returned by allocate()
+ */
+template <class T>
+void DcelPool<T>::deallocate(T* element)
+{
+    freeSlots.push_back(element);
+}
+
+/**
+ * @brief Makes room for n elements in total, allocating the missing ones in a single block.
+ *
+ * Used before inserting a known number of elements: the unused slots of the current
+ * block are taken first, then the elements are stored contiguously in the new block,
+ * in the order of insertion.
+ *
+ * @param[in] n: number of elements
+ */
+template <class T>
+void DcelPool<T>::reserve(size_t n)
+{
+    if (totalSlots < n){
+        //the tail of the current block is kept in the free list, in order of address
+        for (size_t i = remainingSlots; i > 0; i--)
+            freeSlots.push_back(reinterpret_cast<T*>(nextSlot + i - 1));
+        remainingSlots = 0;
+        addBlock(n - totalSlots);
+    }
+}
+
+/**
+ * @brief Moves all the blocks of the other pool into this pool.
+ *
+ * The elements allocated in the other pool remain valid and will be
+ * released by this pool. At the end, the other pool is empty.
+ *
+ * @param[in] other
+ */
+template <class T>
+void DcelPool<T>::splice(DcelPool& other)
+{
+    if (other.blocks.empty())
+        return;
+    for (std::unique_ptr<Slot[]>& b : other.blocks)
+        blocks.push_back(std::move(b));
+    freeSlots.insert(freeSlots.end(), other.freeSlots.begin(), other.freeSlots.end());
+    for (size_t i = 0; i < other.remainingSlots; i++)
+        freeSlots.push_back(reinterpret_cast<T*>(other.nextSlot + i));
+    totalSlots += other.totalSlots;
+
+    other.blocks.clear();
+    other.freeSlots.clear();
+    other.nextSlot = nullptr;
+    other.remainingSlots = 0;
+    other.totalSlots = 0;
+}
+
+/**
+ * @brief Releases all the memory of the pool.
+ * All the elements must have been already destroyed.
+ */
+template <class T>
+void DcelPool<T>::clear()
+{
+    blocks.clear();
+    freeSlots.clear();
+    nextSlot = nullptr;
+    remainingSlots = 0;
+    totalSlots = 0;
+}
+
+template <class T>
+void DcelPool<T>::swap(DcelPool& other)
+{
+    using std::swap;
+    swap(blocks, other.blocks);
+    swap(freeSlots, other.freeSlots);
+    swap(nextSlot, other.nextSlot);
+    swap(remainingSlots, other.remainingSlots);
+    swap(totalSlots, other.totalSlots);
+}
+
+/**
+ * @brief Returns the number of elements that can be stored without
+ * allocating new blocks
+ */
+template <class T>
+size_t DcelPool<T>::capacity() const
+{
+    return totalSlots;
+}
+
+template <class T>
+void DcelPool<T>::addBlock(size_t size)
+{
+    blocks.push_back(std::unique_ptr<Slot[]>(new Slot[size]));
+    nextSlot = blocks.back().get();
+    remainingSlots = size;
+    totalSlots += size;
+}
+
+template <class T>
+void swap(DcelPool<T>& p1, DcelPool<T>& p2)
+{
+    p1.swap(p2);
+}
+
+} //namespace cg3::internal
+} //namespace cg3
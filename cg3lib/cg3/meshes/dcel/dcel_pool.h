@@ -0,0 +1,70 @@
+/*
+ * This file is part of cg3lib: https://github.com/cg3hci/cg3lib
+ * This Source Code Form is subject to the terms of the GNU GPL 3.0
+ */
+#ifndef CG3_DCEL_POOL_H
+#define CG3_DCEL_POOL_H
+
+#include <vector>
+#include <memory>
+#include <cstddef>
+#include <type_traits>
+
+namespace cg3 {
+namespace internal {
+
+/**
+ * @class DcelPool
+ * @brief Typed arena used by the Dcel to store its vertices, half edges and faces.
+ *
+ * Elements are stored in contiguous blocks of raw memory: the pool only manages
+ * the memory, the Dcel constructs the elements with placement new and destroys them
+ * explicitly before giving their slot back with deallocate().
+ * Blocks are never moved, hence the pointers returned by allocate() are stable
+ * until clear() is called. Released slots are kept in a LIFO free list and reused
+ * by the next allocations.
+ */
+template <class T>
+class DcelPool
+{
+public:
+    DcelPool();
+    DcelPool(DcelPool&& other);
+    DcelPool& operator= (DcelPool&& other);
+
+    T* allocate();
+    void deallocate(T* element);
+
+    void reserve(size_t n);
+    void splice(DcelPool& other);
+    void clear();
+    void swap(DcelPool& other);
+
+    size_t capacity() const;
+
+private:
+    typedef typename std::aligned_storage<sizeof(T), alignof(T)>::type Slot;
+
+    static const size_t MIN_BLOCK_SIZE = 256;
+
+    DcelPool(const DcelPool&) = delete;
+    DcelPool& operator= (const DcelPool&) = delete;
+
+    void addBlock(size_t size);
+
+    std::vector<std::unique_ptr<Slot[]>> blocks;
+    std::vector<T*> freeSlots;
+    Slot* nextSlot;
+    size_t remainingSlots;
+    size_t totalSlots;
+};
+
+template <class T>
+void swap(DcelPool<T>& p1, DcelPool<T>& p2);
+
+} //namespace cg3::internal
+} //namespace cg3
+
+#include "dcel_pool.cpp"
+
+#endif // CG3_DCEL_POOL_H
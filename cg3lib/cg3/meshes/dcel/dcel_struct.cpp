@@ -159,10 +159,21 @@ TemplatedDcel<V, HE, F>::TemplatedDcel(const TemplatedDcel<V, HE, F>& dcel)
     nHalfEdges = dcel.nHalfEdges;
     nFaces = dcel.nFaces;
     bBox = dcel.bBox;
-    std::map<const TemplatedDcel::Vertex*, TemplatedDcel::Vertex*> mapVertices;
-	std::map<const TemplatedDcel::HalfEdge*, TemplatedDcel::HalfEdge*>
-			mapHalfEdges;
-    std::map<const TemplatedDcel::Face*, TemplatedDcel::Face*> mapFaces;
+    vertexPool.reserve(nVertices);
+    halfEdgePool.reserve(nHalfEdges);
+    facePool.reserve(nFaces);
+
+    //ids are preserved: the copy of an element is at the same position of the original one
+    auto copyOfVertex = [this](const Vertex* v) -> Vertex* {
+        return v == nullptr ? nullptr : vertices[v->id()];
+    };
+    auto copyOfHalfEdge = [this](const HalfEdge* he) -> HalfEdge* {
+        return he == nullptr ? nullptr : halfEdges[he->id()];
+    };
+    auto copyOfFace = [this](const Face* f) -> Face* {
+        return f == nullptr ? nullptr : faces[f->id()];
+    };
+
     vertices.resize(dcel.vertices.size(), nullptr);
     #ifdef NDEBUG
 	vertexCoordinates.resize(dcel.vertexCoordinates.size(), Point3d());
@@ -171,23 +182,19 @@ TemplatedDcel<V, HE, F>::TemplatedDcel(const TemplatedDcel<V, HE, F>& dcel)
     #endif
     for (const TemplatedDcel::Vertex* ov : dcel.vertexIterator()) {
         TemplatedDcel::Vertex* v = addVertex(ov->id());
-        v->setId(ov->id());
         v->setCoordinate(ov->coordinate());
         v->setFlag(ov->flag());
         v->setCardinality(ov->cardinality());
         v->setNormal(ov->normal());
         v->setColor(ov->color());
-        mapVertices[ov] = v;
     }
 
     halfEdges.resize(dcel.halfEdges.size(), nullptr);
     for (const TemplatedDcel::HalfEdge* ohe : dcel.halfEdgeIterator()) {
         TemplatedDcel::HalfEdge* he = addHalfEdge(ohe->id());
-        he->setId(ohe->id());
         he->setFlag(ohe->flag());
-        he->setFromVertex(mapVertices[ohe->fromVertex()]);
-        he->setToVertex(mapVertices[ohe->toVertex()]);
-        mapHalfEdges[ohe] = he;
+        he->setFromVertex(copyOfVertex(ohe->fromVertex()));
+        he->setToVertex(copyOfVertex(ohe->toVertex()));
     }
 
     faces.resize(dcel.faces.size(), nullptr);
@@ -197,32 +204,30 @@ TemplatedDcel<V, HE, F>::TemplatedDcel(const TemplatedDcel<V, HE, F>& dcel)
     #endif
     for (const Face* of : dcel.faceIterator()){
         TemplatedDcel::Face* f = addFace(of->id());
-        f->setId(of->id());
         f->setColor(of->color());
         f->setFlag(of->flag());
         f->setNormal(of->normal());
         f->setArea(of->area());
-        f->setOuterHalfEdge(mapHalfEdges[of->outerHalfEdge()]);
+        f->setOuterHalfEdge(copyOfHalfEdge(of->outerHalfEdge()));
 		for (typename TemplatedDcel<V, HE, F>::Face::ConstInnerHalfEdgeIterator
 			 heit = of->innerHalfEdgeBegin();
 			 heit != of->innerHalfEdgeEnd();
 			 ++heit){
-            f->addInnerHalfEdge(mapHalfEdges[*heit]);
+            f->addInnerHalfEdge(copyOfHalfEdge(*heit));
         }
-        mapFaces[of] = f;
     }
 
     for (const TemplatedDcel::HalfEdge* ohe : dcel.halfEdgeIterator()) {
-        TemplatedDcel::HalfEdge* he = mapHalfEdges[ohe];
-        he->setNext(mapHalfEdges[ohe->next()]);
-        he->setPrev(mapHalfEdges[ohe->prev()]);
-        he->setTwin(mapHalfEdges[ohe->twin()]);
-        he->setFace(mapFaces[ohe->face()]);
+        TemplatedDcel::HalfEdge* he = halfEdges[ohe->id()];
+        he->setNext(copyOfHalfEdge(ohe->next()));
+        he->setPrev(copyOfHalfEdge(ohe->prev()));
+        he->setTwin(copyOfHalfEdge(ohe->twin()));
+        he->setFace(copyOfFace(ohe->face()));
     }
 
     for (const TemplatedDcel::Vertex* ov : dcel.vertexIterator()) {
-        TemplatedDcel::Vertex * v = mapVertices[ov];
-        v->setIncidentHalfEdge(mapHalfEdges[ov->incidentHalfEdge()]);
+        TemplatedDcel::Vertex * v = vertices[ov->id()];
+        v->setIncidentHalfEdge(copyOfHalfEdge(ov->incidentHalfEdge()));
     }
 }
 
@@ -239,6 +244,9 @@ TemplatedDcel<V, HE, F>::TemplatedDcel(TemplatedDcel<V, HE, F>&& dcel)
     unusedVids = std::move(dcel.unusedVids);
     unusedHeids = std::move(dcel.unusedHeids);
     unusedFids = std::move(dcel.unusedFids);
+    vertexPool = std::move(dcel.vertexPool);
+    halfEdgePool = std::move(dcel.halfEdgePool);
+    facePool = std::move(dcel.facePool);
     nVertices = std::move(dcel.nVertices);
     nHalfEdges = std::move(dcel.nHalfEdges);
     nFaces = std::move(dcel.nFaces);
@@ -293,15 +301,7 @@ TemplatedDcel<V, HE, F>::TemplatedDcel(const cinolib::Trimesh<> &trimesh)
 template <class V, class HE, class F>
 TemplatedDcel<V, HE, F>::~TemplatedDcel()
 {
-    for (unsigned int i=0; i<vertices.size(); i++)
-        if (vertices[i]!= nullptr)
-            delete vertices[i];
-    for (unsigned int i=0; i<halfEdges.size(); i++)
-        if (halfEdges[i] != nullptr)
-            delete halfEdges[i];
-    for (unsigned int i=0; i<faces.size(); i++)
-        if (faces[i] != nullptr)
-            delete faces[i];
+    destroyElements();
 }
 
 /***
@@ -1014,11 +1014,7 @@ typename TemplatedDcel<V, HE, F>::Vertex *TemplatedDcel<V, HE, F>::addVertex(
 		const Vec3d& n,
 		const Color& c)
 {
-    #ifdef NDEBUG
-    Vertex* last= new Vertex(*this);
-    #else
-    Vertex* last= new Vertex();
-    #endif
+    Vertex* last = newVertex();
     if (unusedVids.size() == 0) {
         last->setId(nVertices);
         vertices.push_back(last);
@@ -1033,10 +1029,10 @@ typename TemplatedDcel<V, HE, F>::Vertex *TemplatedDcel<V, HE, F>::addVertex(
         #endif
     }
     else {
-        int vid = *(unusedVids.begin());
+        unsigned int vid = unusedVids.back();
+        unusedVids.pop_back();
         last->setId(vid);
         vertices[vid] = last;
-        unusedVids.erase(vid);
         #ifdef NDEBUG
         vertexCoordinates[vid] = p;
         vertexNormals[vid] = n;
@@ -1063,22 +1059,18 @@ template <class V, class HE, class F>
 typename TemplatedDcel<V, HE, F>::HalfEdge*
 TemplatedDcel<V, HE, F>::addHalfEdge()
 {
-    #ifdef NDEBUG
-    HalfEdge* last = new HalfEdge(*this);
-    #else
-    HalfEdge* last = new HalfEdge();
-    #endif
+    HalfEdge* last = newHalfEdge();
     if (unusedHeids.size() == 0){
         last->setId(nHalfEdges);
         halfEdges.push_back(last);
         //halfEdgeLinks.push_back({-1, -1, -1, -1, -1, -1});
     }
     else {
-        int heid = *(unusedHeids.begin());
+        unsigned int heid = unusedHeids.back();
+        unusedHeids.pop_back();
         last->setId(heid);
         halfEdges[heid] = last;
         //halfEdgeLinks[heid] = {-1, -1, -1, -1, -1, -1};
-        unusedHeids.erase(heid);
     }
     nHalfEdges++;
     return last;
@@ -1099,11 +1091,7 @@ template <class V, class HE, class F>
 typename TemplatedDcel<V, HE, F>::Face*
 TemplatedDcel<V, HE, F>::addFace(const Vec3d& n, const Color& c)
 {
-    #ifdef NDEBUG
-    Face* last = new Face(*this);
-    #else
-    Face* last = new Face();
-    #endif
+    Face* last = newFace();
     if (unusedFids.size() == 0){
         last->setId(nFaces);
         faces.push_back(last);
@@ -1116,10 +1104,10 @@ TemplatedDcel<V, HE, F>::addFace(const Vec3d& n, const Color& c)
         #endif
     }
     else {
-        int fid = *(unusedFids.begin());
+        unsigned int fid = unusedFids.back();
+        unusedFids.pop_back();
         last->setId(fid);
         faces[fid] = last;
-        unusedFids.erase(fid);
         #ifdef NDEBUG
         faceNormals[fid] = n;
         faceColors[fid] = c;
@@ -1171,10 +1159,10 @@ bool TemplatedDcel<V, HE, F>::deleteVertex(typename TemplatedDcel::Vertex* v)
             } while (he != v->_incidentHalfEdge);
         }
         vertices[v->_id]=nullptr;
-        unusedVids.insert(v->_id);
+        unusedVids.push_back(v->_id);
         nVertices--;
 
-        delete v;
+        releaseVertex(v);
         return true;
     }
     else
@@ -1233,10 +1221,10 @@ bool TemplatedDcel<V, HE, F>::deleteHalfEdge(HalfEdge* he)
 			if (he->_fromVertex->_incidentHalfEdge == he)
 				he->_fromVertex->_incidentHalfEdge = nullptr;
         halfEdges[he->_id] = nullptr;
-        unusedHeids.insert(he->_id);
+        unusedHeids.push_back(he->_id);
         nHalfEdges--;
 
-        delete he;
+        releaseHalfEdge(he);
         return true;
     }
     else
@@ -1286,9 +1274,9 @@ bool TemplatedDcel<V, HE, F>::deleteFace(Face* f)
             } while (he != f->_innerHalfEdges[i]);
         }
         faces[f->id()]=nullptr;
-        unusedFids.insert(f->id());
+        unusedFids.push_back(f->id());
         nFaces--;
-        delete f;
+        releaseFace(f);
         return true;
     }
     else
@@ -1621,15 +1609,7 @@ void TemplatedDcel<V, HE, F>::recalculateIds()
 template <class V, class HE, class F>
 void TemplatedDcel<V, HE, F>::clear()
 {
-    for (unsigned int i=0; i<vertices.size(); i++)
-        if (vertices[i] != nullptr)
-            delete vertices[i];
-    for (unsigned int i=0; i<halfEdges.size(); i++)
-        if (halfEdges[i] != nullptr)
-            delete halfEdges[i];
-    for (unsigned int i=0; i<faces.size(); i++)
-        if (faces[i] != nullptr)
-            delete faces[i];
+    destroyElements();
     vertices.clear();
     halfEdges.clear();
     faces.clear();
@@ -1648,6 +1628,172 @@ void TemplatedDcel<V, HE, F>::clear()
     #endif
 }
 
+/**
+ * @brief Reserves the memory for the given number of vertices, half edges and faces.
+ *
+ * Elements added after this call are stored contiguously in memory, in order of
+ * insertion, without further allocations. Useful before building large meshes.
+ *
+ * @param[in] nv: total number of vertices
+ * @param[in] nhe: total number of half edges
+ * @param[in] nf: total number of faces
+ */
+template <class V, class HE, class F>
+void TemplatedDcel<V, HE, F>::reserve(unsigned int nv, unsigned int nhe, unsigned int nf)
+{
+    vertices.reserve(nv);
+    halfEdges.reserve(nhe);
+    faces.reserve(nf);
+    vertexPool.reserve(nv);
+    halfEdgePool.reserve(nhe);
+    facePool.reserve(nf);
+    #ifdef NDEBUG
+    vertexCoordinates.reserve(nv);
+    vertexNormals.reserve(nv);
+    vertexColors.reserve(nv);
+    faceNormals.reserve(nf);
+    faceColors.reserve(nf);
+    #endif
+}
+
+/**
+ * @brief Replaces the content of the Dcel with the given indexed mesh.
+ *
+ * The faces are given as a list of vertex indices: if faceSizes is empty, all the
+ * faces are triangles, otherwise faceSizes[i] is the number of vertices of the i-th
+ * face. The elements of the Dcel are allocated once, and twin half edges are paired
+ * by bucketing all the half edges by their smallest vertex id (counting sort): the
+ * whole mesh is built in linear time, without any search tree or hash table.
+ * If more than two half edges share the same edge (non-manifold mesh), only one
+ * pair of opposite half edges is set as twins.
+ *
+ * Face normals and areas and the bounding box are updated, vertex normals are not.
+ *
+ * @param[in] coords: coordinates of the vertices
+ * @param[in] faceIndices: vertex indices of the faces, in counterclockwise order
+ * @param[in] faceSizes: number of vertices of every face
+ * @return false if the input is not valid (in this case the Dcel is not modified)
+ * @par Complexity:
+ *      \e O(numVertices \e + \e NumHalfEdges)
+ */
+template <class V, class HE, class F>
+bool TemplatedDcel<V, HE, F>::buildFromIndexedMesh(
+        const std::vector<Point3d>& coords,
+        const std::vector<unsigned int>& faceIndices,
+        const std::vector<unsigned int>& faceSizes)
+{
+    const unsigned int nv = coords.size();
+    const unsigned int nhe = faceIndices.size();
+    const unsigned int nf = faceSizes.empty() ? nhe / 3 : faceSizes.size();
+
+    //input validation
+    if (faceSizes.empty()){
+        if (nhe % 3 != 0)
+            return false;
+    }
+    else {
+        size_t total = 0;
+        for (unsigned int size : faceSizes){
+            if (size < 3)
+                return false;
+            total += size;
+        }
+        if (total != nhe)
+            return false;
+    }
+    for (unsigned int vid : faceIndices)
+        if (vid >= nv)
+            return false;
+
+    clear();
+    reserve(nv, nhe, nf);
+
+    for (const Point3d& p : coords)
+        addVertex(p);
+
+    unsigned int first = 0;
+    for (unsigned int i = 0; i < nf; ++i){
+        const unsigned int size = faceSizes.empty() ? 3 : faceSizes[i];
+        Face* f = addFace();
+        HalfEdge* firstHe = nullptr;
+        HalfEdge* prev = nullptr;
+        for (unsigned int j = 0; j < size; ++j){
+            Vertex* from = vertices[faceIndices[first + j]];
+            Vertex* to = vertices[faceIndices[first + (j+1) % size]];
+            HalfEdge* he = addHalfEdge();
+            he->setFromVertex(from);
+            he->setToVertex(to);
+            he->setFace(f);
+            from->setIncidentHalfEdge(he);
+            from->incrementCardinality();
+            if (prev != nullptr){
+                he->setPrev(prev);
+                prev->setNext(he);
+            }
+            else
+                firstHe = he;
+            prev = he;
+        }
+        prev->setNext(firstHe);
+        firstHe->setPrev(prev);
+        f->setOuterHalfEdge(firstHe);
+        first += size;
+    }
+
+    //twins: half edges sorted by (smallest, greatest) endpoint with two stable counting
+    //sorts, then paired inside each run of equal endpoints (two for a manifold edge)
+    std::array<std::vector<unsigned int>, 2> endpoints; //greatest, smallest
+    endpoints[0].resize(nhe);
+    endpoints[1].resize(nhe);
+    for (unsigned int i = 0; i < nhe; ++i){
+        unsigned int v1 = halfEdges[i]->fromVertex()->id();
+        unsigned int v2 = halfEdges[i]->toVertex()->id();
+        endpoints[0][i] = std::max(v1, v2);
+        endpoints[1][i] = std::min(v1, v2);
+    }
+    std::vector<unsigned int> sorted(nhe), tmp(nhe);
+    for (unsigned int i = 0; i < nhe; ++i)
+        tmp[i] = i;
+    std::vector<unsigned int> position(nv + 1);
+    for (const std::vector<unsigned int>& key : endpoints){
+        std::fill(position.begin(), position.end(), 0);
+        for (unsigned int heid : tmp)
+            position[key[heid] + 1]++;
+        for (unsigned int v = 0; v < nv; ++v)
+            position[v+1] += position[v];
+        for (unsigned int heid : tmp)
+            sorted[position[key[heid]]++] = heid;
+        std::swap(tmp, sorted);
+    }
+
+    for (unsigned int begin = 0, end = 0; begin < nhe; begin = end){
+        while (end < nhe &&
+               endpoints[0][tmp[end]] == endpoints[0][tmp[begin]] &&
+               endpoints[1][tmp[end]] == endpoints[1][tmp[begin]])
+            ++end;
+        for (unsigned int i = begin; i < end; ++i){
+            HalfEdge* he = halfEdges[tmp[i]];
+            if (he->twin() != nullptr)
+                continue;
+            for (unsigned int j = i + 1; j < end; ++j){
+                HalfEdge* other = halfEdges[tmp[j]];
+                if (other->twin() == nullptr && other->fromVertex() == he->toVertex()){
+                    he->setTwin(other);
+                    other->setTwin(he);
+                    break;
+                }
+            }
+        }
+    }
+
+    for (Face* f : faceIterator()){
+        f->updateNormal();
+        f->updateArea();
+    }
+    updateBoundingBox();
+    return true;
+}
+
 #ifdef  CG3_CGAL_DEFINED
 /**
  * \~Italian
@@ -1894,8 +2040,7 @@ bool TemplatedDcel<V, HE, F>::loadFromObj(const std::string& filename)
 
 	if (loadMeshFromObj(filename, coords, faces, fm, vnorm, vcolor, fcolor, fsizes)){
         clear();
-		afterLoadFile(coords, faces, fm, vnorm, vcolor, fcolor, fsizes);
-        return true;
+		return afterLoadFile(coords, faces, fm, vnorm, vcolor, fcolor, fsizes);
     }
     else
         return false;
@@ -1926,8 +2071,7 @@ bool TemplatedDcel<V, HE, F>::loadFromPly(const std::string& filename)
 
 	if (loadMeshFromPly(filename, coords, faces, mode, vnorm, vcolor, fcolor, fsizes)){
         clear();
-		afterLoadFile(coords, faces, mode, vnorm, vcolor, fcolor, fsizes);
-        return true;
+		return afterLoadFile(coords, faces, mode, vnorm, vcolor, fcolor, fsizes);
     }
     else
 		return false;
@@ -1979,6 +2123,9 @@ void TemplatedDcel<V, HE, F>::swap(TemplatedDcel& d)
     std::swap(unusedVids, d.unusedVids);
     std::swap(unusedHeids, d.unusedHeids);
     std::swap(unusedFids, d.unusedFids);
+    vertexPool.swap(d.vertexPool);
+    halfEdgePool.swap(d.halfEdgePool);
+    facePool.swap(d.facePool);
     std::swap(nVertices, d.nVertices);
     std::swap(nHalfEdges, d.nHalfEdges);
     std::swap(nFaces, d.nFaces);
@@ -2106,23 +2253,26 @@ void TemplatedDcel<V, HE, F>::merge(TemplatedDcel&& d)
         if (vertices[v])
             vertices[v]->setId(v);
         else
-            unusedVids.insert(v);
+            unusedVids.push_back(v);
     }
     for (uint he = nhe;  he < halfEdges.size(); ++he){
         if (halfEdges[he])
             halfEdges[he]->setId(he);
         else
-            unusedHeids.insert(he);
+            unusedHeids.push_back(he);
     }
     for (uint f = nf;  f < faces.size(); ++f){
         if (faces[f])
             faces[f]->setId(f);
         else
-            unusedFids.insert(f);
+            unusedFids.push_back(f);
     }
     nVertices += d.nVertices;
     nHalfEdges += d.nHalfEdges;
     nFaces += d.nFaces;
+    vertexPool.splice(d.vertexPool);
+    halfEdgePool.splice(d.halfEdgePool);
+    facePool.splice(d.facePool);
 
     d.vertices.clear();
     d.halfEdges.clear();
@@ -2146,9 +2296,9 @@ void TemplatedDcel<V, HE, F>::serialize(std::ofstream& binaryFile) const
     cg3::serialize(nHalfEdges, binaryFile);
     cg3::serialize(nFaces, binaryFile);
     //Sets
-    cg3::serialize(unusedVids, binaryFile);
-    cg3::serialize(unusedHeids, binaryFile);
-    cg3::serialize(unusedFids, binaryFile);
+    cg3::serialize(std::set<int>(unusedVids.begin(), unusedVids.end()), binaryFile);
+    cg3::serialize(std::set<int>(unusedHeids.begin(), unusedHeids.end()), binaryFile);
+    cg3::serialize(std::set<int>(unusedFids.begin(), unusedFids.end()), binaryFile);
     //Vertices
     for (const TemplatedDcel::Vertex* v : vertexIterator()){
         int heid = -1;
@@ -2224,9 +2374,16 @@ void TemplatedDcel<V, HE, F>::deserialize(std::ifstream& binaryFile)
         cg3::deserialize(tmp.nVertices, binaryFile);
         cg3::deserialize(tmp.nHalfEdges, binaryFile);
         cg3::deserialize(tmp.nFaces, binaryFile);
-        cg3::deserialize(tmp.unusedVids, binaryFile);
-        cg3::deserialize(tmp.unusedHeids, binaryFile);
-        cg3::deserialize(tmp.unusedFids, binaryFile);
+        std::set<int> uvids, uheids, ufids;
+        cg3::deserialize(uvids, binaryFile);
+        cg3::deserialize(uheids, binaryFile);
+        cg3::deserialize(ufids, binaryFile);
+        tmp.unusedVids.assign(uvids.rbegin(), uvids.rend());
+        tmp.unusedHeids.assign(uheids.rbegin(), uheids.rend());
+        tmp.unusedFids.assign(ufids.rbegin(), ufids.rend());
+        tmp.vertexPool.reserve(tmp.nVertices);
+        tmp.halfEdgePool.reserve(tmp.nHalfEdges);
+        tmp.facePool.reserve(tmp.nFaces);
 
         //Vertices
         tmp.vertices.resize(tmp.nVertices+tmp.unusedVids.size(), nullptr);
@@ -2377,11 +2534,7 @@ TemplatedDcel<V, HE, F>& TemplatedDcel<V, HE, F>::operator = (TemplatedDcel<V, H
 template <class V, class HE, class F>
 typename TemplatedDcel<V, HE, F>::Vertex* TemplatedDcel<V, HE, F>::addVertex(int id)
 {
-    #ifdef NDEBUG
-    Vertex* last= new Vertex((DcelData&)*this);
-    #else
-    Vertex* last= new Vertex();
-    #endif
+    Vertex* last = newVertex();
     last->setId(id);
     vertices[id] = last;
     return last;
@@ -2399,11 +2552,7 @@ typename TemplatedDcel<V, HE, F>::Vertex* TemplatedDcel<V, HE, F>::addVertex(int
 template <class V, class HE, class F>
 typename TemplatedDcel<V, HE, F>::HalfEdge* TemplatedDcel<V, HE, F>::addHalfEdge(int id)
 {
-    #ifdef NDEBUG
-    HalfEdge* last = new HalfEdge(*this);
-    #else
-    HalfEdge* last = new HalfEdge();
-    #endif
+    HalfEdge* last = newHalfEdge();
     last->setId(id);
     halfEdges[id] = last;
     return last;
@@ -2421,16 +2570,105 @@ typename TemplatedDcel<V, HE, F>::HalfEdge* TemplatedDcel<V, HE, F>::addHalfEdge
 template <class V, class HE, class F>
 typename TemplatedDcel<V, HE, F>::Face* TemplatedDcel<V, HE, F>::addFace(int id)
 {
-    #ifdef NDEBUG
-    Face* last = new Face(*this);
-    #else
-    Face* last = new Face();
-    #endif
+    Face* last = newFace();
     last->setId(id);
     faces[id] = last;
     return last;
 }
 
+/**
+ * @brief Constructs a new Vertex in the vertex pool of the Dcel.
+ * The id of the vertex is not set.
+ */
+template <class V, class HE, class F>
+typename TemplatedDcel<V, HE, F>::Vertex* TemplatedDcel<V, HE, F>::newVertex()
+{
+    #ifdef NDEBUG
+    return new (vertexPool.allocate()) Vertex((DcelData&)*this);
+    #else
+    return new (vertexPool.allocate()) Vertex();
+    #endif
+}
+
+/**
+ * @brief Constructs a new HalfEdge in the half edge pool of the Dcel.
+ * The id of the half edge is not set.
+ */
+template <class V, class HE, class F>
+typename TemplatedDcel<V, HE, F>::HalfEdge* TemplatedDcel<V, HE, F>::newHalfEdge()
+{
+    #ifdef NDEBUG
+    return new (halfEdgePool.allocate()) HalfEdge(*this);
+    #else
+    return new (halfEdgePool.allocate()) HalfEdge();
+    #endif
+}
+
+/**
+ * @brief Constructs a new Face in the face pool of the Dcel.
+ * The id of the face is not set.
+ */
+template <class V, class HE, class F>
+typename TemplatedDcel<V, HE, F>::Face* TemplatedDcel<V, HE, F>::newFace()
+{
+    #ifdef NDEBUG
+    return new (facePool.allocate()) Face(*this);
+    #else
+    return new (facePool.allocate()) Face();
+    #endif
+}
+
+/**
+ * @brief Destroys a Vertex created with newVertex() and gives its memory back to the pool.
+ */
+template <class V, class HE, class F>
+void TemplatedDcel<V, HE, F>::releaseVertex(Vertex* v)
+{
+    v->~Vertex();
+    vertexPool.deallocate(v);
+}
+
+/**
+ * @brief Destroys a HalfEdge created with newHalfEdge() and gives its memory back to the pool.
+ */
+template <class V, class HE, class F>
+void TemplatedDcel<V, HE, F>::releaseHalfEdge(HalfEdge* he)
+{
+    he->~HalfEdge();
+    halfEdgePool.deallocate(he);
+}
+
+/**
+ * @brief Destroys a Face created with newFace() and gives its memory back to the pool.
+ */
+template <class V, class HE, class F>
+void TemplatedDcel<V, HE, F>::releaseFace(Face* f)
+{
+    f->~Face();
+    facePool.deallocate(f);
+}
+
+/**
+ * @brief Destroys all the elements of the Dcel and releases the memory of the pools.
+ * The vectors of elements are not modified.
+ */
+template <class V, class HE, class F>
+void TemplatedDcel<V, HE, F>::destroyElements()
+{
+    for (Vertex* v : vertices)
+        if (v != nullptr)
+            v->~Vertex();
+    for (HalfEdge* he : halfEdges)
+        if (he != nullptr)
+            he->~HalfEdge();
+    for (Face* f : faces)
+        if (f != nullptr)
+            f->~Face();
+    vertexPool.clear();
+    halfEdgePool.clear();
+    facePool.clear();
+}
+
 /**
  * \~Italian
  * @brief Funzione che, data in ingresso una faccia avente dei buchi, restituisce una singola lista di vertici di una faccia avente dummy edge.
@@ -2580,7 +2818,7 @@ void TemplatedDcel<V, HE, F>::toStdVectors(
 }
 
 template <class V, class HE, class F>
-void TemplatedDcel<V, HE, F>::afterLoadFile(
+bool TemplatedDcel<V, HE, F>::afterLoadFile(
         const std::list<double> &coords,
         const std::list<unsigned int> &faces,
 		const io::FileMeshMode& fm,
@@ -2589,107 +2827,45 @@ void TemplatedDcel<V, HE, F>::afterLoadFile(
         const std::list<Color> &fcolor,
         const std::list<unsigned int> &fsizes)
 {
-    std::vector<Vertex*> vertices;
-
-    std::map< std::pair<int,int>, HalfEdge* > edge;
-    typename std::map< std::pair<int,int>, HalfEdge* >::iterator eiter;
-
-    bool first = true;
-
-    std::list<double>::const_iterator vnit = vnorm.begin();
-    std::list<Color>::const_iterator vcit = vcolor.begin();
+    std::vector<Point3d> points;
+    points.reserve(coords.size() / 3);
     for (std::list<double>::const_iterator it = coords.begin(); it != coords.end(); ){
         double x = *(it++), y = *(it++), z = *(it++);
-        Point3d coord(x,y,z);
-        if (first) {
-            bBox.setMin(coord);
-            bBox.setMax(coord);
-            first = false;
-        }
-        bBox.min() = bBox.min().min(coord);
-        bBox.max() = bBox.max().max(coord);
-
-        Vertex* vid = addVertex(coord);
-
-        vertices.push_back(vid);
-
-		if (fm.hasVertexNormals()){
-            Vec3d norm;
-            norm.setX(*(vnit++));
-            norm.setY(*(vnit++));
-            norm.setZ(*(vnit++));
-            vid->setNormal(norm);
-        }
-		if (fm.hasVertexColors()){
-            vid->setColor(*(vcit++));
-        }
+        points.push_back(Point3d(x, y, z));
     }
 
-    std::list<unsigned int>::const_iterator fit = faces.begin();
-    std::list<Color>::const_iterator fcit = fcolor.begin();
-    for (std::list<unsigned int>::const_iterator fsit = fsizes.begin(); fsit != fsizes.end(); ++fsit){
-
-        unsigned int thisSize = *fsit;
-        std::vector<unsigned int> nid;
-        nid.reserve(thisSize);
-        for (unsigned int i = 0; i < thisSize; i++){
-            nid.push_back(*(fit++));
-        }
-        nid.push_back(nid[0]);
-
-        std::pair<int, int> p;
-        HalfEdge* eid = nullptr;
-        Face* fid = addFace();
-        HalfEdge* prev = nullptr;
-        HalfEdge* first = nullptr;
+    if (!buildFromIndexedMesh(
+                points,
+                std::vector<unsigned int>(faces.begin(), faces.end()),
+                std::vector<unsigned int>(fsizes.begin(), fsizes.end())))
+        return false;
 
-        for (unsigned int i=0; i<nid.size()-1; i++){
-            eid = addHalfEdge();
-            if (i==0) {
-                first = eid;
-                fid->setOuterHalfEdge(eid);
-            }
-            else {
-                eid->setPrev(prev);
-                prev->setNext(eid);
-            }
-            vertices[nid[i]]->setIncidentHalfEdge(eid);
-            eid->setFromVertex(vertices[nid[i]]);
-            vertices[nid[i]]->incrementCardinality();
-            eid->setToVertex(vertices[nid[i+1]]);
-            eid->setFace(fid);
-            p.first = nid[i+1];
-            p.second = nid[i];
-            eiter = edge.find(p);
-            if (eiter != edge.end()){
-                HalfEdge* twin = edge[p];
-                eid->setTwin(twin);
-                twin->setTwin(eid);
-                edge.erase(eiter);
+    if (fm.hasVertexNormals() || fm.hasVertexColors()){
+        std::list<double>::const_iterator vnit = vnorm.begin();
+        std::list<Color>::const_iterator vcit = vcolor.begin();
+        for (Vertex* v : vertexIterator()){
+            if (fm.hasVertexNormals()){
+                Vec3d norm;
+                norm.setX(*(vnit++));
+                norm.setY(*(vnit++));
+                norm.setZ(*(vnit++));
+                v->setNormal(norm);
             }
-            else {
-                p.first = nid[i];
-                p.second = nid[i+1];
-                edge[p] = eid;
+            if (fm.hasVertexColors()){
+                v->setColor(*(vcit++));
             }
-            prev = eid;
-        }
-        eid->setNext(first);
-        first->setPrev(eid);
-
-		if (fm.hasFaceColors()){
-            Color c = *(fcit++);
-            fid->setColor(c);
         }
-        else
-            fid->setColor(Color(128, 128, 128));
+    }
 
-        fid->updateNormal();
-        fid->updateArea();
+    if (fm.hasFaceColors()){
+        std::list<Color>::const_iterator fcit = fcolor.begin();
+        for (Face* f : faceIterator())
+            f->setColor(*(fcit++));
     }
 
 	if (! (fm.hasVertexNormals()))
         updateVertexNormals();
+    return true;
 }
 
 #ifdef  CG3_EIGENMESH_DEFINED
@@ -14,6 +14,7 @@
 #include <cg3/io/file_commons.h>
 #include "dcel_data.h"
 #include "dcel_iterators.h"
+#include "dcel_pool.h"
 
 #ifdef  CG3_EIGENMESH_DEFINED
 namespace cg3 {
@@ -216,6 +217,11 @@ public:
     void recalculateIds();
     void resetFaceColors();
     void clear();
+    void reserve(unsigned int nv, unsigned int nhe, unsigned int nf);
+    bool buildFromIndexedMesh(
+            const std::vector<Point3d>& coords,
+            const std::vector<unsigned int>& faceIndices,
+            const std::vector<unsigned int>& faceSizes = std::vector<unsigned int>());
     #ifdef  CG3_CGAL_DEFINED
     unsigned int triangulateFace(uint idf);
     void triangulate();
@@ -244,9 +250,12 @@ protected:
     std::vector<Vertex* >   vertices;
     std::vector<HalfEdge* > halfEdges;
     std::vector<Face* >     faces;
-    std::set<int>           unusedVids;
-    std::set<int>           unusedHeids;
-    std::set<int>           unusedFids;
+    std::vector<unsigned int> unusedVids;
+    std::vector<unsigned int> unusedHeids;
+    std::vector<unsigned int> unusedFids;
+    internal::DcelPool<Vertex>   vertexPool;
+    internal::DcelPool<HalfEdge> halfEdgePool;
+    internal::DcelPool<Face>     facePool;
     unsigned int            nVertices;
     unsigned int            nHalfEdges;
     unsigned int            nFaces;
@@ -260,6 +269,14 @@ protected:
     HalfEdge* addHalfEdge(int id);
     Face* addFace(int id);
 
+    Vertex* newVertex();
+    HalfEdge* newHalfEdge();
+    Face* newFace();
+    void releaseVertex(Vertex* v);
+    void releaseHalfEdge(HalfEdge* he);
+    void releaseFace(Face* f);
+    void destroyElements();
+
     std::vector<const Vertex*> makeSingleBorder(const Face *f)     const;
     void toStdVectors(
             std::vector<double> &vertices,
@@ -270,7 +287,7 @@ protected:
             std::vector<unsigned int> &faceSizes,
             std::vector<float> &faceColors) const;
 
-    void afterLoadFile(
+    bool afterLoadFile(
             const std::list<double>& coords,
             const std::list<unsigned int>& faces,
 			const io::FileMeshMode& fm,
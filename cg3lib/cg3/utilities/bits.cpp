@@ -0,0 +1,57 @@
+/*
+ * This file is part of cg3lib: https://github.com/cg3hci/cg3lib
+ * This Source Code Form is subject to the terms of the GNU GPL 3.0
+ */
+
+#include "bits.h"
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+namespace cg3 {
+
+/**
+ * @ingroup cg3core
+ * @brief Number of bits set in a 64 bit word
+ * @param[in] word: the word
+ * @return the number of bits equal to 1
+ */
+CG3_INLINE unsigned int popcount64(uint64_t word)
+{
+#ifdef _MSC_VER
+    return static_cast<unsigned int>(__popcnt64(word));
+#else
+    return static_cast<unsigned int>(__builtin_popcountll(word));
+#endif
+}
+
+/**
+ * @ingroup cg3core
+ * @brief Index of the least significant bit set in a 64 bit word
+ * @param[in] word: the word, it must be different from 0
+ * @return the number of trailing zeros of the word
+ */
+CG3_INLINE unsigned int countTrailingZeros64(uint64_t word)
+{
+#ifdef _MSC_VER
+    unsigned long index;
+    _BitScanForward64(&index, word);
+    return static_cast<unsigned int>(index);
+#else
+    return static_cast<unsigned int>(__builtin_ctzll(word));
+#endif
+}
+
+/**
+ * @ingroup cg3core
+ * @brief Mask of the n least significant bits of a 64 bit word
+ * @param[in] n: number of bits, from 0 to 64
+ * @return a word with the first n bits equal to 1 and the others equal to 0
+ */
+CG3_INLINE uint64_t lowBitsMask64(unsigned int n)
+{
+    return n >= 64 ? ~static_cast<uint64_t>(0) : (static_cast<uint64_t>(1) << n) - 1;
+}
+
+} //namespace cg3
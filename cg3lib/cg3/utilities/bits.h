@@ -0,0 +1,28 @@
+/*
+ * This file is part of cg3lib: https://github.com/cg3hci/cg3lib
+ * This Source Code Form is subject to the terms of the GNU GPL 3.0
+ */
+
+#ifndef CG3_BITS_H
+#define CG3_BITS_H
+
+#include <cstdint>
+
+#include "../cg3lib.h"
+
+namespace cg3 {
+
+unsigned int popcount64(uint64_t word);
+unsigned int countTrailingZeros64(uint64_t word);
+
+uint64_t lowBitsMask64(unsigned int n);
+
+} //namespace cg3
+
+#ifndef CG3_STATIC
+#define CG3_BITS_CPP "bits.cpp"
+#include CG3_BITS_CPP
+#undef CG3_BITS_CPP
+#endif //CG3_STATIC
+
+#endif // CG3_BITS_H
@@ -0,0 +1,74 @@
+#include "bounding_box_index.h"
+
+BoundingBoxIndex::BoundingBoxIndex()
+    : aabbTree(&aabbValueExtractor, &indexComparator)
+{
+
+}
+
+void BoundingBoxIndex::insert(size_t index, const cg3::BoundingBox2& box) {
+    aabbTree.insert(IndexedBoundingBox(index, box));
+}
+
+void BoundingBoxIndex::update(size_t index, const cg3::BoundingBox2& box) {
+    //Elements are compared by index only, so the old box is not needed to find them
+    aabbTree.erase(IndexedBoundingBox(index, box));
+    aabbTree.insert(IndexedBoundingBox(index, box));
+}
+
+void BoundingBoxIndex::erase(size_t index) {
+    aabbTree.erase(IndexedBoundingBox(index, cg3::BoundingBox2()));
+}
+
+void BoundingBoxIndex::query(const cg3::BoundingBox2& box, std::vector<size_t>& indexes) const {
+    if (aabbTree.empty())
+        return;
+
+    std::vector<AABBTree::iterator> out;
+    aabbTree.aabbOverlapQuery(IndexedBoundingBox(0, box), std::back_inserter(out));
+
+    indexes.reserve(indexes.size() + out.size());
+    for (const AABBTree::iterator& it : out) {
+        indexes.push_back((*it).first);
+    }
+}
+
+size_t BoundingBoxIndex::size() const {
+    return static_cast<size_t>(aabbTree.size());
+}
+
+void BoundingBoxIndex::clear() {
+    aabbTree.clear();
+}
+
+double BoundingBoxIndex::aabbValueExtractor(
+        const IndexedBoundingBox& indexedBox,
+        const cg3::AABBValueType& valueType,
+        const int& dim)
+{
+    const cg3::BoundingBox2& box = indexedBox.second;
+
+    if (valueType == cg3::AABBValueType::MIN) {
+        switch (dim) {
+        case 1:
+            return box.min().x();
+        case 2:
+            return box.min().y();
+        }
+    }
+    else if (valueType == cg3::AABBValueType::MAX) {
+        switch (dim) {
+        case 1:
+            return box.max().x();
+        case 2:
+            return box.max().y();
+        }
+    }
+    throw new std::runtime_error("Impossible to extract an AABB value.");
+}
+
+bool BoundingBoxIndex::indexComparator(
+        const IndexedBoundingBox& indexedBox1, const IndexedBoundingBox& indexedBox2)
+{
+    return indexedBox1.first < indexedBox2.first;
+}
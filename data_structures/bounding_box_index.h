@@ -0,0 +1,50 @@
+#ifndef BOUNDINGBOXINDEX_H
+#define BOUNDINGBOXINDEX_H
+
+#include <vector>
+#include <utility>
+
+#include <cg3/data_structures/trees/aabbtree.h>
+#include <cg3/geometry/bounding_box2.h>
+
+/**
+ * @brief Spatial index of elements stored in an external vector.
+ * Every element is identified by its index in the vector and bounded by a box,
+ * so that the elements overlapping a region (e.g. the visible part of the canvas) can be found quickly.
+ */
+class BoundingBoxIndex {
+
+public:
+
+    typedef std::pair<size_t, cg3::BoundingBox2> IndexedBoundingBox;
+    typedef cg3::AABBTree<2, IndexedBoundingBox> AABBTree;
+
+    BoundingBoxIndex();
+
+    void insert(size_t index, const cg3::BoundingBox2& box);
+    void update(size_t index, const cg3::BoundingBox2& box);
+    void erase(size_t index);
+
+    void query(const cg3::BoundingBox2& box, std::vector<size_t>& indexes) const;
+
+    size_t size() const;
+
+    void clear();
+
+
+    static double aabbValueExtractor(
+            const IndexedBoundingBox& indexedBox,
+            const cg3::AABBValueType& valueType,
+            const int& dim);
+
+    static bool indexComparator(
+            const IndexedBoundingBox& indexedBox1, const IndexedBoundingBox& indexedBox2);
+
+private:
+
+    //Queries on the cg3 trees are not const
+    mutable AABBTree aabbTree;
+
+};
+
+#endif // BOUNDINGBOXINDEX_H
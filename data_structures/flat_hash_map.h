@@ -0,0 +1,235 @@
+#ifndef FLATHASHMAP_H
+#define FLATHASHMAP_H
+
+#include <vector>
+#include <utility>
+#include <cstdint>
+#include <functional>
+#include <algorithm>
+#include <cstring>
+
+/**
+ * @brief Hash map with open addressing and linear probing.
+ * All the entries are stored in a single contiguous vector, so there is no allocation
+ * per entry and a lookup usually touches a single cache line.
+ * Entries cannot be erased: the map can only grow until it is cleared.
+ */
+template <class K, class V, class H = std::hash<K>>
+class FlatHashMap {
+
+public:
+
+    FlatHashMap();
+
+    V* find(const K& key);
+    const V* find(const K& key) const;
+
+    bool insert(const K& key, const V& value);
+
+    void reserve(size_t n);
+
+    size_t size() const;
+    bool empty() const;
+
+    void clear();
+
+private:
+
+    //Maximum load factor (numerator and denominator) and minimum number of slots
+    static const size_t MAX_LOAD_NUM = 3;
+    static const size_t MAX_LOAD_DEN = 4;
+    static const size_t MIN_CAPACITY = 16;
+
+    struct Slot {
+        K key;
+        V value;
+        bool occupied;
+    };
+
+    std::vector<Slot> slots;
+    size_t numberOfEntries;
+    H hasher;
+
+    size_t findSlot(const K& key) const;
+    void rehash(size_t capacity);
+
+};
+
+/**
+ * @brief Hash for doubles, it mixes all the bits of the value (-0.0 and 0.0 have the same hash)
+ */
+struct DoubleHash {
+    size_t operator()(double value) const;
+};
+
+/**
+ * @brief Hash for pairs of indexes
+ */
+struct IndexPairHash {
+    size_t operator()(const std::pair<size_t, size_t>& pair) const;
+};
+
+template <class K, class V, class H>
+FlatHashMap<K,V,H>::FlatHashMap() :
+    numberOfEntries(0)
+{
+
+}
+
+/**
+ * @brief Find the value associated to a key
+ * @param key Key
+ * @return Pointer to the value, nullptr if the key is not in the map.
+ * It is invalidated by the next insertion.
+ */
+template <class K, class V, class H>
+V* FlatHashMap<K,V,H>::find(const K& key)
+{
+    if (slots.empty())
+        return nullptr;
+
+    Slot& slot = slots[findSlot(key)];
+    return slot.occupied ? &slot.value : nullptr;
+}
+
+/**
+ * @brief Find the value associated to a key
+ * @param key Key
+ * @return Pointer to the value, nullptr if the key is not in the map.
+ * It is invalidated by the next insertion.
+ */
+template <class K, class V, class H>
+const V* FlatHashMap<K,V,H>::find(const K& key) const
+{
+    if (slots.empty())
+        return nullptr;
+
+    const Slot& slot = slots[findSlot(key)];
+    return slot.occupied ? &slot.value : nullptr;
+}
+
+/**
+ * @brief Insert a key with its value
+ * @param key Key
+ * @param value Value
+ * @return True if the key has been inserted, false if it was already in the map
+ * (its value is not modified)
+ */
+template <class K, class V, class H>
+bool FlatHashMap<K,V,H>::insert(const K& key, const V& value)
+{
+    if ((numberOfEntries + 1) * MAX_LOAD_DEN > slots.size() * MAX_LOAD_NUM)
+        rehash(std::max(slots.size() * 2, static_cast<size_t>(MIN_CAPACITY)));
+
+    Slot& slot = slots[findSlot(key)];
+    if (slot.occupied)
+        return false;
+
+    slot.key = key;
+    slot.value = value;
+    slot.occupied = true;
+    numberOfEntries++;
+
+    return true;
+}
+
+/**
+ * @brief Allocate the slots needed to store n entries without rehashing
+ * @param n Number of entries
+ */
+template <class K, class V, class H>
+void FlatHashMap<K,V,H>::reserve(size_t n)
+{
+    size_t capacity = MIN_CAPACITY;
+    while (n * MAX_LOAD_DEN > capacity * MAX_LOAD_NUM)
+        capacity *= 2;
+
+    if (capacity > slots.size())
+        rehash(capacity);
+}
+
+template <class K, class V, class H>
+size_t FlatHashMap<K,V,H>::size() const
+{
+    return numberOfEntries;
+}
+
+template <class K, class V, class H>
+bool FlatHashMap<K,V,H>::empty() const
+{
+    return numberOfEntries == 0;
+}
+
+template <class K, class V, class H>
+void FlatHashMap<K,V,H>::clear()
+{
+    slots.clear();
+    numberOfEntries = 0;
+}
+
+/**
+ * @brief Find the slot containing a key, or the empty slot where it would be inserted.
+ * The number of slots is a power of two and it is never full.
+ * @param key Key
+ * @return Index of the slot
+ */
+template <class K, class V, class H>
+size_t FlatHashMap<K,V,H>::findSlot(const K& key) const
+{
+    const size_t mask = slots.size() - 1;
+
+    size_t i = hasher(key) & mask;
+    while (slots[i].occupied && !(slots[i].key == key))
+        i = (i + 1) & mask;
+
+    return i;
+}
+
+/**
+ * @brief Move all the entries in a new vector of slots
+ * @param capacity Number of slots, a power of two
+ */
+template <class K, class V, class H>
+void FlatHashMap<K,V,H>::rehash(size_t capacity)
+{
+    std::vector<Slot> oldSlots(capacity, Slot{K(), V(), false});
+    oldSlots.swap(slots);
+
+    for (const Slot& oldSlot : oldSlots) {
+        if (oldSlot.occupied)
+            slots[findSlot(oldSlot.key)] = oldSlot;
+    }
+}
+
+/**
+ * @brief Finalizer of MurmurHash3: every bit of the input affects every bit of the output
+ * @param value Value
+ * @return Mixed value
+ */
+inline uint64_t mixHash(uint64_t value)
+{
+    value ^= value >> 33;
+    value *= 0xff51afd7ed558ccdULL;
+    value ^= value >> 33;
+    value *= 0xc4ceb9fe1a85ec53ULL;
+    value ^= value >> 33;
+    return value;
+}
+
+inline size_t DoubleHash::operator()(double value) const
+{
+    //-0.0 == 0.0, so they must have the same hash
+    if (value == 0)
+        value = 0;
+
+    uint64_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    return static_cast<size_t>(mixHash(bits));
+}
+
+inline size_t IndexPairHash::operator()(const std::pair<size_t, size_t>& pair) const
+{
+    return static_cast<size_t>(mixHash(static_cast<uint64_t>(pair.first) * 0x9e3779b97f4a7c15ULL ^ static_cast<uint64_t>(pair.second)));
+}
+
+#endif // FLATHASHMAP_H
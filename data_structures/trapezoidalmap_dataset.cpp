@@ -1,42 +1,26 @@
 #include "trapezoidalmap_dataset.h"
 
 TrapezoidalMapDataset::TrapezoidalMapDataset() :
-    boundingBox(cg3::Point2d(0,0),cg3::Point2d(0,0))
+    boundingBox(cg3::Point2d(0,0),cg3::Point2d(0,0)),
+    version(0),
+    editVersion(0),
+    validSegments(0)
 {
 
 }
 
 size_t TrapezoidalMapDataset::addPoint(const cg3::Point2d& point, bool& pointInserted)
 {
-    bool found;
-    size_t id = findPoint(point, found);
+    bool found, generalPosition;
+    size_t id = findPointByX(point, found, generalPosition);
 
     pointInserted = false;
 
-    bool generalPosition = true;
-    if (xCoordSet.find(point.x()) != xCoordSet.end()) {
-        generalPosition = false;
-    }
-
     //Point will be inserted
     if (!found && generalPosition) {
         pointInserted = true;
 
-        id = points.size();
-
-        //Add point
-        points.push_back(point);
-
-        pointMap.insert(std::make_pair(point, id));
-        xCoordSet.insert(point.x());
-
-        //Update bounding box
-        boundingBox.setMax(cg3::Point2d(
-                std::max(point.x(), boundingBox.max().x()),
-                std::max(point.y(), boundingBox.max().y())));
-        boundingBox.setMin(cg3::Point2d(
-                std::min(point.x(), boundingBox.min().x()),
-                std::min(point.y(), boundingBox.min().y())));
+        id = insertPoint(point);
     }
 
     return id;
@@ -52,65 +36,132 @@ size_t TrapezoidalMapDataset::addSegment(const cg3::Segment2d& segment, bool& se
         orderedSegment.setP2(segment.p1());
     }
 
-    bool found;
-    findSegment(orderedSegment, found);
-
     bool degenerate = orderedSegment.p1() == orderedSegment.p2();
 
     segmentInserted = false;
     id = std::numeric_limits<size_t>::max();
 
-    if (!degenerate && !found) {
-        bool generalPosition = true;
+    if (!degenerate) {
+        bool foundPoint1, generalPosition1;
+        size_t id1 = findPointByX(orderedSegment.p1(), foundPoint1, generalPosition1);
+        bool foundPoint2, generalPosition2;
+        size_t id2 = findPointByX(orderedSegment.p2(), foundPoint2, generalPosition2);
 
-        bool foundPoint1;
-        size_t id1 = findPoint(orderedSegment.p1(), foundPoint1);
-        bool foundPoint2;
-        size_t id2 = findPoint(orderedSegment.p2(), foundPoint2);
+        //A vertical segment would have two new points with the same x-coordinate
+        bool generalPosition = generalPosition1 && generalPosition2 &&
+                orderedSegment.p1().x() != orderedSegment.p2().x();
 
-        if (!foundPoint1 && xCoordSet.find(orderedSegment.p1().x()) != xCoordSet.end()) {
-            generalPosition = false;
-        }
-        if (!foundPoint2 && xCoordSet.find(orderedSegment.p2().x()) != xCoordSet.end()) {
-            generalPosition = false;
+        //The segment can already be in the dataset only if both its points are
+        bool found = false;
+        if (foundPoint1 && foundPoint2) {
+            findIndexedSegment(IndexedSegment2d(id1, id2), found);
         }
 
-        if (generalPosition) {
+        if (generalPosition && !found) {
             bool intersecting = intersectionChecker.checkIntersections(orderedSegment);
 
             if (!intersecting) {
                 segmentInserted = true;
 
-                id = indexedSegments.size();
+                id = insertSegment(orderedSegment, id1, id2);
+            }
+        }
+    }
+
+    return id;
+}
 
-                if (!foundPoint1) {
-                    bool insertedPoint1;
-                    id1 = addPoint(orderedSegment.p1(), insertedPoint1);
-                    assert(insertedPoint1);
-                }
+/**
+ * @brief Add a batch of segments, with the same result of calling addSegment on each of them in order.
+ * The expensive checks (intersections with the dataset and among the segments of the batch)
+ * are computed in parallel, then the segments are validated and inserted in order.
+ * @param[in] segments Segments
+ * @param[out] segmentsInserted For each segment, true if it has been inserted
+ * @return For each segment, its id (max size_t if it has not been inserted)
+ */
+std::vector<size_t> TrapezoidalMapDataset::addSegments(const std::vector<cg3::Segment2d>& segments, std::vector<bool>& segmentsInserted)
+{
+    const long long n = static_cast<long long>(segments.size());
+
+    std::vector<cg3::Segment2d> orderedSegments(segments.size());
+    std::vector<char> candidates(segments.size(), false);
+
+    //Checks which do not depend on the other segments of the batch
+    #pragma omp parallel for schedule(dynamic, 256)
+    for (long long i = 0; i < n; i++) {
+        cg3::Segment2d orderedSegment = segments[i];
+        if (segments[i].p2() < segments[i].p1()) {
+            orderedSegment.setP1(segments[i].p2());
+            orderedSegment.setP2(segments[i].p1());
+        }
+        orderedSegments[i] = orderedSegment;
 
-                if (!foundPoint2) {
-                    bool insertedPoint2;
-                    id2 = addPoint(orderedSegment.p2(), insertedPoint2);
-                    assert(insertedPoint2);
-                }
-                assert(id1 != id2 && id1 < points.size() && id2 < points.size());
+        bool degenerate = orderedSegment.p1() == orderedSegment.p2();
+        bool vertical = orderedSegment.p1().x() == orderedSegment.p2().x();
+
+        candidates[i] = !degenerate && !vertical && !intersectionChecker.checkIntersections(orderedSegment);
+    }
+
+    //Intersections among the segments of the batch: for each segment, the previous intersecting ones
+    BoundingBoxIndex batchIndex;
+    for (long long i = 0; i < n; i++) {
+        if (candidates[i]) {
+            batchIndex.insert(static_cast<size_t>(i), cg3::BoundingBox2(orderedSegments[i].p1().min(orderedSegments[i].p2()),
+                                                                        orderedSegments[i].p1().max(orderedSegments[i].p2())));
+        }
+    }
 
-                IndexedSegment2d indexedSegment(id1, id2);
-                if (indexedSegment.second < indexedSegment.first) {
-                    std::swap(indexedSegment.first, indexedSegment.second);
-                }
+    std::vector<std::vector<size_t>> intersectingSegments(segments.size());
 
-                indexedSegments.push_back(indexedSegment);
+    #pragma omp parallel for schedule(dynamic, 256)
+    for (long long i = 0; i < n; i++) {
+        if (!candidates[i])
+            continue;
 
-                segmentMap.insert(std::make_pair(indexedSegment, id));
+        std::vector<size_t> overlapping;
+        batchIndex.query(cg3::BoundingBox2(orderedSegments[i].p1().min(orderedSegments[i].p2()),
+                                           orderedSegments[i].p1().max(orderedSegments[i].p2())), overlapping);
 
-                intersectionChecker.insert(orderedSegment);
+        for (size_t j : overlapping) {
+            if (j < static_cast<size_t>(i) && SegmentIntersectionChecker::checkSegmentIntersection(orderedSegments[i], orderedSegments[j])) {
+                intersectingSegments[i].push_back(j);
             }
         }
     }
 
-    return id;
+    //Validation and insertion in order: the first segment always wins
+    std::vector<size_t> ids(segments.size(), std::numeric_limits<size_t>::max());
+    segmentsInserted.assign(segments.size(), false);
+
+    reserve(indexedSegments.size() + segments.size());
+
+    for (long long i = 0; i < n; i++) {
+        if (!candidates[i])
+            continue;
+
+        bool foundPoint1, generalPosition1;
+        size_t id1 = findPointByX(orderedSegments[i].p1(), foundPoint1, generalPosition1);
+        bool foundPoint2, generalPosition2;
+        size_t id2 = findPointByX(orderedSegments[i].p2(), foundPoint2, generalPosition2);
+
+        bool found = false;
+        if (foundPoint1 && foundPoint2) {
+            findIndexedSegment(IndexedSegment2d(id1, id2), found);
+        }
+
+        bool intersecting = false;
+        for (size_t j : intersectingSegments[i]) {
+            intersecting |= segmentsInserted[j];
+        }
+
+        if (generalPosition1 && generalPosition2 && !found && !intersecting) {
+            segmentsInserted[i] = true;
+
+            ids[i] = insertSegment(orderedSegments[i], id1, id2);
+        }
+    }
+
+    return ids;
 }
 
 size_t TrapezoidalMapDataset::addIndexedSegment(const IndexedSegment2d& indexedSegment, bool& segmentInserted)
@@ -141,9 +192,11 @@ size_t TrapezoidalMapDataset::addIndexedSegment(const IndexedSegment2d& indexedS
 
             indexedSegments.push_back(orderedIndexedSegment);
 
-            segmentMap.insert(std::make_pair(orderedIndexedSegment, id));
+            segmentMap.insert(orderedIndexedSegment, id);
 
             intersectionChecker.insert(cg3::Segment2d(points[orderedIndexedSegment.first], points[orderedIndexedSegment.second]));
+
+            version++;
         }
     }
 
@@ -152,18 +205,8 @@ size_t TrapezoidalMapDataset::addIndexedSegment(const IndexedSegment2d& indexedS
 
 size_t TrapezoidalMapDataset::findPoint(const cg3::Point2d &point, bool &found)
 {
-    std::unordered_map<cg3::Point2d, size_t>::iterator it = pointMap.find(point);
-
-    //Point already in the data structure
-    if (it != pointMap.end()) {
-        found = true;
-        return it->second;
-    }
-    //Point not in the data structure
-    else {
-        found = false;
-        return std::numeric_limits<size_t>::max();
-    }
+    bool generalPosition;
+    return findPointByX(point, found, generalPosition);
 }
 
 size_t TrapezoidalMapDataset::findSegment(const cg3::Segment2d& segment, bool& found)
@@ -197,12 +240,12 @@ size_t TrapezoidalMapDataset::findIndexedSegment(const IndexedSegment2d& indexed
         orderedIndexedSegment.second = indexedSegment.first;
     }
 
-    std::unordered_map<IndexedSegment2d, size_t>::iterator it = segmentMap.find(orderedIndexedSegment);
+    const size_t* id = segmentMap.find(orderedIndexedSegment);
 
     //Segment already in the data structure
-    if (it != segmentMap.end()) {
+    if (id != nullptr) {
         found = true;
-        return it->second;
+        return *id;
     }
     //Segment not in the data structure
     else {
@@ -211,6 +254,14 @@ size_t TrapezoidalMapDataset::findIndexedSegment(const IndexedSegment2d& indexed
     }
 }
 
+void TrapezoidalMapDataset::reserve(size_t segmentNumber)
+{
+    points.reserve(2 * segmentNumber);
+    indexedSegments.reserve(segmentNumber);
+    xCoordMap.reserve(2 * segmentNumber);
+    segmentMap.reserve(segmentNumber);
+}
+
 size_t TrapezoidalMapDataset::pointNumber()
 {
     return points.size();
@@ -226,22 +277,21 @@ const std::vector<cg3::Point2d>& TrapezoidalMapDataset::getPoints() const
     return points;
 }
 
-cg3::Point2d& TrapezoidalMapDataset::getPoint(size_t id)
-{
-    return points[id];
-}
-
 const cg3::Point2d& TrapezoidalMapDataset::getPoint(size_t id) const
 {
     return points[id];
 }
 
-std::vector<cg3::Segment2d> TrapezoidalMapDataset::getSegments() const
+const std::vector<cg3::Segment2d>& TrapezoidalMapDataset::getSegments() const
 {
-    std::vector<cg3::Segment2d> segments;
-    for (size_t i = 0; i < indexedSegments.size(); i++) {
+    //Only the segments changed or added after the last call are materialized
+    segments.resize(std::min(validSegments, indexedSegments.size()));
+    segments.reserve(indexedSegments.size());
+    for (size_t i = segments.size(); i < indexedSegments.size(); i++) {
         segments.push_back(getSegment(i));
     }
+    validSegments = segments.size();
+
     return segments;
 }
 
@@ -260,24 +310,94 @@ const TrapezoidalMapDataset::IndexedSegment2d &TrapezoidalMapDataset::getIndexed
     return indexedSegments[id];
 }
 
-TrapezoidalMapDataset::IndexedSegment2d &TrapezoidalMapDataset::getIndexedSegments(size_t id)
+const cg3::BoundingBox2& TrapezoidalMapDataset::getBoundingBox() const
 {
-    return indexedSegments[id];
+    return boundingBox;
 }
 
-const cg3::BoundingBox2& TrapezoidalMapDataset::getBoundingBox() const
+size_t TrapezoidalMapDataset::getVersion() const
 {
-    return boundingBox;
+    return version;
+}
+
+size_t TrapezoidalMapDataset::getEditVersion() const
+{
+    return editVersion;
 }
 
 void TrapezoidalMapDataset::clear()
 {
     points.clear();
     indexedSegments.clear();
-    pointMap.clear();
+    xCoordMap.clear();
     segmentMap.clear();
-    xCoordSet.clear();
     boundingBox.setMin(cg3::Point2d(0,0));
     boundingBox.setMax(cg3::Point2d(0,0));
     intersectionChecker.clear();
+    segments.clear();
+    validSegments = 0;
+    version++;
+    editVersion++;
+}
+
+size_t TrapezoidalMapDataset::findPointByX(const cg3::Point2d& point, bool& found, bool& generalPosition) const
+{
+    const size_t* id = xCoordMap.find(point.x());
+
+    //Points are in general position: only one point can have this x-coordinate
+    found = id != nullptr && points[*id] == point;
+    generalPosition = id == nullptr || found;
+
+    return found ? *id : std::numeric_limits<size_t>::max();
+}
+
+size_t TrapezoidalMapDataset::insertPoint(const cg3::Point2d& point)
+{
+    size_t id = points.size();
+
+    //Add point
+    points.push_back(point);
+
+    xCoordMap.insert(point.x(), id);
+
+    version++;
+
+    //Update bounding box
+    boundingBox.setMax(cg3::Point2d(
+            std::max(point.x(), boundingBox.max().x()),
+            std::max(point.y(), boundingBox.max().y())));
+    boundingBox.setMin(cg3::Point2d(
+            std::min(point.x(), boundingBox.min().x()),
+            std::min(point.y(), boundingBox.min().y())));
+
+    return id;
+}
+
+size_t TrapezoidalMapDataset::insertSegment(const cg3::Segment2d& orderedSegment, size_t id1, size_t id2)
+{
+    size_t id = indexedSegments.size();
+
+    //Points not in the dataset yet
+    if (id1 == std::numeric_limits<size_t>::max()) {
+        id1 = insertPoint(orderedSegment.p1());
+    }
+    if (id2 == std::numeric_limits<size_t>::max()) {
+        id2 = insertPoint(orderedSegment.p2());
+    }
+    assert(id1 != id2 && id1 < points.size() && id2 < points.size());
+
+    IndexedSegment2d indexedSegment(id1, id2);
+    if (indexedSegment.second < indexedSegment.first) {
+        std::swap(indexedSegment.first, indexedSegment.second);
+    }
+
+    indexedSegments.push_back(indexedSegment);
+
+    segmentMap.insert(indexedSegment, id);
+
+    intersectionChecker.insert(orderedSegment);
+
+    version++;
+
+    return id;
 }
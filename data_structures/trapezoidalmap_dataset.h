@@ -1,7 +1,6 @@
 #ifndef TRAPEZOIDALMAP_DATASET_H
 #define TRAPEZOIDALMAP_DATASET_H
 
-#include <unordered_map>
 #include <vector>
 #include <utility>
 
@@ -10,6 +9,8 @@
 #include <cg3/geometry/bounding_box2.h>
 
 #include "data_structures/segment_intersection_checker.h"
+#include "data_structures/flat_hash_map.h"
+#include "data_structures/bounding_box_index.h"
 
 /**
  * @brief This class allows to store segments, with indexed non-duplicates point.
@@ -27,27 +28,31 @@ public:
     size_t addPoint(const cg3::Point2d& point, bool& pointInserted);
     size_t addSegment(const cg3::Segment2d& segment, bool& segmentInserted);
     size_t addIndexedSegment(const IndexedSegment2d& segment, bool& segmentInserted);
+    std::vector<size_t> addSegments(const std::vector<cg3::Segment2d>& segments, std::vector<bool>& segmentsInserted);
 
     size_t findPoint(const cg3::Point2d& point, bool& found);
     size_t findSegment(const cg3::Segment2d& segment, bool& found);
     size_t findIndexedSegment(const IndexedSegment2d& indexedSegment, bool& found);
 
+    void reserve(size_t segmentNumber);
+
     size_t pointNumber();
     size_t segmentNumber();
 
     const std::vector<cg3::Point2d>& getPoints() const;
-    cg3::Point2d& getPoint(size_t id);
     const cg3::Point2d& getPoint(size_t id) const;
 
-    std::vector<cg3::Segment2d> getSegments() const;
+    const std::vector<cg3::Segment2d>& getSegments() const;
     cg3::Segment2d getSegment(size_t id) const;
 
     const std::vector<IndexedSegment2d>& getIndexedSegments() const;
     const IndexedSegment2d& getIndexedSegment(size_t id) const;
-    IndexedSegment2d& getIndexedSegments(size_t id);
 
     const cg3::BoundingBox2& getBoundingBox() const;
 
+    size_t getVersion() const;
+    size_t getEditVersion() const;
+
     void clear();
 
 private:
@@ -55,14 +60,29 @@ private:
     std::vector<cg3::Point2d> points;
     std::vector<IndexedSegment2d> indexedSegments;
 
-    std::unordered_map<cg3::Point2d, size_t> pointMap;
-    std::unordered_map<IndexedSegment2d, size_t> segmentMap;
-    std::unordered_set<double> xCoordSet;
+    //Points are in general position, so a point is identified by its x-coordinate
+    FlatHashMap<double, size_t, DoubleHash> xCoordMap;
+    FlatHashMap<IndexedSegment2d, size_t, IndexPairHash> segmentMap;
 
     cg3::BoundingBox2 boundingBox;
 
     SegmentIntersectionChecker intersectionChecker;
 
+    //Incremented at every change of the dataset
+    size_t version;
+    //Incremented only when points or segments already in the dataset are changed or removed
+    size_t editVersion;
+
+    //Segments materialized from indexedSegments and points. Only the first
+    //validSegments are up to date: the dataset usually grows by appending,
+    //so the missing ones are added on the next getSegments() call.
+    mutable std::vector<cg3::Segment2d> segments;
+    mutable size_t validSegments;
+
+    size_t findPointByX(const cg3::Point2d& point, bool& found, bool& generalPosition) const;
+    size_t insertSegment(const cg3::Segment2d& orderedSegment, size_t id1, size_t id2);
+    size_t insertPoint(const cg3::Point2d& point);
+
 };
 
 
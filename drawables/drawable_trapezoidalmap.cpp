@@ -2,6 +2,15 @@
 
 #include <cg3/viewer/opengl_objects/opengl_objects2.h>
 
+#include "utils/viewportutils.h"
+
+// number of buffer entries owned by every trapezoid
+static const size_t COORDINATES_PER_VERTEX = 2;
+static const size_t COLOR_COMPONENTS_PER_VERTEX = 3;
+static const size_t TRIANGLE_INDICES_PER_TRAPEZOID = 6;
+static const size_t OUTLINE_INDICES_PER_TRAPEZOID = 2 * Trapezoid::NUM_OF_VERTICES;
+static const size_t EXTENSION_INDICES_PER_TRAPEZOID = 4;
+
 /**
  * @brief DrawableTrapezoidalMap::DrawableTrapezoidalMap drawable trapezoidal map constructor passes the bbox to the trapezoidal map superclass constructor
  * @param bbox bounding box
@@ -12,73 +21,61 @@ DrawableTrapezoidalMap::DrawableTrapezoidalMap(const cg3::BoundingBox2 bbox) :
     segmentColor(200, 5, 5),
     segmentSize(3),
     trapezoidSize(1),
-    selectedTrapezoid(std::numeric_limits<size_t>::max())
+    selectedTrapezoid(std::numeric_limits<size_t>::max()),
+    visibleBuffersUpdated(false)
 {
     srand(time(nullptr));
     initializeTrapezoidColors();
+    rebuildBuffers();
 }
 
 /**
- * @brief DrawableTrapezoidalMap::draw draws all the trapezoids and the vertical lines
+ * @brief DrawableTrapezoidalMap::draw draws the visible trapezoids and vertical lines using the cached buffers
  */
 void DrawableTrapezoidalMap::draw() const
 {
-    size_t merged = getMergedTrapezoid();
+    double pixelSize;
+    cg3::BoundingBox2 currentVisibleBox = ViewportUtils::getVisibleBoundingBox(pixelSize);
 
-    uint i = 0;
-    for (const Trapezoid& t : getTrapezoids())
-    {
-        // ignore the merged trapezoid
-        if (i != merged)
-        {
-            std::array<cg3::Point2d, Trapezoid::NUM_OF_VERTICES> vertices = t.getVertices();
-            cg3::Color trapezoidColor;
-
-            // if this is the selected trapezoid we use the specific color
-            if (i == selectedTrapezoid)
-                trapezoidColor = selectedColor;
-            // otherwise we use the color associated to the trapezoid
-            else
-                trapezoidColor = trapezoidColors[i];
-
-            // degenerate case - left side is a point, trapezoid becomes triangle
-            if (vertices[0] == vertices[3])
-            {
-                // we draw the right vertical extension unless it coincides with the bbox boundary
-                if (vertices[1].x() != getBBox().max().x())
-                    cg3::opengl::drawLine2(vertices[1], vertices[2], segmentColor, static_cast<int>(segmentSize));
+    if (!visibleBuffersUpdated || currentVisibleBox.min() != visibleBox.min() || currentVisibleBox.max() != visibleBox.max())
+        updateVisibleBuffers(currentVisibleBox, pixelSize);
 
-                // we draw the triangle
-                cg3::opengl::drawTriangle2(vertices[0], vertices[1], vertices[2], trapezoidColor, static_cast<int>(trapezoidSize), true);
-            }
-            // degenerate case - right side is a point, trapezoid becomes triangle
-            else if (vertices[1] == vertices[2])
-            {
-                // we draw the left vertical extension unless it coincides with the bbox boundary
-                if (vertices[0].x() != getBBox().min().x())
-                    cg3::opengl::drawLine2(vertices[0], vertices[3], segmentColor, static_cast<int>(segmentSize));
+    if (visibleTrapezoids.empty())
+        return;
 
-                // we draw the triangle
-                cg3::opengl::drawTriangle2(vertices[0], vertices[1], vertices[3], trapezoidColor, static_cast<int>(trapezoidSize), true);
-            }
-            // default case - both sides are vertical lines
-            else
-            {
-                // we draw the left vertical extension unless it coincides with the bbox boundary
-                if (vertices[0].x() != getBBox().min().x())
-                    cg3::opengl::drawLine2(vertices[0], vertices[3], segmentColor, static_cast<int>(segmentSize));
+    glEnableClientState(GL_VERTEX_ARRAY);
+    glEnableClientState(GL_COLOR_ARRAY);
+    glVertexPointer(static_cast<GLint>(COORDINATES_PER_VERTEX), GL_DOUBLE, 0, vertexBuffer.data());
+    glColorPointer(static_cast<GLint>(COLOR_COMPONENTS_PER_VERTEX), GL_FLOAT, 0, colorBuffer.data());
 
-                // we draw the right vertical extension unless it coincides with the bbox boundary
-                if (vertices[1].x() != getBBox().max().x())
-                    cg3::opengl::drawLine2(vertices[1], vertices[2], segmentColor, static_cast<int>(segmentSize));
+    // we draw the trapezoids
+    glDrawElements(GL_TRIANGLES, static_cast<GLsizei>(visibleTriangleIndexBuffer.size()), GL_UNSIGNED_INT, visibleTriangleIndexBuffer.data());
 
-                // we draw the trapezoid
-                cg3::opengl::drawQuad2(vertices, trapezoidColor, static_cast<int>(trapezoidSize), true);
-            }
-        }
+    // we draw the trapezoids smaller than a pixel
+    if (!visiblePointIndexBuffer.empty())
+    {
+        glPointSize(1);
+        glDrawElements(GL_POINTS, static_cast<GLsizei>(visiblePointIndexBuffer.size()), GL_UNSIGNED_INT, visiblePointIndexBuffer.data());
+    }
+
+    // we draw the trapezoid borders with the same color of the trapezoids
+    if (trapezoidSize > 0)
+    {
+        glLineWidth(trapezoidSize);
+        glDrawElements(GL_LINES, static_cast<GLsizei>(visibleOutlineIndexBuffer.size()), GL_UNSIGNED_INT, visibleOutlineIndexBuffer.data());
+    }
+
+    glDisableClientState(GL_COLOR_ARRAY);
 
-        i++;
+    // we draw the vertical extensions, all of them share the segment color
+    if (segmentSize > 0)
+    {
+        glLineWidth(segmentSize);
+        glColor3f(segmentColor.redF(), segmentColor.greenF(), segmentColor.blueF());
+        glDrawElements(GL_LINES, static_cast<GLsizei>(visibleExtensionIndexBuffer.size()), GL_UNSIGNED_INT, visibleExtensionIndexBuffer.data());
     }
+
+    glDisableClientState(GL_VERTEX_ARRAY);
 }
 
 /**
@@ -172,6 +169,7 @@ size_t DrawableTrapezoidalMap::getSelectedTrapezoid() const
 void DrawableTrapezoidalMap::setSelectedColor(const cg3::Color& selectedColor)
 {
     this->selectedColor = selectedColor;
+    updateTrapezoidColorBuffer(selectedTrapezoid);
 }
 
 /**
@@ -195,6 +193,8 @@ void DrawableTrapezoidalMap::setTrapezoidColor(const cg3::Color& trapezoidColor,
         trapezoidColors.push_back(trapezoidColor);
     else
         trapezoidColors[index] = trapezoidColor;
+
+    updateTrapezoidColorBuffer(index);
 }
 
 /**
@@ -221,7 +221,11 @@ void DrawableTrapezoidalMap::setTrapezoidSize(unsigned int trapezoidSize)
  */
 void DrawableTrapezoidalMap::setSelectedTrapezoid(const size_t index)
 {
+    size_t previousSelectedTrapezoid = selectedTrapezoid;
     selectedTrapezoid = index;
+
+    updateTrapezoidColorBuffer(previousSelectedTrapezoid);
+    updateTrapezoidColorBuffer(selectedTrapezoid);
 }
 
 /**
@@ -243,3 +247,184 @@ void DrawableTrapezoidalMap::initializeTrapezoidColors()
     trapezoidColors[0] = randomColor();
 }
 
+/**
+ * @brief DrawableTrapezoidalMap::updateTrapezoidBuffers updates the render buffers after a change of the map
+ * trapezoids added at the back of the map are always updated, the already existing ones only if they are listed
+ * @param trapezoidIndexes indexes in the map of the trapezoids which have been modified
+ */
+void DrawableTrapezoidalMap::updateTrapezoidBuffers(const std::vector<size_t>& trapezoidIndexes)
+{
+    size_t bufferedTrapezoids = triangleIndexBuffer.size() / TRIANGLE_INDICES_PER_TRAPEZOID;
+    size_t trapezoids = numberOfTrapezoids();
+
+    vertexBuffer.resize(trapezoids * Trapezoid::NUM_OF_VERTICES * COORDINATES_PER_VERTEX);
+    colorBuffer.resize(trapezoids * Trapezoid::NUM_OF_VERTICES * COLOR_COMPONENTS_PER_VERTEX);
+    triangleIndexBuffer.resize(trapezoids * TRIANGLE_INDICES_PER_TRAPEZOID);
+    outlineIndexBuffer.resize(trapezoids * OUTLINE_INDICES_PER_TRAPEZOID);
+    extensionIndexBuffer.resize(trapezoids * EXTENSION_INDICES_PER_TRAPEZOID);
+
+    for (size_t i = bufferedTrapezoids; i < trapezoids; i++)
+        updateTrapezoidBuffer(i);
+
+    for (size_t index : trapezoidIndexes)
+        if (index < bufferedTrapezoids && index < trapezoids)
+            updateTrapezoidBuffer(index);
+}
+
+/**
+ * @brief DrawableTrapezoidalMap::rebuildBuffers rebuilds the render buffers of the whole map
+ */
+void DrawableTrapezoidalMap::rebuildBuffers()
+{
+    vertexBuffer.clear();
+    colorBuffer.clear();
+    triangleIndexBuffer.clear();
+    outlineIndexBuffer.clear();
+    extensionIndexBuffer.clear();
+    trapezoidIndex.clear();
+
+    updateTrapezoidBuffers(std::vector<size_t>());
+}
+
+/**
+ * @brief DrawableTrapezoidalMap::updateTrapezoidBuffer writes the vertices, colors and indexes of a trapezoid in the render buffers
+ * @param index index of the trapezoid in the map
+ */
+void DrawableTrapezoidalMap::updateTrapezoidBuffer(const size_t index)
+{
+    const std::array<cg3::Point2d, Trapezoid::NUM_OF_VERTICES> vertices = getTrapezoidAtIndex(index).getVertices();
+    const unsigned int firstVertex = static_cast<unsigned int>(index * Trapezoid::NUM_OF_VERTICES);
+
+    for (size_t i = 0; i < Trapezoid::NUM_OF_VERTICES; i++)
+    {
+        vertexBuffer[(firstVertex + i) * COORDINATES_PER_VERTEX] = vertices[i].x();
+        vertexBuffer[(firstVertex + i) * COORDINATES_PER_VERTEX + 1] = vertices[i].y();
+    }
+
+    updateTrapezoidColorBuffer(index);
+
+    unsigned int* triangleIndexes = &triangleIndexBuffer[index * TRIANGLE_INDICES_PER_TRAPEZOID];
+    unsigned int* outlineIndexes = &outlineIndexBuffer[index * OUTLINE_INDICES_PER_TRAPEZOID];
+    unsigned int* extensionIndexes = &extensionIndexBuffer[index * EXTENSION_INDICES_PER_TRAPEZOID];
+
+    // every primitive is collapsed on the first vertex of the trapezoid unless it has to be drawn
+    std::fill(triangleIndexes, triangleIndexes + TRIANGLE_INDICES_PER_TRAPEZOID, firstVertex);
+    std::fill(outlineIndexes, outlineIndexes + OUTLINE_INDICES_PER_TRAPEZOID, firstVertex);
+    std::fill(extensionIndexes, extensionIndexes + EXTENSION_INDICES_PER_TRAPEZOID, firstVertex);
+
+    visibleBuffersUpdated = false;
+
+    // ignore the merged trapezoid
+    if (index == getMergedTrapezoid())
+    {
+        trapezoidIndex.erase(index);
+        return;
+    }
+
+    trapezoidIndex.update(index, cg3::boundingBox(vertices));
+
+    // two triangles cover the trapezoid, if it degenerates into a triangle one of them has zero area
+    const unsigned int triangles[TRIANGLE_INDICES_PER_TRAPEZOID] = {0, 1, 2, 2, 3, 0};
+    for (size_t i = 0; i < TRIANGLE_INDICES_PER_TRAPEZOID; i++)
+        triangleIndexes[i] = firstVertex + triangles[i];
+
+    for (size_t i = 0; i < Trapezoid::NUM_OF_VERTICES; i++)
+    {
+        outlineIndexes[2 * i] = firstVertex + static_cast<unsigned int>(i);
+        outlineIndexes[2 * i + 1] = firstVertex + static_cast<unsigned int>((i + 1) % Trapezoid::NUM_OF_VERTICES);
+    }
+
+    // we draw the left vertical extension unless the left side is a point or it coincides with the bbox boundary
+    if (vertices[0] != vertices[3] && vertices[0].x() != getBBox().min().x())
+    {
+        extensionIndexes[0] = firstVertex;
+        extensionIndexes[1] = firstVertex + 3;
+    }
+
+    // we draw the right vertical extension unless the right side is a point or it coincides with the bbox boundary
+    if (vertices[1] != vertices[2] && vertices[1].x() != getBBox().max().x())
+    {
+        extensionIndexes[2] = firstVertex + 1;
+        extensionIndexes[3] = firstVertex + 2;
+    }
+}
+
+/**
+ * @brief DrawableTrapezoidalMap::updateTrapezoidColorBuffer writes the color of a trapezoid in the render buffers
+ * @param index index of the trapezoid in the map, ignored if the trapezoid is not in the buffers yet
+ */
+void DrawableTrapezoidalMap::updateTrapezoidColorBuffer(const size_t index)
+{
+    if (index >= triangleIndexBuffer.size() / TRIANGLE_INDICES_PER_TRAPEZOID || index >= trapezoidColors.size())
+        return;
+
+    // if this is the selected trapezoid we use the specific color, otherwise the color associated to the trapezoid
+    const cg3::Color& trapezoidColor = index == selectedTrapezoid ? selectedColor : trapezoidColors[index];
+
+    for (size_t i = 0; i < Trapezoid::NUM_OF_VERTICES; i++)
+    {
+        float* color = &colorBuffer[(index * Trapezoid::NUM_OF_VERTICES + i) * COLOR_COMPONENTS_PER_VERTEX];
+        color[0] = trapezoidColor.redF();
+        color[1] = trapezoidColor.greenF();
+        color[2] = trapezoidColor.blueF();
+    }
+}
+
+/**
+ * @brief DrawableTrapezoidalMap::updateVisibleBuffers collects the indexes of the trapezoids overlapping the visible region
+ * @param visibleBox the visible region
+ * @param pixelSize the size of a pixel, trapezoids smaller than it are drawn as points
+ */
+void DrawableTrapezoidalMap::updateVisibleBuffers(const cg3::BoundingBox2& visibleBox, double pixelSize) const
+{
+    visibleTrapezoids.clear();
+    visibleTriangleIndexBuffer.clear();
+    visibleOutlineIndexBuffer.clear();
+    visibleExtensionIndexBuffer.clear();
+    visiblePointIndexBuffer.clear();
+
+    trapezoidIndex.query(visibleBox, visibleTrapezoids);
+
+    // we keep the map order, so that overlapping borders are drawn as without culling
+    std::sort(visibleTrapezoids.begin(), visibleTrapezoids.end());
+
+    for (size_t index : visibleTrapezoids)
+    {
+        const unsigned int firstVertex = static_cast<unsigned int>(index * Trapezoid::NUM_OF_VERTICES);
+
+        cg3::BoundingBox2 box;
+        for (size_t i = 0; i < Trapezoid::NUM_OF_VERTICES; i++)
+        {
+            cg3::Point2d vertex(vertexBuffer[(firstVertex + i) * COORDINATES_PER_VERTEX], vertexBuffer[(firstVertex + i) * COORDINATES_PER_VERTEX + 1]);
+            box.setMin(box.min().min(vertex));
+            box.setMax(box.max().max(vertex));
+        }
+
+        if (ViewportUtils::isSubPixel(box, pixelSize))
+        {
+            visiblePointIndexBuffer.push_back(firstVertex);
+        }
+        else
+        {
+            visibleTriangleIndexBuffer.insert(visibleTriangleIndexBuffer.end(),
+                    triangleIndexBuffer.begin() + index * TRIANGLE_INDICES_PER_TRAPEZOID,
+                    triangleIndexBuffer.begin() + (index + 1) * TRIANGLE_INDICES_PER_TRAPEZOID);
+            visibleOutlineIndexBuffer.insert(visibleOutlineIndexBuffer.end(),
+                    outlineIndexBuffer.begin() + index * OUTLINE_INDICES_PER_TRAPEZOID,
+                    outlineIndexBuffer.begin() + (index + 1) * OUTLINE_INDICES_PER_TRAPEZOID);
+
+            // hidden vertical extensions are collapsed on a single vertex
+            for (size_t i = index * EXTENSION_INDICES_PER_TRAPEZOID; i < (index + 1) * EXTENSION_INDICES_PER_TRAPEZOID; i += 2)
+            {
+                if (extensionIndexBuffer[i] != extensionIndexBuffer[i + 1])
+                {
+                    visibleExtensionIndexBuffer.push_back(extensionIndexBuffer[i]);
+                    visibleExtensionIndexBuffer.push_back(extensionIndexBuffer[i + 1]);
+                }
+            }
+        }
+    }
+
+    this->visibleBox = visibleBox;
+    visibleBuffersUpdated = true;
+}
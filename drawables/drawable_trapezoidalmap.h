@@ -2,6 +2,7 @@
 #define DRAWABLETRAPEZOIDALMAP_H
 
 #include "data_structures/trapezoidalmap.h"
+#include "data_structures/bounding_box_index.h"
 
 #include <cg3/viewer/interfaces/drawable_object.h>
 
@@ -43,6 +44,10 @@ public:
     cg3::Color randomColor() const;
     void initializeTrapezoidColors();
 
+    // render buffers
+    void updateTrapezoidBuffers(const std::vector<size_t>& trapezoidIndexes);
+    void rebuildBuffers();
+
 
 private:
 
@@ -54,6 +59,37 @@ private:
     unsigned int trapezoidSize;
 
     size_t selectedTrapezoid;
+
+    /*
+     * client-side arrays drawn with glDrawElements
+     * every trapezoid owns a fixed-size block in each buffer (4 vertices, 6 triangle indices, 8 outline indices
+     * and 4 vertical extension indices) so that it can be updated in place when the map changes
+     * hidden elements (e.g. the merged trapezoid) are collapsed to degenerate primitives
+     */
+    std::vector<double> vertexBuffer;
+    std::vector<float> colorBuffer;
+    std::vector<unsigned int> triangleIndexBuffer;
+    std::vector<unsigned int> outlineIndexBuffer;
+    std::vector<unsigned int> extensionIndexBuffer;
+
+    /*
+     * viewport culling: only the trapezoids overlapping the visible region are drawn
+     * trapezoids smaller than a pixel are drawn as a single point
+     * the visible index buffers are recomputed only when the visible region or the map change
+     */
+    BoundingBoxIndex trapezoidIndex;
+
+    mutable std::vector<size_t> visibleTrapezoids;
+    mutable std::vector<unsigned int> visibleTriangleIndexBuffer;
+    mutable std::vector<unsigned int> visibleOutlineIndexBuffer;
+    mutable std::vector<unsigned int> visibleExtensionIndexBuffer;
+    mutable std::vector<unsigned int> visiblePointIndexBuffer;
+    mutable cg3::BoundingBox2 visibleBox;
+    mutable bool visibleBuffersUpdated;
+
+    void updateTrapezoidBuffer(const size_t index);
+    void updateTrapezoidColorBuffer(const size_t index);
+    void updateVisibleBuffers(const cg3::BoundingBox2& visibleBox, double pixelSize) const;
 };
 
 #endif // DRAWABLETRAPEZOIDALMAP_H
@@ -2,21 +2,43 @@
 
 #include <cg3/viewer/opengl_objects/opengl_objects2.h>
 
+#include "utils/viewportutils.h"
+
 DrawableTrapezoidalMapDataset::DrawableTrapezoidalMapDataset() :
     pointColor(80, 180, 80),
     segmentColor(80, 80, 180),
     pointSize(5),
-    segmentSize(3)
+    segmentSize(3),
+    indexedPoints(0),
+    indexedSegments(0),
+    indexedVersion(getVersion()),
+    indexedEditVersion(getEditVersion())
 {
 
 }
 
 void DrawableTrapezoidalMapDataset::draw() const
 {
-    for (const cg3::Point2d& p : getPoints()) {
-        cg3::opengl::drawPoint2(p, pointColor, static_cast<int>(pointSize));
+    updateIndexes();
+
+    double pixelSize;
+    cg3::BoundingBox2 visibleBox = ViewportUtils::getVisibleBoundingBox(pixelSize);
+
+    visiblePoints.clear();
+    pointIndex.query(visibleBox, visiblePoints);
+    for (size_t id : visiblePoints) {
+        cg3::opengl::drawPoint2(getPoint(id), pointColor, static_cast<int>(pointSize));
     }
-    for (const cg3::Segment2d& seg : getSegments()) {
+
+    visibleSegments.clear();
+    segmentIndex.query(visibleBox, visibleSegments);
+    for (size_t id : visibleSegments) {
+        cg3::Segment2d seg = getSegment(id);
+
+        //Segments smaller than a pixel are already covered by their endpoints
+        if (ViewportUtils::isSubPixel(cg3::BoundingBox2(seg.p1().min(seg.p2()), seg.p1().max(seg.p2())), pixelSize))
+            continue;
+
         cg3::opengl::drawLine2(seg.p1(), seg.p2(), segmentColor, static_cast<int>(segmentSize));
     }
 }
@@ -72,3 +94,45 @@ void DrawableTrapezoidalMapDataset::setPointColor(const cg3::Color &value)
 {
     pointColor = value;
 }
+
+void DrawableTrapezoidalMapDataset::clear()
+{
+    TrapezoidalMapDataset::clear();
+
+    pointIndex.clear();
+    segmentIndex.clear();
+    indexedPoints = 0;
+    indexedSegments = 0;
+    indexedVersion = getVersion();
+    indexedEditVersion = getEditVersion();
+}
+
+void DrawableTrapezoidalMapDataset::updateIndexes() const
+{
+    if (indexedVersion == getVersion())
+        return;
+
+    //Elements already indexed could have been changed: the indexes are rebuilt
+    if (indexedEditVersion != getEditVersion()) {
+        pointIndex.clear();
+        segmentIndex.clear();
+        indexedPoints = 0;
+        indexedSegments = 0;
+    }
+
+    const std::vector<cg3::Point2d>& points = getPoints();
+    for (; indexedPoints < points.size(); indexedPoints++) {
+        const cg3::Point2d& p = points[indexedPoints];
+        pointIndex.insert(indexedPoints, cg3::BoundingBox2(p, p));
+    }
+
+    const std::vector<IndexedSegment2d>& segments = getIndexedSegments();
+    for (; indexedSegments < segments.size(); indexedSegments++) {
+        const cg3::Point2d& p1 = points[segments[indexedSegments].first];
+        const cg3::Point2d& p2 = points[segments[indexedSegments].second];
+        segmentIndex.insert(indexedSegments, cg3::BoundingBox2(p1.min(p2), p1.max(p2)));
+    }
+
+    indexedVersion = getVersion();
+    indexedEditVersion = getEditVersion();
+}
@@ -2,6 +2,7 @@
 #define DRAWABLE_TRAPEZOIDALMAP_DATASET_H
 
 #include "data_structures/trapezoidalmap_dataset.h"
+#include "data_structures/bounding_box_index.h"
 
 #include <cg3/viewer/interfaces/drawable_object.h>
 
@@ -33,6 +34,8 @@ public:
     unsigned int getSegmentSize() const;
     void setSegmentSize(unsigned int value);
 
+    void clear();
+
 private:
 
     cg3::Color pointColor;
@@ -41,6 +44,21 @@ private:
     unsigned int pointSize;
     unsigned int segmentSize;
 
+    //Spatial indexes used to draw only the visible points and segments.
+    //They are lazily extended with the elements added after the last draw,
+    //and rebuilt when an element already indexed has been changed.
+    mutable BoundingBoxIndex pointIndex;
+    mutable BoundingBoxIndex segmentIndex;
+    mutable size_t indexedPoints;
+    mutable size_t indexedSegments;
+    mutable size_t indexedVersion;
+    mutable size_t indexedEditVersion;
+
+    mutable std::vector<size_t> visiblePoints;
+    mutable std::vector<size_t> visibleSegments;
+
+    void updateIndexes() const;
+
 };
 
 #endif // DRAWABLE_TRAPEZOIDALMAP_DATASET_H
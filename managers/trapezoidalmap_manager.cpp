@@ -167,8 +167,9 @@ TrapezoidalMapManager::~TrapezoidalMapManager()
  */
 void TrapezoidalMapManager::addSegmentToTrapezoidalMap(const cg3::Segment2d& segment)
 {
-    TrapezoidalMapConstructionAndQuery::incrementalStep(drawableTrapezoidalMap, dag, segment);
+    const std::vector<size_t> modifiedTrapezoids = TrapezoidalMapConstructionAndQuery::incrementalStep(drawableTrapezoidalMap, dag, segment);
     TrapezoidalMapConstructionAndQuery::colorTrapezoids(drawableTrapezoidalMap);
+    drawableTrapezoidalMap.updateTrapezoidBuffers(modifiedTrapezoids);
 }
 
 /**
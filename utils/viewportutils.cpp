@@ -0,0 +1,78 @@
+#include "viewportutils.h"
+
+#ifdef WIN32
+#include "windows.h"
+#endif
+
+#ifdef __APPLE__
+#include <OpenGL/gl.h>
+#include <OpenGL/glu.h>
+#else
+#include <GL/gl.h>
+#include <GL/glu.h>
+#endif
+
+namespace ViewportUtils
+{
+    /**
+     * @brief getVisibleBoundingBox gets the region of the z = 0 plane currently visible in the opengl viewport
+     * it must be called while drawing, since it reads the current opengl matrices
+     * @param pixelSize output parameter, the size in scene units of a pixel of the viewport (0 if the viewport is empty)
+     * @return the bounding box of the visible region, an infinite box if it cannot be computed
+     */
+    cg3::BoundingBox2 getVisibleBoundingBox(double& pixelSize)
+    {
+        const double infinity = std::numeric_limits<double>::max();
+        const cg3::BoundingBox2 infiniteBox(cg3::Point2d(-infinity, -infinity), cg3::Point2d(infinity, infinity));
+
+        GLdouble modelview[16];
+        GLdouble projection[16];
+        GLint viewport[4];
+        glGetDoublev(GL_MODELVIEW_MATRIX, modelview);
+        glGetDoublev(GL_PROJECTION_MATRIX, projection);
+        glGetIntegerv(GL_VIEWPORT, viewport);
+
+        pixelSize = 0;
+        if (viewport[2] <= 0 || viewport[3] <= 0)
+            return infiniteBox;
+
+        cg3::BoundingBox2 visibleBox;
+
+        // the ray through each corner of the viewport is intersected with the z = 0 plane
+        for (int i = 0; i < 4; i++)
+        {
+            GLdouble windowX = viewport[0] + (i % 2) * viewport[2];
+            GLdouble windowY = viewport[1] + (i / 2) * viewport[3];
+
+            GLdouble nearX, nearY, nearZ, farX, farY, farZ;
+            if (gluUnProject(windowX, windowY, 0, modelview, projection, viewport, &nearX, &nearY, &nearZ) != GL_TRUE ||
+                gluUnProject(windowX, windowY, 1, modelview, projection, viewport, &farX, &farY, &farZ) != GL_TRUE)
+                return infiniteBox;
+
+            // the plane is not crossed by the ray (e.g. the camera is looking away from it)
+            if (nearZ == farZ || (nearZ > 0) == (farZ > 0))
+                return infiniteBox;
+
+            double t = nearZ / (nearZ - farZ);
+            cg3::Point2d corner(nearX + t * (farX - nearX), nearY + t * (farY - nearY));
+
+            visibleBox.setMin(visibleBox.min().min(corner));
+            visibleBox.setMax(visibleBox.max().max(corner));
+        }
+
+        pixelSize = std::max(visibleBox.lengthX() / viewport[2], visibleBox.lengthY() / viewport[3]);
+
+        return visibleBox;
+    }
+
+    /**
+     * @brief isSubPixel checks whether a box is smaller than a pixel in both directions
+     * @param box the box
+     * @param pixelSize the size in scene units of a pixel
+     * @return true if the box fits in a pixel
+     */
+    bool isSubPixel(const cg3::BoundingBox2& box, double pixelSize)
+    {
+        return box.lengthX() < pixelSize && box.lengthY() < pixelSize;
+    }
+}
@@ -0,0 +1,12 @@
+#ifndef VIEWPORTUTILS_H
+#define VIEWPORTUTILS_H
+
+#include <cg3/geometry/bounding_box2.h>
+
+namespace ViewportUtils
+{
+    cg3::BoundingBox2 getVisibleBoundingBox(double& pixelSize);
+    bool isSubPixel(const cg3::BoundingBox2& box, double pixelSize);
+}
+
+#endif // VIEWPORTUTILS_H